@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Author: Dokthar
+ */
+#include "com_jme3_bullet_PhysicsProjectiles.h"
+#include "jmePhysicsSpace.h"
+#include "jmeBulletUtil.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsProjectiles
+     * Method:    setHitBuffers
+     * Signature: (JLjava/nio/FloatBuffer;Ljava/nio/IntBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_setHitBuffers
+    (JNIEnv *env, jobject object, jlong spaceId, jobject hitsBuffer, jobject hitIdsBuffer, jint maxHits) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        jfloat* hits = (jfloat*) env->GetDirectBufferAddress(hitsBuffer);
+        jint* hitIds = (jint*) env->GetDirectBufferAddress(hitIdsBuffer);
+        space->getProjectiles()->setHitBuffers(hits, hitIds, maxHits);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsProjectiles
+     * Method:    spawn
+     * Signature: (JLcom/jme3/math/Vector3f;Lcom/jme3/math/Vector3f;FFFI)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_spawn
+    (JNIEnv *env, jobject object, jlong spaceId, jobject position, jobject velocity, jfloat drag, jfloat radius, jfloat lifetime, jint userId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        btVector3 pos = btVector3();
+        jmeBulletUtil::convert(env, position, &pos);
+        btVector3 vel = btVector3();
+        jmeBulletUtil::convert(env, velocity, &vel);
+        space->getProjectiles()->spawn(pos, vel, drag, radius, lifetime, userId);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsProjectiles
+     * Method:    spawnAll
+     * Signature: (JLjava/nio/FloatBuffer;Ljava/nio/IntBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_spawnAll
+    (JNIEnv *env, jobject object, jlong spaceId, jobject paramsBuffer, jobject userIdsBuffer) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        const jfloat* params = (jfloat*) env->GetDirectBufferAddress(paramsBuffer);
+        const jint* userIds = (jint*) env->GetDirectBufferAddress(userIdsBuffer);
+        const int count = env->GetDirectBufferCapacity(userIdsBuffer);
+        jmeProjectiles* projectiles = space->getProjectiles();
+        for (int i = 0; i < count; ++i, params += 9) {
+            projectiles->spawn(btVector3(params[0], params[1], params[2]), btVector3(params[3], params[4], params[5]),
+                    params[6], params[7], params[8], userIds[i]);
+        }
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsProjectiles
+     * Method:    clear
+     * Signature: (J)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_clear
+    (JNIEnv *env, jobject object, jlong spaceId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        space->getProjectiles()->clear();
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsProjectiles
+     * Method:    getCount
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsProjectiles_getCount
+    (JNIEnv *env, jobject object, jlong spaceId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        return space->getProjectiles()->getCount();
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsProjectiles
+     * Method:    getHitCount
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsProjectiles_getHitCount
+    (JNIEnv *env, jobject object, jlong spaceId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        return space->getProjectiles()->getHitCount();
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsProjectiles
+     * Method:    getHitObject
+     * Signature: (JI)Lcom/jme3/bullet/collision/PhysicsCollisionObject;
+     */
+    JNIEXPORT jobject JNICALL Java_com_jme3_bullet_PhysicsProjectiles_getHitObject
+    (JNIEnv *env, jobject object, jlong spaceId, jint hit) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return NULL;
+        }
+        const btCollisionObject* collisionObject = space->getProjectiles()->getHitObject(hit);
+        if (collisionObject == NULL) {
+            return NULL;
+        }
+        jmeUserPointer* up = (jmeUserPointer*) collisionObject->getUserPointer();
+        if (up == NULL) {
+            return NULL;
+        }
+        return env->NewLocalRef(up->javaCollisionObject);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsProjectiles
+     * Method:    clearHits
+     * Signature: (J)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_clearHits
+    (JNIEnv *env, jobject object, jlong spaceId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        space->getProjectiles()->clearHits();
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,77 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_jme3_bullet_PhysicsProjectiles */
+
+#ifndef _Included_com_jme3_bullet_PhysicsProjectiles
+#define _Included_com_jme3_bullet_PhysicsProjectiles
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     com_jme3_bullet_PhysicsProjectiles
+ * Method:    setHitBuffers
+ * Signature: (JLjava/nio/FloatBuffer;Ljava/nio/IntBuffer;I)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_setHitBuffers
+  (JNIEnv *, jobject, jlong, jobject, jobject, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsProjectiles
+ * Method:    spawn
+ * Signature: (JLcom/jme3/math/Vector3f;Lcom/jme3/math/Vector3f;FFFI)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_spawn
+  (JNIEnv *, jobject, jlong, jobject, jobject, jfloat, jfloat, jfloat, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsProjectiles
+ * Method:    spawnAll
+ * Signature: (JLjava/nio/FloatBuffer;Ljava/nio/IntBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_spawnAll
+  (JNIEnv *, jobject, jlong, jobject, jobject);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsProjectiles
+ * Method:    clear
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_clear
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsProjectiles
+ * Method:    getCount
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsProjectiles_getCount
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsProjectiles
+ * Method:    getHitCount
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsProjectiles_getHitCount
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsProjectiles
+ * Method:    getHitObject
+ * Signature: (JI)Lcom/jme3/bullet/collision/PhysicsCollisionObject;
+ */
+JNIEXPORT jobject JNICALL Java_com_jme3_bullet_PhysicsProjectiles_getHitObject
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsProjectiles
+ * Method:    clearHits
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsProjectiles_clearHits
+  (JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -82,6 +82,7 @@ extern "C" {
         jmeUserPointer *userPointer = (jmeUserPointer*) collisionObject->getUserPointer();
         userPointer->space = space;
         space->getSoftDynamicsWorld()->addSoftBody(collisionObject);
+        space->objectAdded(collisionObject);
     }
 
     /*
@@ -106,6 +107,7 @@ extern "C" {
         jmeUserPointer *userPointer = (jmeUserPointer*) collisionObject->getUserPointer();
         userPointer->space = NULL;
         space->getSoftDynamicsWorld()->removeSoftBody(collisionObject);
+        space->objectRemoved(collisionObject);
     }
 
     /*
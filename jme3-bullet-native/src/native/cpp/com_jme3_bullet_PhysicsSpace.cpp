@@ -32,6 +32,8 @@
 #include "com_jme3_bullet_PhysicsSpace.h"
 #include "jmePhysicsSpace.h"
 #include "jmeBulletUtil.h"
+#include "jmeHeightfieldTerrainShape.h"
+#include "jmeCollisionAlgorithms.h"
 
 /**
  * Author: Normen Hansen
@@ -97,6 +99,7 @@ extern "C" {
         userPointer -> space = space;
 
         space->getDynamicsWorld()->addCollisionObject(collisionObject);
+        space->objectAdded(collisionObject);
     }
 
     /*
@@ -121,6 +124,7 @@ extern "C" {
         space->getDynamicsWorld()->removeCollisionObject(collisionObject);
         jmeUserPointer *userPointer = (jmeUserPointer*)collisionObject->getUserPointer();
         userPointer -> space = NULL;
+        space->objectRemoved(collisionObject);
     }
 
     /*
@@ -145,6 +149,7 @@ extern "C" {
         jmeUserPointer *userPointer = (jmeUserPointer*)collisionObject->getUserPointer();
         userPointer -> space = space;
         space->getDynamicsWorld()->addRigidBody(collisionObject);
+        space->objectAdded(collisionObject);
     }
 
     /*
@@ -169,6 +174,7 @@ extern "C" {
         jmeUserPointer *userPointer = (jmeUserPointer*)collisionObject->getUserPointer();
         userPointer -> space = NULL;
         space->getDynamicsWorld()->removeRigidBody(collisionObject);
+        space->objectRemoved(collisionObject);
     }
 
     /*
@@ -196,6 +202,7 @@ extern "C" {
                 btBroadphaseProxy::CharacterFilter,
                 btBroadphaseProxy::StaticFilter | btBroadphaseProxy::DefaultFilter
         );
+        space->objectAdded(collisionObject);
     }
 
     /*
@@ -220,6 +227,7 @@ extern "C" {
         jmeUserPointer *userPointer = (jmeUserPointer*)collisionObject->getUserPointer();
         userPointer -> space = NULL;
         space->getDynamicsWorld()->removeCollisionObject(collisionObject);
+        space->objectRemoved(collisionObject);
     }
 
     /*
@@ -448,7 +456,7 @@ extern "C" {
                 }
                 m_hitPointWorld.setInterpolate3(m_rayFromWorld, m_rayToWorld, rayResult.m_hitFraction);
 
-                jmeBulletUtil::addResult(env, resultlist, &m_hitNormalWorld, &m_hitPointWorld, rayResult.m_hitFraction, rayResult.m_collisionObject);
+                jmeBulletUtil::addResult(env, resultlist, &m_hitNormalWorld, &m_hitPointWorld, rayResult.m_hitFraction, rayResult.m_collisionObject, rayResult.m_localShapeInfo);
 
                 return 1.f;
             }
@@ -464,7 +472,7 @@ extern "C" {
         resultCallback.env = env;
         resultCallback.resultlist = resultlist;
         resultCallback.m_flags = flags;
-        space->getDynamicsWorld()->rayTest(native_from, native_to, resultCallback);
+        jmeHeightfieldTerrainShape::rayTest(space->getDynamicsWorld(), native_from, native_to, resultCallback);
         return;
     }
 
@@ -508,7 +516,7 @@ extern "C" {
                     }
                     m_hitPointWorld.setInterpolate3(m_convexFromWorld.getBasis() * m_convexFromWorld.getOrigin(), m_convexToWorld.getBasis() * m_convexToWorld.getOrigin(), convexResult.m_hitFraction);
 
-                    jmeBulletUtil::addSweepResult(env, resultlist, &m_hitNormalWorld, &m_hitPointWorld, convexResult.m_hitFraction, convexResult.m_hitCollisionObject);
+                    jmeBulletUtil::addSweepResult(env, resultlist, &m_hitNormalWorld, &m_hitPointWorld, convexResult.m_hitFraction, convexResult.m_hitCollisionObject, convexResult.m_localShapeInfo);
 
                     return 1.f;
             }
@@ -541,6 +549,566 @@ extern "C" {
         space->getDynamicsWorld()->getSolverInfo().m_numIterations = value;
     }
 
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    setSphereCapsuleConcaveAlgorithm
+     * Signature: (JZ)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setSphereCapsuleConcaveAlgorithm
+    (JNIEnv *env, jobject object, jlong spaceId, jboolean enabled) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        btCollisionDispatcher* dispatcher = (btCollisionDispatcher*) space->getDynamicsWorld()->getDispatcher();
+        if (enabled) {
+            jmeSphereCapsuleConcaveAlgorithm::registerAlgorithms(dispatcher);
+        } else {
+            jmeSphereCapsuleConcaveAlgorithm::unregisterAlgorithms(dispatcher);
+        }
+    }
+
+    struct jmeArcAabbCallback : public btBroadphaseAabbCallback {
+        bool found;
+
+        jmeArcAabbCallback() : found(false) {
+        }
+
+        virtual bool process(const btBroadphaseProxy* proxy) {
+            const btCollisionObject* object = (const btCollisionObject*) proxy->m_clientObject;
+            if (object->hasContactResponse()) {
+                found = true;
+                return false;
+            }
+            return true;
+        }
+    };
+
+    // the max number of segments of a trajectory, longer arcs use longer
+    // segments and so stray further than the tolerance from the curve
+#define JME_TRAJECTORY_MAX_SEGMENTS 1024
+
+    static inline btVector3 arcPosition(const btVector3& position, const btVector3& velocity, const btVector3& gravity, btScalar time) {
+        return position + velocity * time + gravity * (time * time * btScalar(0.5));
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    trajectoryTest_native
+     * Signature: (JLjava/nio/FloatBuffer;ILcom/jme3/math/Vector3f;FFLjava/nio/FloatBuffer;[Lcom/jme3/bullet/collision/PhysicsCollisionObject;)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_trajectoryTest_1native
+    (JNIEnv * env, jobject object, jlong spaceId, jobject launchesBuffer, jint count, jobject gravityVector, jfloat radius, jfloat maxTime, jobject resultsBuffer, jobjectArray objects) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        btCollisionWorld* world = space->getDynamicsWorld();
+        const jfloat* launches = (jfloat*) env->GetDirectBufferAddress(launchesBuffer);
+        jfloat* results = (jfloat*) env->GetDirectBufferAddress(resultsBuffer);
+        btVector3 gravity = btVector3();
+        jmeBulletUtil::convert(env, gravityVector, &gravity);
+
+        // segments duration, so the chord stay close to the arc : the max
+        // distance between them is |g| * dt^2 / 8
+        const btScalar tolerance = btMax(radius * btScalar(0.5), btScalar(0.01));
+        const btScalar g = gravity.length();
+        btScalar segmentTime = g > SIMD_EPSILON ? btSqrt(8 * tolerance / g) : maxTime;
+        if (!(maxTime > 0) || !(segmentTime > 0)) {
+            // an empty arc hit nothing, also avoid a NaN segment count
+            for (int i = 0; i < count; ++i, results += 8) {
+                results[0] = -1;
+                if (objects != NULL) {
+                    env->SetObjectArrayElement(objects, i, NULL);
+                }
+            }
+            return 0;
+        }
+        const btScalar segmentCount = ceil(maxTime / segmentTime);
+        int segments = segmentCount < JME_TRAJECTORY_MAX_SEGMENTS ? (int) segmentCount : JME_TRAJECTORY_MAX_SEGMENTS;
+        if (segments < 1) {
+            segments = 1;
+        }
+        segmentTime = maxTime / segments;
+        const btVector3 margin(radius, radius, radius);
+
+        int hitCount = 0;
+        jmeProjectiles::Hit hit;
+        for (int i = 0; i < count; ++i, launches += 6, results += 8) {
+            const btVector3 position(launches[0], launches[1], launches[2]);
+            const btVector3 velocity(launches[3], launches[4], launches[5]);
+            results[0] = -1;
+            if (objects != NULL) {
+                env->SetObjectArrayElement(objects, i, NULL);
+            }
+
+            // early out on the bounding box of the whole arc
+            btVector3 min = position;
+            btVector3 max = position;
+            const btVector3 end = arcPosition(position, velocity, gravity, maxTime);
+            min.setMin(end);
+            max.setMax(end);
+            for (int axis = 0; axis < 3; ++axis) {
+                if (gravity[axis] != 0) {
+                    const btScalar top = -velocity[axis] / gravity[axis];
+                    if (top > 0 && top < maxTime) {
+                        const btVector3 apex = arcPosition(position, velocity, gravity, top);
+                        min.setMin(apex);
+                        max.setMax(apex);
+                    }
+                }
+            }
+            jmeArcAabbCallback aabbCallback;
+            world->getBroadphase()->aabbTest(min - margin, max + margin, aabbCallback);
+            if (!aabbCallback.found) {
+                continue;
+            }
+
+            btVector3 from = position;
+            for (int s = 1; s <= segments; ++s) {
+                const btVector3 to = arcPosition(position, velocity, gravity, segmentTime * s);
+                if (jmeProjectiles::sweep(world, from, to, radius, hit)) {
+                    results[0] = segmentTime * (s - 1 + hit.fraction);
+                    results[1] = hit.point.x();
+                    results[2] = hit.point.y();
+                    results[3] = hit.point.z();
+                    results[4] = hit.normal.x();
+                    results[5] = hit.normal.y();
+                    results[6] = hit.normal.z();
+                    results[7] = hit.material;
+                    jmeUserPointer* up = (jmeUserPointer*) hit.object->getUserPointer();
+                    if (objects != NULL && up != NULL) {
+                        jobject javaCollisionObject = env->NewLocalRef(up->javaCollisionObject);
+                        env->SetObjectArrayElement(objects, i, javaCollisionObject);
+                        env->DeleteLocalRef(javaCollisionObject);
+                    }
+                    hitCount++;
+                    break;
+                }
+                from = to;
+            }
+        }
+        return hitCount;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    setDebugDrawMode
+     * Signature: (JI)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setDebugDrawMode
+    (JNIEnv * env, jobject object, jlong spaceId, jint mode) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        jmeDebugDraw* debugDraw = space->getDebugDraw();
+        debugDraw->setDebugMode(mode);
+        space->getDynamicsWorld()->setDebugDrawer(mode != btIDebugDraw::DBG_NoDebug ? debugDraw : NULL);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    debugDraw
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_debugDraw
+    (JNIEnv * env, jobject object, jlong spaceId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        if (space->getDynamicsWorld()->getDebugDrawer() == NULL) {
+            return 0;
+        }
+        return space->getDebugDraw()->draw(space->getDynamicsWorld());
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    getDebugLines
+     * Signature: (JLjava/nio/FloatBuffer;Ljava/nio/FloatBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_getDebugLines
+    (JNIEnv * env, jobject object, jlong spaceId, jobject positionsBuffer, jobject colorsBuffer, jint count) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        jfloat* positions = (jfloat*) env->GetDirectBufferAddress(positionsBuffer);
+        jfloat* colors = (jfloat*) env->GetDirectBufferAddress(colorsBuffer);
+        if (positions == NULL || colors == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return;
+        }
+        space->getDebugDraw()->copy(positions, colors, count);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    getDebugWarnings
+     * Signature: (J)Ljava/lang/String;
+     */
+    JNIEXPORT jstring JNICALL Java_com_jme3_bullet_PhysicsSpace_getDebugWarnings
+    (JNIEnv * env, jobject object, jlong spaceId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return NULL;
+        }
+        jmeDebugDraw* debugDraw = space->getDebugDraw();
+        const char* warnings = debugDraw->getWarnings();
+        if (warnings == NULL) {
+            return NULL;
+        }
+        jstring string = env->NewStringUTF(warnings);
+        debugDraw->clearWarnings();
+        return string;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    setSimulationLodEnabled
+     * Signature: (JZ)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setSimulationLodEnabled
+    (JNIEnv * env, jobject object, jlong spaceId, jboolean enabled) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        space->setSimulationLodEnabled(enabled);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    setSimulationTiers
+     * Signature: (J[J[II)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setSimulationTiers
+    (JNIEnv * env, jobject object, jlong spaceId, jlongArray objectIds, jintArray tiers, jint count) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        jlong* ids = env->GetLongArrayElements(objectIds, NULL);
+        jint* values = env->GetIntArrayElements(tiers, NULL);
+        for (int i = 0; i < count; i++) {
+            btCollisionObject* collisionObject = reinterpret_cast<btCollisionObject*> (ids[i]);
+            if (collisionObject != NULL) {
+                jmeSimulationLod::setTier(collisionObject, values[i]);
+            }
+        }
+        env->ReleaseIntArrayElements(tiers, values, JNI_ABORT);
+        env->ReleaseLongArrayElements(objectIds, ids, JNI_ABORT);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    freezeRegion
+     * Signature: (JLcom/jme3/math/Vector3f;Lcom/jme3/math/Vector3f;)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_freezeRegion
+    (JNIEnv * env, jobject object, jlong spaceId, jobject min, jobject max) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        btVector3 aabbMin, aabbMax;
+        jmeBulletUtil::convert(env, min, &aabbMin);
+        jmeBulletUtil::convert(env, max, &aabbMax);
+        return space->getFrozenRegions()->freeze(space->getDynamicsWorld(), aabbMin, aabbMax);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    freezeObjects
+     * Signature: (J[JI)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_freezeObjects
+    (JNIEnv * env, jobject object, jlong spaceId, jlongArray objectIds, jint count) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        btAlignedObjectArray<btCollisionObject*> objects;
+        objects.resize(count);
+        jlong* ids = env->GetLongArrayElements(objectIds, NULL);
+        for (int i = 0; i < count; i++) {
+            objects[i] = reinterpret_cast<btCollisionObject*> (ids[i]);
+        }
+        env->ReleaseLongArrayElements(objectIds, ids, JNI_ABORT);
+        if (count == 0) {
+            return space->getFrozenRegions()->freeze(space->getDynamicsWorld(), (btCollisionObject**) NULL, 0);
+        }
+        return space->getFrozenRegions()->freeze(space->getDynamicsWorld(), &objects[0], count);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    unfreezeRegion
+     * Signature: (JI)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_unfreezeRegion
+    (JNIEnv * env, jobject object, jlong spaceId, jint region) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        return space->getFrozenRegions()->unfreeze(space->getDynamicsWorld(), region);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    addNativeTickCallback
+     * Signature: (JJJZ)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_addNativeTickCallback
+    (JNIEnv * env, jobject object, jlong spaceId, jlong function, jlong userData, jboolean preTick) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        if (function == 0) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The tick function does not exist.");
+            return 0;
+        }
+        return space->getTickPlugins()->add(reinterpret_cast<jmeTickFunction> (function), reinterpret_cast<void*> (userData), preTick);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    removeNativeTickCallback
+     * Signature: (JI)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_PhysicsSpace_removeNativeTickCallback
+    (JNIEnv * env, jobject object, jlong spaceId, jint id) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return false;
+        }
+        return space->getTickPlugins()->remove(id);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    setJavaTickCallbacks
+     * Signature: (JZ)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setJavaTickCallbacks
+    (JNIEnv * env, jobject object, jlong spaceId, jboolean enabled) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        space->setJavaTickCallbacks(enabled);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    addForceField
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_addForceField
+    (JNIEnv * env, jobject object, jlong spaceId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        return space->getForceFields()->add();
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    removeForceField
+     * Signature: (JI)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_PhysicsSpace_removeForceField
+    (JNIEnv * env, jobject object, jlong spaceId, jint fieldId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return false;
+        }
+        return space->getForceFields()->remove(fieldId);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    setForceField
+     * Signature: (JIILcom/jme3/math/Vector3f;Lcom/jme3/math/Vector3f;Lcom/jme3/math/Quaternion;IILcom/jme3/math/Vector3f;FFZI)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setForceField
+    (JNIEnv * env, jobject object, jlong spaceId, jint fieldId, jint shape, jobject extents, jobject location, jobject rotation, jint profile, jint falloff, jobject direction, jfloat strength, jfloat noiseFrequency, jboolean massIndependent, jint groups) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        jmeForceField* field = space->getForceFields()->get(fieldId);
+        if (field == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The force field does not exist.");
+            return;
+        }
+        btQuaternion quaternion;
+        field->shape = shape;
+        jmeBulletUtil::convert(env, extents, &field->extents);
+        jmeBulletUtil::convert(env, location, &field->transform.getOrigin());
+        jmeBulletUtil::convert(env, rotation, &quaternion);
+        field->transform.setRotation(quaternion);
+        field->profile = profile;
+        field->falloff = falloff;
+        jmeBulletUtil::convert(env, direction, &field->direction);
+        field->strength = strength;
+        field->noiseFrequency = noiseFrequency;
+        field->massIndependent = massIndependent;
+        field->groups = groups;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    setCostProfilingEnabled
+     * Signature: (JZ)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setCostProfilingEnabled
+    (JNIEnv * env, jobject object, jlong spaceId, jboolean enabled) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        space->setCostProfilingEnabled(enabled);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    getObjectCosts
+     * Signature: (JLjava/nio/LongBuffer;Ljava/nio/FloatBuffer;IZ)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_getObjectCosts
+    (JNIEnv * env, jobject object, jlong spaceId, jobject idBuffer, jobject costBuffer, jint sortIndex, jboolean reset) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        jmeCostProfiler* profiler = space->getCostProfiler();
+        if (profiler == NULL) {
+            return 0;
+        }
+        jlong* ids = (jlong*) env->GetDirectBufferAddress(idBuffer);
+        float* costs = (float*) env->GetDirectBufferAddress(costBuffer);
+        if (ids == NULL || costs == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return 0;
+        }
+        int max = (int) btMin(env->GetDirectBufferCapacity(idBuffer), env->GetDirectBufferCapacity(costBuffer) / JME_COST_SIZE);
+        btAlignedObjectArray<btCollisionObject*> objects;
+        objects.resize(max);
+        int count = profiler->getCosts(max > 0 ? &objects[0] : NULL, costs, max, sortIndex);
+        for (int i = 0; i < count; i++) {
+            ids[i] = reinterpret_cast<jlong> (objects[i]);
+        }
+        if (reset) {
+            profiler->reset();
+        }
+        return count;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    startRecording
+     * Signature: (JLjava/lang/String;)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_PhysicsSpace_startRecording
+    (JNIEnv * env, jobject object, jlong spaceId, jstring path) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return JNI_FALSE;
+        }
+        const char* file = env->GetStringUTFChars(path, NULL);
+        bool started = space->startRecording(file);
+        env->ReleaseStringUTFChars(path, file);
+        return started;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    stopRecording
+     * Signature: (J)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_stopRecording
+    (JNIEnv * env, jobject object, jlong spaceId) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return;
+        }
+        space->stopRecording();
+    }
+
+    /*
+     * Class:     com_jme3_bullet_PhysicsSpace
+     * Method:    heightfieldChanged
+     * Signature: (JJIIII)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_heightfieldChanged
+    (JNIEnv * env, jobject object, jlong spaceId, jlong objectId, jint minX, jint minZ, jint maxX, jint maxZ) {
+        jmePhysicsSpace* space = reinterpret_cast<jmePhysicsSpace*> (spaceId);
+        if (space == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The physics space does not exist.");
+            return 0;
+        }
+        btCollisionObject* collisionObject = reinterpret_cast<btCollisionObject*> (objectId);
+        if (collisionObject == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        return jmeHeightfieldTerrainShape::refreshObjects(space->getDynamicsWorld(), collisionObject, minX, minZ, maxX, maxZ);
+    }
+
 #ifdef __cplusplus
 }
 #endif
@@ -182,6 +182,182 @@ JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_sweepTest_1native
 JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setSolverNumIterations
 (JNIEnv *, jobject, jlong, jint);
 
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    trajectoryTest_native
+ * Signature: (JLjava/nio/FloatBuffer;ILcom/jme3/math/Vector3f;FFLjava/nio/FloatBuffer;[Lcom/jme3/bullet/collision/PhysicsCollisionObject;)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_trajectoryTest_1native
+  (JNIEnv *, jobject, jlong, jobject, jint, jobject, jfloat, jfloat, jobject, jobjectArray);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    setDebugDrawMode
+ * Signature: (JI)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setDebugDrawMode
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    debugDraw
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_debugDraw
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    getDebugLines
+ * Signature: (JLjava/nio/FloatBuffer;Ljava/nio/FloatBuffer;I)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_getDebugLines
+  (JNIEnv *, jobject, jlong, jobject, jobject, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    setSimulationLodEnabled
+ * Signature: (JZ)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setSimulationLodEnabled
+  (JNIEnv *, jobject, jlong, jboolean);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    setSimulationTiers
+ * Signature: (J[J[II)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setSimulationTiers
+  (JNIEnv *, jobject, jlong, jlongArray, jintArray, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    freezeRegion
+ * Signature: (JLcom/jme3/math/Vector3f;Lcom/jme3/math/Vector3f;)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_freezeRegion
+  (JNIEnv *, jobject, jlong, jobject, jobject);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    freezeObjects
+ * Signature: (J[JI)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_freezeObjects
+  (JNIEnv *, jobject, jlong, jlongArray, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    unfreezeRegion
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_unfreezeRegion
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    addNativeTickCallback
+ * Signature: (JJJZ)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_addNativeTickCallback
+  (JNIEnv *, jobject, jlong, jlong, jlong, jboolean);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    removeNativeTickCallback
+ * Signature: (JI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_PhysicsSpace_removeNativeTickCallback
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    setJavaTickCallbacks
+ * Signature: (JZ)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setJavaTickCallbacks
+  (JNIEnv *, jobject, jlong, jboolean);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    addForceField
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_addForceField
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    removeForceField
+ * Signature: (JI)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_PhysicsSpace_removeForceField
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    setForceField
+ * Signature: (JIILcom/jme3/math/Vector3f;Lcom/jme3/math/Vector3f;Lcom/jme3/math/Quaternion;IILcom/jme3/math/Vector3f;FFZI)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setForceField
+  (JNIEnv *, jobject, jlong, jint, jint, jobject, jobject, jobject, jint, jint, jobject, jfloat, jfloat, jboolean, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    setCostProfilingEnabled
+ * Signature: (JZ)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setCostProfilingEnabled
+  (JNIEnv *, jobject, jlong, jboolean);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    getObjectCosts
+ * Signature: (JLjava/nio/LongBuffer;Ljava/nio/FloatBuffer;IZ)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_getObjectCosts
+  (JNIEnv *, jobject, jlong, jobject, jobject, jint, jboolean);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    startRecording
+ * Signature: (JLjava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_PhysicsSpace_startRecording
+  (JNIEnv *, jobject, jlong, jstring);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    stopRecording
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_stopRecording
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    heightfieldChanged
+ * Signature: (JJIIII)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_PhysicsSpace_heightfieldChanged
+  (JNIEnv *, jobject, jlong, jlong, jint, jint, jint, jint);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    setSphereCapsuleConcaveAlgorithm
+ * Signature: (JZ)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_PhysicsSpace_setSphereCapsuleConcaveAlgorithm
+  (JNIEnv *, jobject, jlong, jboolean);
+
+/*
+ * Class:     com_jme3_bullet_PhysicsSpace
+ * Method:    getDebugWarnings
+ * Signature: (J)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_com_jme3_bullet_PhysicsSpace_getDebugWarnings
+  (JNIEnv *, jobject, jlong);
+
 #ifdef __cplusplus
 }
 #endif
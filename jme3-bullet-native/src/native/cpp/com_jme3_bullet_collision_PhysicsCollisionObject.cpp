@@ -36,6 +36,8 @@
 #include "com_jme3_bullet_collision_PhysicsCollisionObject.h"
 #include "jmeBulletUtil.h"
 #include "jmePhysicsSpace.h"
+#include "jmeSoftBodyExt.h"
+#include "jmeContactRules.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -77,9 +79,15 @@ extern "C" {
             return;
         }
         if (collisionObject -> getUserPointer() != NULL){
+            jmeFrozenRegions::release(collisionObject);
+            jmeGhostFilter::release(collisionObject);
             jmeUserPointer *userPointer = (jmeUserPointer*)collisionObject->getUserPointer();
             delete(userPointer);
         }
+        btSoftBody* softBody = btSoftBody::upcast(collisionObject);
+        if (softBody != NULL) {
+            jmeSoftBodyExt::release(softBody);
+        }
         delete(collisionObject);
     }
     /*
@@ -103,6 +111,11 @@ extern "C" {
         userPointer -> javaCollisionObject = env->NewWeakGlobalRef(object);
         userPointer -> group = group;
         userPointer -> groups = groups;
+        userPointer -> material = 0;
+        userPointer -> simulationTier = 0;
+        userPointer -> skippedTicks = 0;
+        userPointer -> frozen = NULL;
+        userPointer -> exactOverlaps = NULL;
         userPointer -> space = NULL;
         collisionObject -> setUserPointer(userPointer);
     }
@@ -143,6 +156,38 @@ extern "C" {
         }
     }
 
+    /*
+     * Class:     com_jme3_bullet_collision_PhysicsCollisionObject
+     * Method:    setContactMaterial
+     * Signature: (JI)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsCollisionObject_setContactMaterial
+      (JNIEnv *env, jobject object, jlong objectId, jint materialId) {
+        btCollisionObject* collisionObject = reinterpret_cast<btCollisionObject*>(objectId);
+        if (collisionObject == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeContactRules::setMaterial(collisionObject, materialId);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_PhysicsCollisionObject
+     * Method:    isFrozen
+     * Signature: (J)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_collision_PhysicsCollisionObject_isFrozen
+    (JNIEnv *env, jobject object, jlong objectId) {
+        btCollisionObject* collisionObject = reinterpret_cast<btCollisionObject*>(objectId);
+        if (collisionObject == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return false;
+        }
+        return jmeFrozenRegions::isFrozen(collisionObject);
+    }
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Author: Dokthar
+ */
+#include "com_jme3_bullet_collision_PhysicsContactMaterial.h"
+#include "jmeContactRules.h"
+#include "jmeBulletUtil.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /*
+     * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+     * Method:    createMaterial
+     * Signature: ()I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_createMaterial
+    (JNIEnv *env, jobject object) {
+        return jmeContactRules::createMaterial();
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+     * Method:    setCombine
+     * Signature: (III)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setCombine
+    (JNIEnv *env, jobject object, jint materialId, jint frictionCombine, jint restitutionCombine) {
+        jmeContactMaterial material;
+        if (!jmeContactRules::readMaterial(materialId, material)) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        material.frictionCombine = frictionCombine;
+        material.restitutionCombine = restitutionCombine;
+        jmeContactRules::writeMaterial(materialId, material);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+     * Method:    setSurfaceVelocity
+     * Signature: (ILcom/jme3/math/Vector3f;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setSurfaceVelocity
+    (JNIEnv *env, jobject object, jint materialId, jobject velocity) {
+        jmeContactMaterial material;
+        if (!jmeContactRules::readMaterial(materialId, material)) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeBulletUtil::convert(env, velocity, &material.surfaceVelocity);
+        jmeContactRules::writeMaterial(materialId, material);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+     * Method:    setOneWay
+     * Signature: (IZLcom/jme3/math/Vector3f;F)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setOneWay
+    (JNIEnv *env, jobject object, jint materialId, jboolean oneWay, jobject direction, jfloat maxAngle) {
+        jmeContactMaterial material;
+        if (!jmeContactRules::readMaterial(materialId, material)) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        material.oneWay = oneWay;
+        jmeBulletUtil::convert(env, direction, &material.oneWayDirection);
+        if (material.oneWayDirection.fuzzyZero()) {
+            material.oneWayDirection.setValue(0, 1, 0);
+        } else {
+            material.oneWayDirection.normalize();
+        }
+        material.oneWayCos = btCos(maxAngle);
+        jmeContactRules::writeMaterial(materialId, material);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+     * Method:    setContactsDisabled
+     * Signature: (IZ)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setContactsDisabled
+    (JNIEnv *env, jobject object, jint materialId, jboolean disabled) {
+        jmeContactMaterial material;
+        if (!jmeContactRules::readMaterial(materialId, material)) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        material.disabled = disabled;
+        jmeContactRules::writeMaterial(materialId, material);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+     * Method:    setPairRule
+     * Signature: (IIZFF)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setPairRule
+    (JNIEnv *env, jobject object, jint materialId, jint otherId, jboolean disabled, jfloat friction, jfloat restitution) {
+        jmeContactRules::setPairRule(materialId, otherId, disabled, friction, restitution);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+     * Method:    removePairRule
+     * Signature: (II)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_removePairRule
+    (JNIEnv *env, jobject object, jint materialId, jint otherId) {
+        jmeContactRules::removePairRule(materialId, otherId);
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_jme3_bullet_collision_PhysicsContactMaterial */
+
+#ifndef _Included_com_jme3_bullet_collision_PhysicsContactMaterial
+#define _Included_com_jme3_bullet_collision_PhysicsContactMaterial
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+ * Method:    createMaterial
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_createMaterial
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+ * Method:    setCombine
+ * Signature: (III)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setCombine
+  (JNIEnv *, jobject, jint, jint, jint);
+
+/*
+ * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+ * Method:    setSurfaceVelocity
+ * Signature: (ILcom/jme3/math/Vector3f;)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setSurfaceVelocity
+  (JNIEnv *, jobject, jint, jobject);
+
+/*
+ * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+ * Method:    setOneWay
+ * Signature: (IZLcom/jme3/math/Vector3f;F)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setOneWay
+  (JNIEnv *, jobject, jint, jboolean, jobject, jfloat);
+
+/*
+ * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+ * Method:    setContactsDisabled
+ * Signature: (IZ)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setContactsDisabled
+  (JNIEnv *, jobject, jint, jboolean);
+
+/*
+ * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+ * Method:    setPairRule
+ * Signature: (IIZFF)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_setPairRule
+  (JNIEnv *, jobject, jint, jint, jboolean, jfloat, jfloat);
+
+/*
+ * Class:     com_jme3_bullet_collision_PhysicsContactMaterial
+ * Method:    removePairRule
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_PhysicsContactMaterial_removePairRule
+  (JNIEnv *, jobject, jint, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
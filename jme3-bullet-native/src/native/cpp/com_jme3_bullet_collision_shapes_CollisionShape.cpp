@@ -35,6 +35,7 @@
  */
 #include "com_jme3_bullet_collision_shapes_CollisionShape.h"
 #include "jmeBulletUtil.h"
+#include "jmeTriangleMaterials.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -103,8 +104,50 @@ extern "C" {
             env->ThrowNew(newExc, "The native object does not exist.");
             return;
         }
+        jmeTriangleMaterials::release(shape);
         delete(shape);
     }
+
+
+    /*
+     * Class:     com_jme3_bullet_collision_shapes_CollisionShape
+     * Method:    setTriangleMaterials
+     * Signature: (J[B)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_shapes_CollisionShape_setTriangleMaterials
+    (JNIEnv * env, jobject object, jlong shapeId, jbyteArray materials) {
+        btCollisionShape* shape = reinterpret_cast<btCollisionShape*>(shapeId);
+        if (shape == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        if (materials == NULL) {
+            jmeTriangleMaterials::release(shape);
+            return;
+        }
+        int count = env->GetArrayLength(materials);
+        jbyte* data = env->GetByteArrayElements(materials, NULL);
+        jmeTriangleMaterials::set(shape, (const unsigned char*) data, count);
+        env->ReleaseByteArrayElements(materials, data, JNI_ABORT);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_shapes_CollisionShape
+     * Method:    getTriangleMaterial
+     * Signature: (JII)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_collision_shapes_CollisionShape_getTriangleMaterial
+    (JNIEnv * env, jobject object, jlong shapeId, jint partIndex, jint triangleIndex) {
+        btCollisionShape* shape = reinterpret_cast<btCollisionShape*>(shapeId);
+        if (shape == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return -1;
+        }
+        return jmeTriangleMaterials::get(shape, partIndex, triangleIndex);
+    }
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,22 @@ JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_shapes_CollisionShape_setM
 JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_shapes_CollisionShape_finalizeNative
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     com_jme3_bullet_collision_shapes_CollisionShape
+ * Method:    setTriangleMaterials
+ * Signature: (J[B)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_collision_shapes_CollisionShape_setTriangleMaterials
+  (JNIEnv *, jobject, jlong, jbyteArray);
+
+/*
+ * Class:     com_jme3_bullet_collision_shapes_CollisionShape
+ * Method:    getTriangleMaterial
+ * Signature: (JII)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_collision_shapes_CollisionShape_getTriangleMaterial
+  (JNIEnv *, jobject, jlong, jint, jint);
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,7 +35,7 @@
  */
 #include "com_jme3_bullet_collision_shapes_HeightfieldCollisionShape.h"
 #include "jmeBulletUtil.h"
-#include "BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h"
+#include "jmeHeightfieldTerrainShape.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,10 +50,58 @@ extern "C" {
     (JNIEnv * env, jobject object, jint heightStickWidth, jint heightStickLength, jobject heightfieldData, jfloat heightScale, jfloat minHeight, jfloat maxHeight, jint upAxis, jboolean flipQuadEdges) {
         jmeClasses::initJavaClasses(env);
         void* data = env->GetDirectBufferAddress(heightfieldData);
-        btHeightfieldTerrainShape* shape=new btHeightfieldTerrainShape(heightStickWidth, heightStickLength, data, heightScale, minHeight, maxHeight, upAxis, PHY_FLOAT, flipQuadEdges);
+        jmeHeightfieldTerrainShape* shape = new jmeHeightfieldTerrainShape(heightStickWidth, heightStickLength, data, heightScale, minHeight, maxHeight, upAxis, PHY_FLOAT, flipQuadEdges);
         return reinterpret_cast<jlong>(shape);
     }
 
+    /*
+     * Class:     com_jme3_bullet_collision_shapes_HeightfieldCollisionShape
+     * Method:    heightsChanged
+     * Signature: (JIIII)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_collision_shapes_HeightfieldCollisionShape_heightsChanged
+    (JNIEnv * env, jobject object, jlong shapeId, jint minX, jint minZ, jint maxX, jint maxZ) {
+        jmeHeightfieldTerrainShape* shape = reinterpret_cast<jmeHeightfieldTerrainShape*> (shapeId);
+        if (shape == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return JNI_FALSE;
+        }
+        return shape->heightsChanged(minX, minZ, maxX, maxZ) ? JNI_TRUE : JNI_FALSE;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_shapes_HeightfieldCollisionShape
+     * Method:    getMinHeight
+     * Signature: (J)F
+     */
+    JNIEXPORT jfloat JNICALL Java_com_jme3_bullet_collision_shapes_HeightfieldCollisionShape_getMinHeight
+    (JNIEnv * env, jobject object, jlong shapeId) {
+        jmeHeightfieldTerrainShape* shape = reinterpret_cast<jmeHeightfieldTerrainShape*> (shapeId);
+        if (shape == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        return shape->getMinHeight();
+    }
+
+    /*
+     * Class:     com_jme3_bullet_collision_shapes_HeightfieldCollisionShape
+     * Method:    getMaxHeight
+     * Signature: (J)F
+     */
+    JNIEXPORT jfloat JNICALL Java_com_jme3_bullet_collision_shapes_HeightfieldCollisionShape_getMaxHeight
+    (JNIEnv * env, jobject object, jlong shapeId) {
+        jmeHeightfieldTerrainShape* shape = reinterpret_cast<jmeHeightfieldTerrainShape*> (shapeId);
+        if (shape == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        return shape->getMaxHeight();
+    }
+
 #ifdef __cplusplus
 }
 #endif
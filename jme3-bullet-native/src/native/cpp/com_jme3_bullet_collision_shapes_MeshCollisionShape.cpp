@@ -35,6 +35,7 @@
 */
 #include "com_jme3_bullet_collision_shapes_MeshCollisionShape.h"
 #include "jmeBulletUtil.h"
+#include "jmeParallelBvh.h"
 #include "BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h"
 #include "btBulletDynamicsCommon.h"
 #include "BulletCollision/Gimpact/btGImpactShape.h"
@@ -47,12 +48,21 @@ extern "C" {
     /*
      * Class:     com_jme3_bullet_collision_shapes_MeshCollisionShape
      * Method:    createShape
-     * Signature: (J)J
+     * Signature: (ZZZJ)J
      */
     JNIEXPORT jlong JNICALL Java_com_jme3_bullet_collision_shapes_MeshCollisionShape_createShape
-    (JNIEnv* env, jobject object,jboolean isMemoryEfficient,jboolean buildBVH, jlong arrayId) {
+    (JNIEnv* env, jobject object,jboolean isMemoryEfficient,jboolean buildBVH, jboolean parallelBVH, jlong arrayId) {
         jmeClasses::initJavaClasses(env);
         btTriangleIndexVertexArray* array = reinterpret_cast<btTriangleIndexVertexArray*>(arrayId);
+        if (parallelBVH && buildBVH) {
+            if (!jmeParallelBvh::isSupported(array)) {
+                jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+                env->ThrowNew(newExc, "Too many triangles in a mesh part for the BVH.");
+                return 0;
+            }
+            jmeParallelBvhTriangleMeshShape* shape = new jmeParallelBvhTriangleMeshShape(array);
+            return reinterpret_cast<jlong>(shape);
+        }
         btBvhTriangleMeshShape* shape = new btBvhTriangleMeshShape(array, isMemoryEfficient, buildBVH);
         return reinterpret_cast<jlong>(shape);
     }
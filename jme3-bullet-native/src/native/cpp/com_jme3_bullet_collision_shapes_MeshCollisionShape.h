@@ -26,10 +26,10 @@ JNIEXPORT jbyteArray JNICALL Java_com_jme3_bullet_collision_shapes_MeshCollision
 /*
  * Class:     com_jme3_bullet_collision_shapes_MeshCollisionShape
  * Method:    createShape
- * Signature: (ZZJ)J
+ * Signature: (ZZZJ)J
  */
 JNIEXPORT jlong JNICALL Java_com_jme3_bullet_collision_shapes_MeshCollisionShape_createShape
-  (JNIEnv *, jobject, jboolean, jboolean, jlong);
+  (JNIEnv *, jobject, jboolean, jboolean, jboolean, jlong);
 
 /*
  * Class:     com_jme3_bullet_collision_shapes_MeshCollisionShape
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Author: Dokthar
+ */
+#include "com_jme3_bullet_control_ragdoll_NativeRagdollRig.h"
+#include "jmeBulletUtil.h"
+#include "jmeRagdollRig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /*
+     * Class:     com_jme3_bullet_control_ragdoll_NativeRagdollRig
+     * Method:    createRig
+     * Signature: (I)J
+     */
+    JNIEXPORT jlong JNICALL Java_com_jme3_bullet_control_ragdoll_NativeRagdollRig_createRig
+    (JNIEnv *env, jobject object, jint boneCount) {
+        jmeClasses::initJavaClasses(env);
+        jmeRagdollRig* rig = new jmeRagdollRig(boneCount);
+        return reinterpret_cast<jlong> (rig);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_control_ragdoll_NativeRagdollRig
+     * Method:    setBone
+     * Signature: (JIJLcom/jme3/math/Quaternion;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_control_ragdoll_NativeRagdollRig_setBone
+    (JNIEnv *env, jobject object, jlong rigId, jint index, jlong bodyId, jobject bindRotation) {
+        jmeRagdollRig* rig = reinterpret_cast<jmeRagdollRig*> (rigId);
+        if (rig == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        if (index < 0 || index >= rig->getBoneCount()) {
+            jclass newExc = env->FindClass("java/lang/IndexOutOfBoundsException");
+            env->ThrowNew(newExc, "The bone index is out of the rig.");
+            return;
+        }
+        btQuaternion rotation;
+        jmeBulletUtil::convert(env, bindRotation, &rotation);
+        rig->setBone(index, reinterpret_cast<btRigidBody*> (bodyId), rotation);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_control_ragdoll_NativeRagdollRig
+     * Method:    getPose
+     * Signature: (J[JLcom/jme3/math/Vector3f;Lcom/jme3/math/Quaternion;Lcom/jme3/math/Vector3f;Ljava/nio/FloatBuffer;FLjava/nio/FloatBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_control_ragdoll_NativeRagdollRig_getPose
+    (JNIEnv *env, jobject object, jlong rigId, jlongArray bodyIds, jobject modelLocation, jobject modelRotation, jobject modelScale, jobject animatedBuffer, jfloat blend, jobject poseBuffer) {
+        jmeRagdollRig* rig = reinterpret_cast<jmeRagdollRig*> (rigId);
+        if (rig == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jfloat* pose = (jfloat*) env->GetDirectBufferAddress(poseBuffer);
+        jfloat* animated = animatedBuffer != NULL ? (jfloat*) env->GetDirectBufferAddress(animatedBuffer) : NULL;
+        if (pose == NULL || (animatedBuffer != NULL && animated == NULL)) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return;
+        }
+        jlong size = (jlong) rig->getBoneCount() * JME_RAGDOLL_BONE_SIZE;
+        if (env->GetDirectBufferCapacity(poseBuffer) < size
+                || (animatedBuffer != NULL && env->GetDirectBufferCapacity(animatedBuffer) < size)) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers are too small for the rig.");
+            return;
+        }
+        if (env->GetArrayLength(bodyIds) < rig->getBoneCount()) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The body ids are too few for the rig.");
+            return;
+        }
+        jlong* ids = env->GetLongArrayElements(bodyIds, NULL);
+        rig->setBodies(ids);
+        env->ReleaseLongArrayElements(bodyIds, ids, JNI_ABORT);
+        btVector3 location;
+        btQuaternion rotation;
+        btVector3 scale;
+        jmeBulletUtil::convert(env, modelLocation, &location);
+        jmeBulletUtil::convert(env, modelRotation, &rotation);
+        jmeBulletUtil::convert(env, modelScale, &scale);
+        rig->getPose(btTransform(rotation, location), scale, animated, blend, pose);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_control_ragdoll_NativeRagdollRig
+     * Method:    finalizeNative
+     * Signature: (J)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_control_ragdoll_NativeRagdollRig_finalizeNative
+    (JNIEnv *env, jobject object, jlong rigId) {
+        jmeRagdollRig* rig = reinterpret_cast<jmeRagdollRig*> (rigId);
+        if (rig == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        delete(rig);
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,45 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_jme3_bullet_control_ragdoll_NativeRagdollRig */
+
+#ifndef _Included_com_jme3_bullet_control_ragdoll_NativeRagdollRig
+#define _Included_com_jme3_bullet_control_ragdoll_NativeRagdollRig
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     com_jme3_bullet_control_ragdoll_NativeRagdollRig
+ * Method:    createRig
+ * Signature: (I)J
+ */
+JNIEXPORT jlong JNICALL Java_com_jme3_bullet_control_ragdoll_NativeRagdollRig_createRig
+  (JNIEnv *, jobject, jint);
+
+/*
+ * Class:     com_jme3_bullet_control_ragdoll_NativeRagdollRig
+ * Method:    setBone
+ * Signature: (JIJLcom/jme3/math/Quaternion;)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_control_ragdoll_NativeRagdollRig_setBone
+  (JNIEnv *, jobject, jlong, jint, jlong, jobject);
+
+/*
+ * Class:     com_jme3_bullet_control_ragdoll_NativeRagdollRig
+ * Method:    getPose
+ * Signature: (J[JLcom/jme3/math/Vector3f;Lcom/jme3/math/Quaternion;Lcom/jme3/math/Vector3f;Ljava/nio/FloatBuffer;FLjava/nio/FloatBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_control_ragdoll_NativeRagdollRig_getPose
+  (JNIEnv *, jobject, jlong, jlongArray, jobject, jobject, jobject, jobject, jfloat, jobject);
+
+/*
+ * Class:     com_jme3_bullet_control_ragdoll_NativeRagdollRig
+ * Method:    finalizeNative
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_control_ragdoll_NativeRagdollRig_finalizeNative
+  (JNIEnv *, jobject, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
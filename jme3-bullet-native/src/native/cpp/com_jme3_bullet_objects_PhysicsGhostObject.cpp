@@ -189,6 +189,9 @@ extern "C" {
             }else{
                 other = (btCollisionObject *)pair.m_pProxy1->m_clientObject;
             }
+            if (!jmeGhostFilter::isOverlapping(m_ghost, other)) {
+                return false;
+            }
             jmeUserPointer *up1 = (jmeUserPointer*)other -> getUserPointer();
             jobject javaCollisionObject1 = m_env->NewLocalRef(up1->javaCollisionObject);
             m_env->CallVoidMethod(m_object, jmeClasses::PhysicsGhostObject_addOverlappingObject, javaCollisionObject1);
@@ -232,6 +235,9 @@ extern "C" {
             env->ThrowNew(newExc, "The native object does not exist.");
             return 0;
         }
+        if (jmeGhostFilter::isEnabled(ghost)) {
+            return jmeGhostFilter::getOverlapping(ghost, NULL, 0);
+        }
         return ghost->getNumOverlappingObjects();
     }
 
@@ -315,6 +321,51 @@ extern "C" {
         return ghost->getCcdSquareMotionThreshold();
     }
 
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsGhostObject
+     * Method:    setExactOverlaps
+     * Signature: (JZ)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsGhostObject_setExactOverlaps
+    (JNIEnv *env, jobject object, jlong objectId, jboolean enabled) {
+        btPairCachingGhostObject* ghost = reinterpret_cast<btPairCachingGhostObject*>(objectId);
+        if (ghost == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeGhostFilter::setEnabled(ghost, enabled);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsGhostObject
+     * Method:    getOverlappingIds
+     * Signature: (JLjava/nio/LongBuffer;)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsGhostObject_getOverlappingIds
+    (JNIEnv *env, jobject object, jlong objectId, jobject idBuffer) {
+        btPairCachingGhostObject* ghost = reinterpret_cast<btPairCachingGhostObject*>(objectId);
+        if (ghost == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        jlong* ids = (jlong*) env->GetDirectBufferAddress(idBuffer);
+        if (ids == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return 0;
+        }
+        int max = (int) env->GetDirectBufferCapacity(idBuffer);
+        btAlignedObjectArray<btCollisionObject*> objects;
+        objects.resize(max);
+        int count = jmeGhostFilter::getOverlapping(ghost, max > 0 ? &objects[0] : NULL, max);
+        for (int i = 0; i < count && i < max; i++) {
+            ids[i] = reinterpret_cast<jlong> (objects[i]);
+        }
+        return count;
+    }
+
 #ifdef __cplusplus
 }
 #endif
@@ -36,6 +36,7 @@
 #include "com_jme3_bullet_objects_PhysicsRigidBody.h"
 #include "jmeBulletUtil.h"
 #include "jmeMotionState.h"
+#include "jmeSimulationLod.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -877,6 +878,39 @@ extern "C" {
         body->setLinearFactor(vec);
     }
     
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsRigidBody
+     * Method:    setSimulationTier
+     * Signature: (JI)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsRigidBody_setSimulationTier
+    (JNIEnv *env, jobject object, jlong bodyId, jint tier) {
+        btRigidBody* body = reinterpret_cast<btRigidBody*>(bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeSimulationLod::setTier(body, tier);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsRigidBody
+     * Method:    getSimulationTier
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsRigidBody_getSimulationTier
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btRigidBody* body = reinterpret_cast<btRigidBody*>(bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        return jmeSimulationLod::getTier(body);
+    }
+
 #ifdef __cplusplus
 }
 #endif
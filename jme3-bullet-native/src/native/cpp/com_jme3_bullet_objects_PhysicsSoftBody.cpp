@@ -37,6 +37,8 @@
 #include "jmeBulletUtil.h"
 #include "BulletSoftBody/btSoftBody.h"
 #include "BulletSoftBody/btSoftBodyHelpers.h"
+#include "jmeSoftBodyExt.h"
+#include "jmeSoftBodyClusters.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -1176,7 +1178,7 @@ extern "C" {
             env->ThrowNew(newExc, "The native object does not exist.");
             return;
         }
-        body->generateClusters(k, maxIter);
+        jmeSoftBodyClusters::generate(body, k, maxIter);
     }
 
     /*
@@ -1215,6 +1217,566 @@ extern "C" {
         return;
     }
 
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    setSkinnedPins
+     * Signature: (JLjava/nio/IntBuffer;Ljava/nio/IntBuffer;Ljava/nio/FloatBuffer;Ljava/nio/FloatBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_setSkinnedPins
+    (JNIEnv *env, jobject object, jlong bodyId, jobject nodesBuffer, jobject bonesBuffer, jobject weightsBuffer, jobject bindPositionsBuffer) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        const jint* nodes = (jint*) env->GetDirectBufferAddress(nodesBuffer);
+        const jint* bones = (jint*) env->GetDirectBufferAddress(bonesBuffer);
+        const jfloat* weights = (jfloat*) env->GetDirectBufferAddress(weightsBuffer);
+        const jfloat* bindPositions = (jfloat*) env->GetDirectBufferAddress(bindPositionsBuffer);
+        const int count = env->GetDirectBufferCapacity(nodesBuffer);
+
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::get(body);
+        if (ext->skin == NULL) {
+            ext->skin = new jmeSoftBodySkin(body);
+        }
+        ext->skin->setPins(nodes, bones, weights, bindPositions, count);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    clearSkinnedPins
+     * Signature: (J)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_clearSkinnedPins
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext != NULL && ext->skin != NULL) {
+            delete(ext->skin);
+            ext->skin = NULL;
+        }
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    getNbSkinnedPins
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_getNbSkinnedPins
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext == NULL || ext->skin == NULL) {
+            return 0;
+        }
+        return ext->skin->getPinCount();
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    setPinBoneMatrices
+     * Signature: (JLjava/nio/FloatBuffer;ILcom/jme3/math/Transform;Lcom/jme3/math/Vector3f;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_setPinBoneMatrices
+    (JNIEnv *env, jobject object, jlong bodyId, jobject matricesBuffer, jint boneCount, jobject modelToWorld, jobject scale) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext == NULL || ext->skin == NULL) {
+            return;
+        }
+        const jfloat* matrices = (jfloat*) env->GetDirectBufferAddress(matricesBuffer);
+
+        btTransform trs = btTransform();
+        jmeBulletUtil::convert(env, modelToWorld, &trs);
+        btVector3 scl = btVector3();
+        jmeBulletUtil::convert(env, scale, &scl);
+
+        ext->skin->setBoneMatrices(matrices, boneCount, trs, scl);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    getSelfCollisionTime
+     * Signature: (J)F
+     */
+    JNIEXPORT jfloat JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_getSelfCollisionTime
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext == NULL || ext->selfCollision == NULL) {
+            return 0;
+        }
+        return ext->selfCollision->lastTime;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    getSelfCollisionTests
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_getSelfCollisionTests
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext == NULL || ext->selfCollision == NULL) {
+            return 0;
+        }
+        return ext->selfCollision->lastTests;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    getSelfCollisionContacts
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_getSelfCollisionContacts
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext == NULL || ext->selfCollision == NULL) {
+            return 0;
+        }
+        return ext->selfCollision->lastContacts;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    appendAnchors
+     * Signature: (JLjava/nio/IntBuffer;[JLjava/nio/IntBuffer;Ljava/nio/FloatBuffer;Ljava/nio/FloatBuffer;Z)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_appendAnchors
+    (JNIEnv *env, jobject object, jlong bodyId, jobject nodesBuffer, jlongArray rigidIds, jobject bodyIndexesBuffer, jobject influencesBuffer, jobject localPivotsBuffer, jboolean collisionBetweenLinkedBodies) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+
+        const int rigidCount = env->GetArrayLength(rigidIds);
+        jlong* ids = env->GetLongArrayElements(rigidIds, NULL);
+        // world to local transform of each rigid body, computed once
+        btAlignedObjectArray<btTransform> inverses;
+        inverses.resize(rigidCount);
+        for (int i = 0; i < rigidCount; ++i) {
+            btRigidBody* rigid = reinterpret_cast<btRigidBody*> (ids[i]);
+            if (rigid == NULL) {
+                env->ReleaseLongArrayElements(rigidIds, ids, JNI_ABORT);
+                jclass newExc = env->FindClass("java/lang/NullPointerException");
+                env->ThrowNew(newExc, "The native object does not exist.");
+                return;
+            }
+            inverses[i] = rigid->getWorldTransform().inverse();
+            if (!collisionBetweenLinkedBodies && body->m_collisionDisabledObjects.findLinearSearch(rigid) == body->m_collisionDisabledObjects.size()) {
+                body->m_collisionDisabledObjects.push_back(rigid);
+            }
+        }
+
+        const jint* nodes = (jint*) env->GetDirectBufferAddress(nodesBuffer);
+        const int count = env->GetDirectBufferCapacity(nodesBuffer);
+        const jint* bodyIndexes = bodyIndexesBuffer == NULL ? NULL : (jint*) env->GetDirectBufferAddress(bodyIndexesBuffer);
+        const jfloat* influences = influencesBuffer == NULL ? NULL : (jfloat*) env->GetDirectBufferAddress(influencesBuffer);
+        const jfloat* localPivots = localPivotsBuffer == NULL ? NULL : (jfloat*) env->GetDirectBufferAddress(localPivotsBuffer);
+
+        body->m_anchors.reserve(body->m_anchors.size() + count);
+        for (int i = 0; i < count; ++i) {
+            const int rigidIndex = bodyIndexes == NULL ? 0 : bodyIndexes[i];
+            btSoftBody::Anchor a;
+            a.m_node = &body->m_nodes[nodes[i]];
+            a.m_body = reinterpret_cast<btRigidBody*> (ids[rigidIndex]);
+            if (localPivots == NULL) {
+                a.m_local = inverses[rigidIndex] * a.m_node->m_x;
+            } else {
+                a.m_local.setValue(localPivots[i * 3], localPivots[i * 3 + 1], localPivots[i * 3 + 2]);
+            }
+            a.m_influence = influences == NULL ? 1 : influences[i];
+            a.m_node->m_battach = 1;
+            body->m_anchors.push_back(a);
+        }
+        env->ReleaseLongArrayElements(rigidIds, ids, JNI_ABORT);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    removeAnchors
+     * Signature: (JJ)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_removeAnchors
+    (JNIEnv *env, jobject object, jlong bodyId, jlong rigidId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+
+        btRigidBody* rigid = reinterpret_cast<btRigidBody*> (rigidId);
+        if (rigid == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+
+        // keep the order of the remaining anchors
+        int size = 0;
+        for (int i = 0; i < body->m_anchors.size(); i++) {
+            if (body->m_anchors[i].m_body == rigid) {
+                body->m_anchors[i].m_node->m_battach = 0;
+            } else {
+                body->m_anchors[size++] = body->m_anchors[i];
+            }
+        }
+        body->m_anchors.resize(size);
+        // a node can still be attached to an other body
+        for (int i = 0; i < size; i++) {
+            body->m_anchors[i].m_node->m_battach = 1;
+        }
+        body->m_collisionDisabledObjects.remove(rigid);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    setAnchorsPivot
+     * Signature: (JJLjava/nio/IntBuffer;Ljava/nio/FloatBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_setAnchorsPivot
+    (JNIEnv *env, jobject object, jlong bodyId, jlong rigidId, jobject nodesBuffer, jobject localPivotsBuffer) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+
+        btRigidBody* rigid = reinterpret_cast<btRigidBody*> (rigidId);
+        if (rigid == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+
+        const jint* nodes = (jint*) env->GetDirectBufferAddress(nodesBuffer);
+        const int count = env->GetDirectBufferCapacity(nodesBuffer);
+        const jfloat* localPivots = (jfloat*) env->GetDirectBufferAddress(localPivotsBuffer);
+
+        // node index to pivot index
+        btAlignedObjectArray<int> pivots;
+        pivots.resize(body->m_nodes.size(), -1);
+        for (int i = 0; i < count; ++i) {
+            pivots[nodes[i]] = i;
+        }
+        btSoftBody::Node* first = &body->m_nodes[0];
+        for (int i = 0; i < body->m_anchors.size(); i++) {
+            btSoftBody::Anchor& a = body->m_anchors[i];
+            if (a.m_body != rigid) {
+                continue;
+            }
+            const int pivot = pivots[int(a.m_node - first)];
+            if (pivot >= 0) {
+                a.m_local.setValue(localPivots[pivot * 3], localPivots[pivot * 3 + 1], localPivots[pivot * 3 + 2]);
+            }
+        }
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    moveAnchors
+     * Signature: (JJJ)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_moveAnchors
+    (JNIEnv *env, jobject object, jlong bodyId, jlong fromId, jlong toId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+
+        btRigidBody* from = reinterpret_cast<btRigidBody*> (fromId);
+        btRigidBody* to = reinterpret_cast<btRigidBody*> (toId);
+        if (from == NULL || to == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+
+        // the pivots keep their world position
+        const btTransform fromToTo = to->getWorldTransform().inverse() * from->getWorldTransform();
+        for (int i = 0; i < body->m_anchors.size(); i++) {
+            btSoftBody::Anchor& a = body->m_anchors[i];
+            if (a.m_body == from) {
+                a.m_body = to;
+                a.m_local = fromToTo * a.m_local;
+            }
+        }
+        const int disabled = body->m_collisionDisabledObjects.findLinearSearch(from);
+        if (disabled != body->m_collisionDisabledObjects.size()) {
+            if (body->m_collisionDisabledObjects.findLinearSearch(to) == body->m_collisionDisabledObjects.size()) {
+                body->m_collisionDisabledObjects[disabled] = to;
+            } else {
+                // already listed, don't make a duplicate
+                body->m_collisionDisabledObjects.remove(from);
+            }
+        }
+    }
+
+    // state layout, 4 bytes per value : version, node count, cluster count,
+    // anchor count, then per node position and velocity, per cluster frame
+    // (origin and rotation), linear and angular velocity, per anchor node
+    // index, local pivot and influence
+#define JME_SOFT_STATE_VERSION 1
+#define JME_SOFT_STATE_HEADER 4
+#define JME_SOFT_STATE_NODE 6
+#define JME_SOFT_STATE_CLUSTER 13
+#define JME_SOFT_STATE_ANCHOR 5
+
+    static int getStateSize(btSoftBody* body) {
+        return 4 * (JME_SOFT_STATE_HEADER
+                + JME_SOFT_STATE_NODE * body->m_nodes.size()
+                + JME_SOFT_STATE_CLUSTER * body->m_clusters.size()
+                + JME_SOFT_STATE_ANCHOR * body->m_anchors.size());
+    }
+
+    static inline void putVector3(jfloat* out, const btVector3& vec) {
+        out[0] = vec.x();
+        out[1] = vec.y();
+        out[2] = vec.z();
+    }
+
+    static inline btVector3 getVector3(const jfloat* in) {
+        return btVector3(in[0], in[1], in[2]);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    getStateSize
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_getStateSize
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        return getStateSize(body);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    saveState
+     * Signature: (JLjava/nio/ByteBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_saveState
+    (JNIEnv *env, jobject object, jlong bodyId, jobject stateBuffer) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jint* header = (jint*) env->GetDirectBufferAddress(stateBuffer);
+        header[0] = JME_SOFT_STATE_VERSION;
+        header[1] = body->m_nodes.size();
+        header[2] = body->m_clusters.size();
+        header[3] = body->m_anchors.size();
+        jfloat* out = (jfloat*) (header + JME_SOFT_STATE_HEADER);
+
+        for (int i = 0; i < body->m_nodes.size(); ++i) {
+            const btSoftBody::Node& n = body->m_nodes[i];
+            putVector3(out, n.m_x);
+            putVector3(out + 3, n.m_v);
+            out += JME_SOFT_STATE_NODE;
+        }
+        for (int i = 0; i < body->m_clusters.size(); ++i) {
+            const btSoftBody::Cluster* c = body->m_clusters[i];
+            const btQuaternion rotation = c->m_framexform.getRotation();
+            putVector3(out, c->m_framexform.getOrigin());
+            out[3] = rotation.x();
+            out[4] = rotation.y();
+            out[5] = rotation.z();
+            out[6] = rotation.w();
+            putVector3(out + 7, c->m_lv);
+            putVector3(out + 10, c->m_av);
+            out += JME_SOFT_STATE_CLUSTER;
+        }
+        const btSoftBody::Node* first = body->m_nodes.size() > 0 ? &body->m_nodes[0] : NULL;
+        for (int i = 0; i < body->m_anchors.size(); ++i) {
+            const btSoftBody::Anchor& a = body->m_anchors[i];
+            ((jint*) out)[0] = int(a.m_node - first);
+            putVector3(out + 1, a.m_local);
+            out[4] = a.m_influence;
+            out += JME_SOFT_STATE_ANCHOR;
+        }
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    restoreState
+     * Signature: (JLjava/nio/ByteBuffer;)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_restoreState
+    (JNIEnv *env, jobject object, jlong bodyId, jobject stateBuffer) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return JNI_FALSE;
+        }
+        const jint* header = (jint*) env->GetDirectBufferAddress(stateBuffer);
+        const int capacity = env->GetDirectBufferCapacity(stateBuffer);
+        if (capacity < 4 * JME_SOFT_STATE_HEADER || header[0] != JME_SOFT_STATE_VERSION
+                || header[1] != body->m_nodes.size() || header[2] != body->m_clusters.size()) {
+            return JNI_FALSE;
+        }
+        const int anchorCount = header[3];
+        if (capacity < 4 * (JME_SOFT_STATE_HEADER + JME_SOFT_STATE_NODE * header[1]
+                + JME_SOFT_STATE_CLUSTER * header[2] + JME_SOFT_STATE_ANCHOR * anchorCount)) {
+            return JNI_FALSE;
+        }
+        const jfloat* in = (const jfloat*) (header + JME_SOFT_STATE_HEADER);
+
+        for (int i = 0; i < body->m_nodes.size(); ++i) {
+            btSoftBody::Node& n = body->m_nodes[i];
+            n.m_x = getVector3(in);
+            n.m_q = n.m_x;
+            n.m_v = getVector3(in + 3);
+            n.m_f.setZero();
+            in += JME_SOFT_STATE_NODE;
+        }
+        for (int i = 0; i < body->m_clusters.size(); ++i) {
+            btSoftBody::Cluster* c = body->m_clusters[i];
+            c->m_framexform.setOrigin(getVector3(in));
+            c->m_framexform.setRotation(btQuaternion(in[3], in[4], in[5], in[6]));
+            c->m_lv = getVector3(in + 7);
+            c->m_av = getVector3(in + 10);
+            in += JME_SOFT_STATE_CLUSTER;
+        }
+        // anchors can't hold their rigid body, they are matched by node with
+        // the anchors already appended to this body
+        int next = 0;
+        for (int i = 0; i < anchorCount; ++i) {
+            const int node = ((const jint*) in)[0];
+            for (int j = 0; node >= 0 && node < body->m_nodes.size() && j < body->m_anchors.size(); ++j) {
+                btSoftBody::Anchor& a = body->m_anchors[(next + j) % body->m_anchors.size()];
+                if (a.m_node == &body->m_nodes[node]) {
+                    a.m_local = getVector3(in + 1);
+                    a.m_influence = in[4];
+                    next = (next + j + 1) % body->m_anchors.size();
+                    break;
+                }
+            }
+            in += JME_SOFT_STATE_ANCHOR;
+        }
+
+        // the node tree, then the bounds from its root, updateBounds() also
+        // moves the broadphase proxy of a body in a world
+        const btScalar margin = body->getCollisionShape()->getMargin();
+        for (int i = 0; i < body->m_nodes.size(); ++i) {
+            btSoftBody::Node& n = body->m_nodes[i];
+            if (n.m_leaf != NULL) {
+                btDbvtVolume volume = btDbvtVolume::FromCR(n.m_x, margin);
+                body->m_ndbvt.update(n.m_leaf, volume);
+            }
+        }
+        body->updateNormals();
+        body->updateBounds();
+        body->activate();
+        return JNI_TRUE;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    getClusterAssignmentSize
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_getClusterAssignmentSize
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        return jmeSoftBodyClusters::getAssignmentSize(body);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    getClusterAssignment
+     * Signature: (JLjava/nio/IntBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_getClusterAssignment
+    (JNIEnv *env, jobject object, jlong bodyId, jobject assignmentBuffer) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jint* assignment = (jint*) env->GetDirectBufferAddress(assignmentBuffer);
+        if (assignment == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return;
+        }
+        jmeSoftBodyClusters::getAssignment(body, assignment);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody
+     * Method:    setClusterAssignment
+     * Signature: (JLjava/nio/IntBuffer;I)Z
+     */
+    JNIEXPORT jboolean JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_setClusterAssignment
+    (JNIEnv *env, jobject object, jlong bodyId, jobject assignmentBuffer, jint size) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return JNI_FALSE;
+        }
+        jint* assignment = (jint*) env->GetDirectBufferAddress(assignmentBuffer);
+        if (assignment == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return JNI_FALSE;
+        }
+        return jmeSoftBodyClusters::setAssignment(body, assignment, size) ? JNI_TRUE : JNI_FALSE;
+    }
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
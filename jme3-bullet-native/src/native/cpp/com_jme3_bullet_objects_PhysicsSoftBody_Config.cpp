@@ -35,6 +35,7 @@
  */
 #include "com_jme3_bullet_objects_PhysicsSoftBody_Config.h"
 #include "jmeBulletUtil.h"
+#include "jmeSoftBodyExt.h"
 #include "BulletSoftBody/btSoftBody.h"
 #include "BulletSoftBody/btSoftBodyHelpers.h"
 
@@ -93,6 +94,16 @@ extern "C" {
 
         body->m_cfg.collisions = other->m_cfg.collisions; // Collisions flags
 
+        jmeSoftBodyExt* otherExt = jmeSoftBodyExt::find(other);
+        if (otherExt != NULL && otherExt->selfCollision != NULL) {
+            jmeSoftBodyExt* ext = jmeSoftBodyExt::get(body);
+            if (ext->selfCollision == NULL) {
+                ext->selfCollision = new jmeSoftBodySelfCollision(body);
+            }
+            ext->selfCollision->thickness = otherExt->selfCollision->thickness;
+            ext->selfCollision->budget = otherExt->selfCollision->budget;
+        }
+
     }
 
     /*
@@ -899,6 +910,88 @@ extern "C" {
         return body->m_cfg.collisions;
     }
 
+    static jmeSoftBodySelfCollision* getSelfCollision(btSoftBody* body) {
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::get(body);
+        if (ext->selfCollision == NULL) {
+            ext->selfCollision = new jmeSoftBodySelfCollision(body);
+        }
+        return ext->selfCollision;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody_Config
+     * Method:    setSelfCollisionThickness
+     * Signature: (JF)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_setSelfCollisionThickness
+    (JNIEnv *env, jobject object, jlong bodyId, jfloat thickness) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        getSelfCollision(body)->thickness = thickness;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody_Config
+     * Method:    getSelfCollisionThickness
+     * Signature: (J)F
+     */
+    JNIEXPORT jfloat JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_getSelfCollisionThickness
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        // no self collision state is created for a read
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext == NULL || ext->selfCollision == NULL) {
+            return JME_VF_SELF_THICKNESS;
+        }
+        return ext->selfCollision->thickness;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody_Config
+     * Method:    setSelfCollisionBudget
+     * Signature: (JI)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_setSelfCollisionBudget
+    (JNIEnv *env, jobject object, jlong bodyId, jint budget) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        getSelfCollision(body)->budget = budget;
+    }
+
+    /*
+     * Class:     com_jme3_bullet_objects_PhysicsSoftBody_Config
+     * Method:    getSelfCollisionBudget
+     * Signature: (J)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_getSelfCollisionBudget
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        // no self collision state is created for a read
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext == NULL || ext->selfCollision == NULL) {
+            return JME_VF_SELF_BUDGET;
+        }
+        return ext->selfCollision->budget;
+    }
+
 #ifdef __cplusplus
 }
 #endif
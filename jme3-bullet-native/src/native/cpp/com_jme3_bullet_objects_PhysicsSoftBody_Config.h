@@ -431,6 +431,38 @@ JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_
 JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_getCollisionsFlags
   (JNIEnv *, jobject, jlong);
 
+/*
+ * Class:     com_jme3_bullet_objects_PhysicsSoftBody_Config
+ * Method:    setSelfCollisionThickness
+ * Signature: (JF)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_setSelfCollisionThickness
+  (JNIEnv *, jobject, jlong, jfloat);
+
+/*
+ * Class:     com_jme3_bullet_objects_PhysicsSoftBody_Config
+ * Method:    getSelfCollisionThickness
+ * Signature: (J)F
+ */
+JNIEXPORT jfloat JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_getSelfCollisionThickness
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_jme3_bullet_objects_PhysicsSoftBody_Config
+ * Method:    setSelfCollisionBudget
+ * Signature: (JI)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_setSelfCollisionBudget
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     com_jme3_bullet_objects_PhysicsSoftBody_Config
+ * Method:    getSelfCollisionBudget
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_objects_PhysicsSoftBody_00024Config_getSelfCollisionBudget
+  (JNIEnv *, jobject, jlong);
+
 #ifdef __cplusplus
 }
 #endif
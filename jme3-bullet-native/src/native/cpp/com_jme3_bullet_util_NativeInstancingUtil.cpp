@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Author: Dokthar
+ */
+#include "com_jme3_bullet_util_NativeInstancingUtil.h"
+#include "jmeBulletUtil.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /*
+     * Class:     com_jme3_bullet_util_NativeInstancingUtil
+     * Method:    writeInstances
+     * Signature: ([JILcom/jme3/math/Vector3f;Ljava/nio/FloatBuffer;)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_util_NativeInstancingUtil_writeInstances
+    (JNIEnv *env, jclass clazz, jlongArray objectIds, jint count, jobject scaleVector, jobject storeBuffer) {
+        jmeClasses::initJavaClasses(env);
+        jfloat* store = (jfloat*) env->GetDirectBufferAddress(storeBuffer);
+        if (store == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffer must be direct.");
+            return;
+        }
+        if (env->GetDirectBufferCapacity(storeBuffer) < (jlong) count * 16) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffer is too small for the instances.");
+            return;
+        }
+        btVector3 scale(1, 1, 1);
+        if (scaleVector != NULL) {
+            jmeBulletUtil::convert(env, scaleVector, &scale);
+        }
+        jlong* ids = env->GetLongArrayElements(objectIds, NULL);
+        for (int i = 0; i < count; i++) {
+            jfloat* instance = store + i * 16;
+            btRigidBody* body = reinterpret_cast<btRigidBody*> (ids[i]);
+            if (body == NULL) {
+                // a null matrix, the instance is not visible
+                for (int j = 0; j < 16; j++) {
+                    instance[j] = 0;
+                }
+                continue;
+            }
+            // the interpolated transform, as used for the spatials
+            btTransform transform;
+            if (body->getMotionState() != NULL) {
+                body->getMotionState()->getWorldTransform(transform);
+            } else {
+                transform = body->getWorldTransform();
+            }
+            const btMatrix3x3& basis = transform.getBasis();
+            // the inverse rotation, as encoded by InstancedGeometry
+            btQuaternion inverseRotation = transform.getRotation().inverse();
+            // column major 4x3 matrix, the w of each column is the quaternion
+            for (int column = 0; column < 3; column++) {
+                instance[column * 4 + 0] = basis[0][column] * scale[column];
+                instance[column * 4 + 1] = basis[1][column] * scale[column];
+                instance[column * 4 + 2] = basis[2][column] * scale[column];
+            }
+            instance[3] = inverseRotation.x();
+            instance[7] = inverseRotation.y();
+            instance[11] = inverseRotation.z();
+            instance[12] = transform.getOrigin().x();
+            instance[13] = transform.getOrigin().y();
+            instance[14] = transform.getOrigin().z();
+            instance[15] = inverseRotation.w();
+        }
+        env->ReleaseLongArrayElements(objectIds, ids, JNI_ABORT);
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,21 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_jme3_bullet_util_NativeInstancingUtil */
+
+#ifndef _Included_com_jme3_bullet_util_NativeInstancingUtil
+#define _Included_com_jme3_bullet_util_NativeInstancingUtil
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     com_jme3_bullet_util_NativeInstancingUtil
+ * Method:    writeInstances
+ * Signature: ([JILcom/jme3/math/Vector3f;Ljava/nio/FloatBuffer;)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_util_NativeInstancingUtil_writeInstances
+  (JNIEnv *, jclass, jlongArray, jint, jobject, jobject);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -36,6 +36,7 @@
 #include "com_jme3_bullet_util_NativeSoftBodyUtil.h"
 #include "jmeBulletUtil.h"
 #include "BulletSoftBody/btSoftBody.h"
+#include "jmeSoftBodyMeshTopology.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -126,6 +127,53 @@ extern "C" {
         }
     }
 
+    /*
+     * Class:     com_jme3_bullet_util_NativeSoftBodyUtil
+     * Method:    updateMeshWithTopology
+     * Signature: (JJLjava/nio/FloatBuffer;Ljava/nio/FloatBuffer;Ljava/nio/FloatBuffer;Z)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_util_NativeSoftBodyUtil_updateMeshWithTopology
+    (JNIEnv *env, jclass clazz, jlong bodyId, jlong topologyId, jobject positionsBuffer, jobject normalsBuffer, jobject tangentsBuffer, jboolean meshInLocalSpace) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeSoftBodyMeshTopology* topology = reinterpret_cast<jmeSoftBodyMeshTopology*> (topologyId);
+        if (topology == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The topology does not exist.");
+            return;
+        }
+        jfloat* positions = (jfloat*) env->GetDirectBufferAddress(positionsBuffer);
+        jfloat* normals = normalsBuffer != NULL ? (jfloat*) env->GetDirectBufferAddress(normalsBuffer) : NULL;
+        jfloat* tangents = tangentsBuffer != NULL ? (jfloat*) env->GetDirectBufferAddress(tangentsBuffer) : NULL;
+        if (positions == NULL || (normalsBuffer != NULL && normals == NULL) || (tangentsBuffer != NULL && tangents == NULL)) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return;
+        }
+        // a mesh or a body which doesn't match the topology would be written out of bounds
+        const jlong vertexCount = topology->getVertexCount();
+        if (env->GetDirectBufferCapacity(positionsBuffer) < vertexCount * 3
+                || (normals != NULL && env->GetDirectBufferCapacity(normalsBuffer) < vertexCount * 3)
+                || (tangents != NULL && env->GetDirectBufferCapacity(tangentsBuffer) < vertexCount * 4)) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers are too small for the topology.");
+            return;
+        }
+        if (topology->getMaxNodeIndex() >= body->m_nodes.size()) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The topology doesn't match the nodes of the softbody.");
+            return;
+        }
+
+        const btVector3 center = (meshInLocalSpace ? (body->m_bounds[0] + body->m_bounds[1]) / 2 : btVector3(0, 0, 0));
+
+        topology->update(body, center, positions, normals, tangents);
+    }
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Author: Dokthar
+ */
+#include "com_jme3_bullet_util_SoftBodyMeshTopology.h"
+#include "jmeBulletUtil.h"
+#include "jmeSoftBodyMeshTopology.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /*
+     * Class:     com_jme3_bullet_util_SoftBodyMeshTopology
+     * Method:    createTopology
+     * Signature: (Ljava/nio/IntBuffer;Ljava/nio/IntBuffer;Ljava/nio/FloatBuffer;I)J
+     */
+    JNIEXPORT jlong JNICALL Java_com_jme3_bullet_util_SoftBodyMeshTopology_createTopology
+    (JNIEnv *env, jobject object, jobject indexBuffer, jobject indexMap, jobject texCoordBuffer, jint vertexCount) {
+        jmeClasses::initJavaClasses(env);
+        const jint* indexes = (jint*) env->GetDirectBufferAddress(indexBuffer);
+        const int indexCount = env->GetDirectBufferCapacity(indexBuffer);
+        const jint* jme2bulletMap = indexMap != NULL ? (jint*) env->GetDirectBufferAddress(indexMap) : NULL;
+        const jfloat* texCoords = texCoordBuffer != NULL ? (jfloat*) env->GetDirectBufferAddress(texCoordBuffer) : NULL;
+
+        jmeSoftBodyMeshTopology* topology = new jmeSoftBodyMeshTopology(indexes, indexCount, jme2bulletMap, texCoords, vertexCount);
+        return reinterpret_cast<jlong> (topology);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_util_SoftBodyMeshTopology
+     * Method:    finalizeNative
+     * Signature: (J)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyMeshTopology_finalizeNative
+    (JNIEnv *env, jobject object, jlong topologyId) {
+        jmeSoftBodyMeshTopology* topology = reinterpret_cast<jmeSoftBodyMeshTopology*> (topologyId);
+        if (topology == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        delete(topology);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_util_SoftBodyMeshTopology
+     * Method:    applyTearing
+     * Signature: (JLjava/nio/IntBuffer;ILjava/nio/IntBuffer;I)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyMeshTopology_applyTearing
+    (JNIEnv *env, jobject object, jlong topologyId, jobject vertexDeltaBuffer, jint vertexDeltaCount, jobject triangleDeltaBuffer, jint triangleDeltaCount) {
+        jmeSoftBodyMeshTopology* topology = reinterpret_cast<jmeSoftBodyMeshTopology*> (topologyId);
+        if (topology == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        const jint* vertexDeltas = (jint*) env->GetDirectBufferAddress(vertexDeltaBuffer);
+        const jint* triangleDeltas = (jint*) env->GetDirectBufferAddress(triangleDeltaBuffer);
+        if (vertexDeltas == NULL || triangleDeltas == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return;
+        }
+        topology->applyTearing(vertexDeltas, vertexDeltaCount, triangleDeltas, triangleDeltaCount);
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,37 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_jme3_bullet_util_SoftBodyMeshTopology */
+
+#ifndef _Included_com_jme3_bullet_util_SoftBodyMeshTopology
+#define _Included_com_jme3_bullet_util_SoftBodyMeshTopology
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     com_jme3_bullet_util_SoftBodyMeshTopology
+ * Method:    createTopology
+ * Signature: (Ljava/nio/IntBuffer;Ljava/nio/IntBuffer;Ljava/nio/FloatBuffer;I)J
+ */
+JNIEXPORT jlong JNICALL Java_com_jme3_bullet_util_SoftBodyMeshTopology_createTopology
+  (JNIEnv *, jobject, jobject, jobject, jobject, jint);
+
+/*
+ * Class:     com_jme3_bullet_util_SoftBodyMeshTopology
+ * Method:    finalizeNative
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyMeshTopology_finalizeNative
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_jme3_bullet_util_SoftBodyMeshTopology
+ * Method:    applyTearing
+ * Signature: (JLjava/nio/IntBuffer;ILjava/nio/IntBuffer;I)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyMeshTopology_applyTearing
+  (JNIEnv *, jobject, jlong, jobject, jint, jobject, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Author: Dokthar
+ */
+#include "com_jme3_bullet_util_SoftBodyTearing.h"
+#include "jmeBulletUtil.h"
+#include "jmeSoftBodyExt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /*
+     * Class:     com_jme3_bullet_util_SoftBodyTearing
+     * Method:    createTearing
+     * Signature: (JLjava/nio/IntBuffer;ILjava/nio/IntBuffer;II)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_createTearing
+    (JNIEnv *env, jobject object, jlong bodyId, jobject indexBuffer, jint primitiveSize, jobject indexMap, jint vertexCount, jint maxVertexCount) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        const jint* indexes = (jint*) env->GetDirectBufferAddress(indexBuffer);
+        const jint* jme2bulletMap = (jint*) env->GetDirectBufferAddress(indexMap);
+        if (indexes == NULL || jme2bulletMap == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return;
+        }
+        const int indexCount = env->GetDirectBufferCapacity(indexBuffer);
+
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::get(body);
+        if (ext->tearing != NULL) {
+            delete(ext->tearing);
+        }
+        ext->tearing = new jmeSoftBodyTearing(body, indexes, indexCount, primitiveSize, jme2bulletMap, vertexCount, maxVertexCount);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_util_SoftBodyTearing
+     * Method:    setStrainThreshold
+     * Signature: (JF)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_setStrainThreshold
+    (JNIEnv *env, jobject object, jlong bodyId, jfloat threshold) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext != NULL && ext->tearing != NULL) {
+            ext->tearing->strainThreshold = threshold;
+        }
+    }
+
+    /*
+     * Class:     com_jme3_bullet_util_SoftBodyTearing
+     * Method:    setMaxTearsPerStep
+     * Signature: (JI)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_setMaxTearsPerStep
+    (JNIEnv *env, jobject object, jlong bodyId, jint maxTears) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext != NULL && ext->tearing != NULL) {
+            ext->tearing->maxTears = maxTears;
+        }
+    }
+
+    /*
+     * Class:     com_jme3_bullet_util_SoftBodyTearing
+     * Method:    removeTearing
+     * Signature: (J)V
+     */
+    JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_removeTearing
+    (JNIEnv *env, jobject object, jlong bodyId) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext != NULL && ext->tearing != NULL) {
+            delete(ext->tearing);
+            ext->tearing = NULL;
+        }
+    }
+
+    /*
+     * Class:     com_jme3_bullet_util_SoftBodyTearing
+     * Method:    getVertexDeltas
+     * Signature: (JLjava/nio/IntBuffer;)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_getVertexDeltas
+    (JNIEnv *env, jobject object, jlong bodyId, jobject storeBuffer) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        jint* store = (jint*) env->GetDirectBufferAddress(storeBuffer);
+        if (store == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return 0;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext == NULL || ext->tearing == NULL) {
+            return 0;
+        }
+        return ext->tearing->getVertexDeltas(store, env->GetDirectBufferCapacity(storeBuffer) / 3);
+    }
+
+    /*
+     * Class:     com_jme3_bullet_util_SoftBodyTearing
+     * Method:    getTriangleDeltas
+     * Signature: (JLjava/nio/IntBuffer;)I
+     */
+    JNIEXPORT jint JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_getTriangleDeltas
+    (JNIEnv *env, jobject object, jlong bodyId, jobject storeBuffer) {
+        btSoftBody* body = reinterpret_cast<btSoftBody*> (bodyId);
+        if (body == NULL) {
+            jclass newExc = env->FindClass("java/lang/NullPointerException");
+            env->ThrowNew(newExc, "The native object does not exist.");
+            return 0;
+        }
+        jint* store = (jint*) env->GetDirectBufferAddress(storeBuffer);
+        if (store == NULL) {
+            jclass newExc = env->FindClass("java/lang/IllegalArgumentException");
+            env->ThrowNew(newExc, "The buffers must be direct.");
+            return 0;
+        }
+        jmeSoftBodyExt* ext = jmeSoftBodyExt::find(body);
+        if (ext == NULL || ext->tearing == NULL) {
+            return 0;
+        }
+        return ext->tearing->getTriangleDeltas(store, env->GetDirectBufferCapacity(storeBuffer) / 4);
+    }
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,61 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_jme3_bullet_util_SoftBodyTearing */
+
+#ifndef _Included_com_jme3_bullet_util_SoftBodyTearing
+#define _Included_com_jme3_bullet_util_SoftBodyTearing
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+ * Class:     com_jme3_bullet_util_SoftBodyTearing
+ * Method:    createTearing
+ * Signature: (JLjava/nio/IntBuffer;ILjava/nio/IntBuffer;II)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_createTearing
+  (JNIEnv *, jobject, jlong, jobject, jint, jobject, jint, jint);
+
+/*
+ * Class:     com_jme3_bullet_util_SoftBodyTearing
+ * Method:    setStrainThreshold
+ * Signature: (JF)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_setStrainThreshold
+  (JNIEnv *, jobject, jlong, jfloat);
+
+/*
+ * Class:     com_jme3_bullet_util_SoftBodyTearing
+ * Method:    setMaxTearsPerStep
+ * Signature: (JI)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_setMaxTearsPerStep
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     com_jme3_bullet_util_SoftBodyTearing
+ * Method:    removeTearing
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_removeTearing
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_jme3_bullet_util_SoftBodyTearing
+ * Method:    getVertexDeltas
+ * Signature: (JLjava/nio/IntBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_getVertexDeltas
+  (JNIEnv *, jobject, jlong, jobject);
+
+/*
+ * Class:     com_jme3_bullet_util_SoftBodyTearing
+ * Method:    getTriangleDeltas
+ * Signature: (JLjava/nio/IntBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_com_jme3_bullet_util_SoftBodyTearing_getTriangleDeltas
+  (JNIEnv *, jobject, jlong, jobject);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
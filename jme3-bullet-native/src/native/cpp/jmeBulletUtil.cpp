@@ -31,6 +31,7 @@
  */
 #include <math.h>
 #include "jmeBulletUtil.h"
+#include "jmeTriangleMaterials.h"
 
 /**
  * Author: Normen Hansen,Empire Phoenix, Lutherion
@@ -338,7 +339,7 @@ void jmeBulletUtil::convertQuat(JNIEnv* env, const btMatrix3x3* in, jobject out)
     }
 }
 
-void jmeBulletUtil::addResult(JNIEnv* env, jobject resultlist, btVector3* hitnormal, btVector3* m_hitPointWorld, btScalar m_hitFraction, const btCollisionObject* hitobject) {
+void jmeBulletUtil::addResult(JNIEnv* env, jobject resultlist, btVector3* hitnormal, btVector3* m_hitPointWorld, btScalar m_hitFraction, const btCollisionObject* hitobject, const btCollisionWorld::LocalShapeInfo* shapeInfo) {
 
     jobject singleresult = env->AllocObject(jmeClasses::PhysicsRay_Class);
     jobject hitnormalvec = env->AllocObject(jmeClasses::Vector3f);
@@ -350,6 +351,9 @@ void jmeBulletUtil::addResult(JNIEnv* env, jobject resultlist, btVector3* hitnor
     env->SetFloatField(singleresult, jmeClasses::PhysicsRay_hitfraction, m_hitFraction);
 
     env->SetObjectField(singleresult, jmeClasses::PhysicsRay_collisionObject, up1->javaCollisionObject);
+    env->SetIntField(singleresult, jmeClasses::PhysicsRay_partIndex, shapeInfo != NULL ? shapeInfo->m_shapePart : -1);
+    env->SetIntField(singleresult, jmeClasses::PhysicsRay_triangleIndex, shapeInfo != NULL ? shapeInfo->m_triangleIndex : -1);
+    env->SetIntField(singleresult, jmeClasses::PhysicsRay_material, jmeTriangleMaterials::get(hitobject->getCollisionShape(), shapeInfo));
     env->CallBooleanMethod(resultlist, jmeClasses::PhysicsRay_addmethod, singleresult);
     if (env->ExceptionCheck()) {
         env->Throw(env->ExceptionOccurred());
@@ -357,7 +361,7 @@ void jmeBulletUtil::addResult(JNIEnv* env, jobject resultlist, btVector3* hitnor
     }
 }
 
-void jmeBulletUtil::addSweepResult(JNIEnv* env, jobject resultlist, btVector3* hitnormal, btVector3* m_hitPointWorld, btScalar m_hitFraction, const btCollisionObject* hitobject) {
+void jmeBulletUtil::addSweepResult(JNIEnv* env, jobject resultlist, btVector3* hitnormal, btVector3* m_hitPointWorld, btScalar m_hitFraction, const btCollisionObject* hitobject, const btCollisionWorld::LocalShapeInfo* shapeInfo) {
 
     jobject singleresult = env->AllocObject(jmeClasses::PhysicsSweep_Class);
     jobject hitnormalvec = env->AllocObject(jmeClasses::Vector3f);
@@ -369,6 +373,9 @@ void jmeBulletUtil::addSweepResult(JNIEnv* env, jobject resultlist, btVector3* h
     env->SetFloatField(singleresult, jmeClasses::PhysicsSweep_hitfraction, m_hitFraction);
 
     env->SetObjectField(singleresult, jmeClasses::PhysicsSweep_collisionObject, up1->javaCollisionObject);
+    env->SetIntField(singleresult, jmeClasses::PhysicsSweep_partIndex, shapeInfo != NULL ? shapeInfo->m_shapePart : -1);
+    env->SetIntField(singleresult, jmeClasses::PhysicsSweep_triangleIndex, shapeInfo != NULL ? shapeInfo->m_triangleIndex : -1);
+    env->SetIntField(singleresult, jmeClasses::PhysicsSweep_material, jmeTriangleMaterials::get(hitobject->getCollisionShape(), shapeInfo));
     env->CallBooleanMethod(resultlist, jmeClasses::PhysicsSweep_addmethod, singleresult);
     if (env->ExceptionCheck()) {
         env->Throw(env->ExceptionOccurred());
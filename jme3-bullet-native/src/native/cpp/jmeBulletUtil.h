@@ -48,8 +48,8 @@ public:
     static void convertQuat(JNIEnv* env, const btMatrix3x3* in, jobject out);
     static void convert(JNIEnv* env, jobject in, btTransform* out);
     static void convert(JNIEnv* env, const btTransform* in, jobject out);
-    static void addResult(JNIEnv* env, jobject resultlist, btVector3* hitnormal, btVector3* m_hitPointWorld,const btScalar  m_hitFraction,const btCollisionObject* hitobject);
-    static void addSweepResult(JNIEnv* env, jobject resultlist, btVector3* hitnormal, btVector3* m_hitPointWorld, const btScalar  m_hitFraction, const btCollisionObject* hitobject);
+    static void addResult(JNIEnv* env, jobject resultlist, btVector3* hitnormal, btVector3* m_hitPointWorld,const btScalar  m_hitFraction,const btCollisionObject* hitobject, const btCollisionWorld::LocalShapeInfo* shapeInfo);
+    static void addSweepResult(JNIEnv* env, jobject resultlist, btVector3* hitnormal, btVector3* m_hitPointWorld, const btScalar  m_hitFraction, const btCollisionObject* hitobject, const btCollisionWorld::LocalShapeInfo* shapeInfo);
 private:
     jmeBulletUtil(){};
     ~jmeBulletUtil(){};
@@ -61,5 +61,10 @@ public:
     jobject javaCollisionObject;
     jint group;
     jint groups;
+    jint material;
+    jint simulationTier;
+    jint skippedTicks;
+    void *frozen;
+    void *exactOverlaps;
     void *space;
 };
\ No newline at end of file
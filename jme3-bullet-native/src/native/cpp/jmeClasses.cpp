@@ -88,6 +88,9 @@ jmethodID jmeClasses::PhysicsRay_newSingleResult;
 jfieldID jmeClasses::PhysicsRay_normalInWorldSpace;
 jfieldID jmeClasses::PhysicsRay_hitfraction;
 jfieldID jmeClasses::PhysicsRay_collisionObject;
+jfieldID jmeClasses::PhysicsRay_partIndex;
+jfieldID jmeClasses::PhysicsRay_triangleIndex;
+jfieldID jmeClasses::PhysicsRay_material;
 
 jclass jmeClasses::PhysicsRay_listresult;
 jmethodID jmeClasses::PhysicsRay_addmethod;
@@ -98,6 +101,9 @@ jmethodID jmeClasses::PhysicsSweep_newSingleResult;
 jfieldID jmeClasses::PhysicsSweep_normalInWorldSpace;
 jfieldID jmeClasses::PhysicsSweep_hitfraction;
 jfieldID jmeClasses::PhysicsSweep_collisionObject;
+jfieldID jmeClasses::PhysicsSweep_partIndex;
+jfieldID jmeClasses::PhysicsSweep_triangleIndex;
+jfieldID jmeClasses::PhysicsSweep_material;
 
 jclass jmeClasses::PhysicsSweep_listresult;
 jmethodID jmeClasses::PhysicsSweep_addmethod;
@@ -245,6 +251,24 @@ void jmeClasses::initJavaClasses(JNIEnv* env) {
         return;
     }
 
+    PhysicsRay_partIndex = env->GetFieldID(PhysicsRay_Class,"partIndex","I");
+    if (env->ExceptionCheck()) {
+        env->Throw(env->ExceptionOccurred());
+        return;
+    }
+
+    PhysicsRay_triangleIndex = env->GetFieldID(PhysicsRay_Class,"triangleIndex","I");
+    if (env->ExceptionCheck()) {
+        env->Throw(env->ExceptionOccurred());
+        return;
+    }
+
+    PhysicsRay_material = env->GetFieldID(PhysicsRay_Class,"material","I");
+    if (env->ExceptionCheck()) {
+        env->Throw(env->ExceptionOccurred());
+        return;
+    }
+
     PhysicsRay_listresult = env->FindClass("java/util/List");
     PhysicsRay_listresult = (jclass)env->NewGlobalRef(PhysicsRay_listresult);
     if (env->ExceptionCheck()) {
@@ -290,6 +314,24 @@ void jmeClasses::initJavaClasses(JNIEnv* env) {
 		return;
 	}
 
+	PhysicsSweep_partIndex = env->GetFieldID(PhysicsSweep_Class, "partIndex", "I");
+	if (env->ExceptionCheck()) {
+		env->Throw(env->ExceptionOccurred());
+		return;
+	}
+
+	PhysicsSweep_triangleIndex = env->GetFieldID(PhysicsSweep_Class, "triangleIndex", "I");
+	if (env->ExceptionCheck()) {
+		env->Throw(env->ExceptionOccurred());
+		return;
+	}
+
+	PhysicsSweep_material = env->GetFieldID(PhysicsSweep_Class, "material", "I");
+	if (env->ExceptionCheck()) {
+		env->Throw(env->ExceptionOccurred());
+		return;
+	}
+
 	PhysicsSweep_listresult = env->FindClass("java/util/List");
 	PhysicsSweep_listresult = (jclass)env->NewGlobalRef(PhysicsSweep_listresult);
 	if (env->ExceptionCheck()) {
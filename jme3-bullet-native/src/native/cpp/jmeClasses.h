@@ -87,6 +87,9 @@ public:
     static jfieldID PhysicsRay_normalInWorldSpace;
     static jfieldID PhysicsRay_hitfraction;
     static jfieldID PhysicsRay_collisionObject;
+    static jfieldID PhysicsRay_partIndex;
+    static jfieldID PhysicsRay_triangleIndex;
+    static jfieldID PhysicsRay_material;
     static jclass PhysicsRay_listresult;
     static jmethodID PhysicsRay_addmethod;
 
@@ -95,6 +98,9 @@ public:
 	static jfieldID PhysicsSweep_normalInWorldSpace;
 	static jfieldID PhysicsSweep_hitfraction;
 	static jfieldID PhysicsSweep_collisionObject;
+	static jfieldID PhysicsSweep_partIndex;
+	static jfieldID PhysicsSweep_triangleIndex;
+	static jfieldID PhysicsSweep_material;
 	static jclass PhysicsSweep_listresult;
 	static jmethodID PhysicsSweep_addmethod;
 
@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeCollisionAlgorithms.h"
+#include "jmeHeightfieldTerrainShape.h"
+#include "BulletCollision/CollisionDispatch/btCollisionObjectWrapper.h"
+
+/**
+ * Author: dokthar
+ */
+jmeSphereCapsuleConcaveAlgorithm::jmeSphereCapsuleConcaveAlgorithm(const btCollisionAlgorithmConstructionInfo& ci, const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap, bool isSwapped)
+: btConvexConcaveCollisionAlgorithm(ci, body0Wrap, body1Wrap, isSwapped), manifold(NULL), swapped(isSwapped) {
+    // the manifold is owned by the base algorithm
+    btManifoldArray manifolds;
+    getAllContactManifolds(manifolds);
+    if (manifolds.size() > 0) {
+        manifold = manifolds[0];
+    }
+}
+
+// closest point of the triangle abc to p, interior is true when it is inside
+// the face (not on an edge or a vertex)
+
+static btVector3 closestPointOnTriangle(const btVector3& p, const btVector3& a, const btVector3& b, const btVector3& c, bool& interior) {
+    interior = false;
+    const btVector3 ab = b - a;
+    const btVector3 ac = c - a;
+    const btVector3 ap = p - a;
+    const btScalar d1 = ab.dot(ap);
+    const btScalar d2 = ac.dot(ap);
+    if (d1 <= 0 && d2 <= 0) {
+        return a;
+    }
+    const btVector3 bp = p - b;
+    const btScalar d3 = ab.dot(bp);
+    const btScalar d4 = ac.dot(bp);
+    if (d3 >= 0 && d4 <= d3) {
+        return b;
+    }
+    const btScalar vc = d1 * d4 - d3 * d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+    const btVector3 cp = p - c;
+    const btScalar d5 = ab.dot(cp);
+    const btScalar d6 = ac.dot(cp);
+    if (d6 >= 0 && d5 <= d6) {
+        return c;
+    }
+    const btScalar vb = d5 * d2 - d1 * d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+    const btScalar va = d3 * d6 - d5 * d4;
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+    interior = true;
+    const btScalar denom = 1 / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+}
+
+// closest points of the segments p1q1 and p2q2, s and t are the parameters
+// of the points on each segment
+
+static void closestPointsSegments(const btVector3& p1, const btVector3& q1, const btVector3& p2, const btVector3& q2, btScalar& s, btScalar& t) {
+    const btVector3 d1 = q1 - p1;
+    const btVector3 d2 = q2 - p2;
+    const btVector3 r = p1 - p2;
+    const btScalar a = d1.dot(d1);
+    const btScalar e = d2.dot(d2);
+    const btScalar f = d2.dot(r);
+    if (a <= SIMD_EPSILON && e <= SIMD_EPSILON) {
+        s = t = 0;
+        return;
+    }
+    if (a <= SIMD_EPSILON) {
+        s = 0;
+        t = btMin(btMax(f / e, btScalar(0)), btScalar(1));
+        return;
+    }
+    const btScalar c = d1.dot(r);
+    if (e <= SIMD_EPSILON) {
+        t = 0;
+        s = btMin(btMax(-c / a, btScalar(0)), btScalar(1));
+        return;
+    }
+    const btScalar b = d1.dot(d2);
+    const btScalar denom = a * e - b * b;
+    s = denom != 0 ? btMin(btMax((b * f - c * e) / denom, btScalar(0)), btScalar(1)) : 0;
+    t = (b * s + f) / e;
+    if (t < 0) {
+        t = 0;
+        s = btMin(btMax(-c / a, btScalar(0)), btScalar(1));
+    } else if (t > 1) {
+        t = 1;
+        s = btMin(btMax((b - c) / a, btScalar(0)), btScalar(1));
+    }
+}
+
+// triangles of the concave shape against the segment p0p1 (a sphere when
+// p0 == p1) of the given radius, in the concave shape space
+
+struct jmeSegmentTriangleCallback : public btTriangleCallback {
+    btVector3 p0;
+    btVector3 p1;
+    btScalar radius;
+    btScalar threshold;
+    btVector3 aabbMin;
+    btVector3 aabbMax;
+    bool sphere;
+    btTransform concaveTransform;
+    const btCollisionObject* concaveObject;
+    btManifoldResult* resultOut;
+
+    void addContact(const btVector3& normal, const btVector3& pointOnTriangle, btScalar distance, int partId, int triangleIndex) {
+        if (distance - radius > threshold) {
+            return;
+        }
+        // the manifold bodies are (convex, concave) : point on the concave
+        // shape and normal pointing to the convex shape
+        if (resultOut->getBody0Internal() == concaveObject) {
+            resultOut->setShapeIdentifiersA(partId, triangleIndex);
+        } else {
+            resultOut->setShapeIdentifiersB(partId, triangleIndex);
+        }
+        resultOut->addContactPoint(concaveTransform.getBasis() * normal, concaveTransform * pointOnTriangle, distance - radius);
+    }
+
+    void pointContact(const btVector3& p, const btVector3* t, const btVector3& faceNormal, const btVector3& side, int partId, int triangleIndex) {
+        bool interior;
+        const btVector3 q = closestPointOnTriangle(p, t[0], t[1], t[2], interior);
+        if (interior) {
+            // face contact, the normal is on the side of the convex shape so
+            // a penetrating shape is pushed back
+            const btVector3 normal = faceNormal.dot(side - t[0]) >= 0 ? faceNormal : -faceNormal;
+            const btScalar distance = (p - t[0]).dot(normal);
+            addContact(normal, p - normal * distance, distance, partId, triangleIndex);
+        } else {
+            const btVector3 v = p - q;
+            const btScalar distance = v.length();
+            if (distance > SIMD_EPSILON) {
+                addContact(v / distance, q, distance, partId, triangleIndex);
+            }
+        }
+    }
+
+    virtual void processTriangle(btVector3* t, int partId, int triangleIndex) {
+        // batch culling : bounding box of the triangle
+        btVector3 min = t[0];
+        btVector3 max = t[0];
+        min.setMin(t[1]);
+        max.setMax(t[1]);
+        min.setMin(t[2]);
+        max.setMax(t[2]);
+        if (!TestAabbAgainstAabb2(min, max, aabbMin, aabbMax)) {
+            return;
+        }
+        btVector3 faceNormal = (t[1] - t[0]).cross(t[2] - t[0]);
+        const btScalar area = faceNormal.length();
+        if (area <= SIMD_EPSILON) {
+            return;
+        }
+        faceNormal /= area;
+
+        const btVector3 center = (p0 + p1) * btScalar(0.5);
+        if (sphere) {
+            pointContact(p0, t, faceNormal, center, partId, triangleIndex);
+            return;
+        }
+        pointContact(p0, t, faceNormal, center, partId, triangleIndex);
+        pointContact(p1, t, faceNormal, center, partId, triangleIndex);
+        // segment versus the edges, when the closest point is inside the
+        // segment (the ends are done above)
+        for (int i = 0; i < 3; ++i) {
+            const btVector3& e0 = t[i];
+            const btVector3& e1 = t[(i + 1) % 3];
+            btScalar s, u;
+            closestPointsSegments(p0, p1, e0, e1, s, u);
+            if (s <= 0 || s >= 1) {
+                continue;
+            }
+            const btVector3 ps = p0 + (p1 - p0) * s;
+            const btVector3 pe = e0 + (e1 - e0) * u;
+            const btVector3 v = ps - pe;
+            const btScalar distance = v.length();
+            if (distance > SIMD_EPSILON) {
+                addContact(v / distance, pe, distance, partId, triangleIndex);
+            }
+        }
+    }
+};
+
+void jmeSphereCapsuleConcaveAlgorithm::processCollision(const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap, const btDispatcherInfo& dispatchInfo, btManifoldResult* resultOut) {
+    if (manifold == NULL) {
+        return;
+    }
+    const btCollisionObjectWrapper* convexWrap = swapped ? body1Wrap : body0Wrap;
+    const btCollisionObjectWrapper* concaveWrap = swapped ? body0Wrap : body1Wrap;
+    const btConcaveShape* concave = static_cast<const btConcaveShape*> (concaveWrap->getCollisionShape());
+    const btCollisionShape* convex = convexWrap->getCollisionShape();
+
+    resultOut->setPersistentManifold(manifold);
+    manifold->setBodies(convexWrap->getCollisionObject(), concaveWrap->getCollisionObject());
+
+    jmeSegmentTriangleCallback callback;
+    callback.concaveTransform = concaveWrap->getWorldTransform();
+    callback.concaveObject = concaveWrap->getCollisionObject();
+    callback.resultOut = resultOut;
+    callback.threshold = manifold->getContactBreakingThreshold();
+    const btTransform convexToConcave = callback.concaveTransform.inverse() * convexWrap->getWorldTransform();
+    if (convex->getShapeType() == SPHERE_SHAPE_PROXYTYPE) {
+        const btSphereShape* sphere = static_cast<const btSphereShape*> (convex);
+        callback.sphere = true;
+        callback.radius = sphere->getRadius();
+        callback.p0 = callback.p1 = convexToConcave.getOrigin();
+    } else {
+        const btCapsuleShape* capsule = static_cast<const btCapsuleShape*> (convex);
+        btVector3 axis(0, 0, 0);
+        axis[capsule->getUpAxis()] = capsule->getHalfHeight();
+        callback.sphere = false;
+        callback.radius = capsule->getRadius();
+        callback.p0 = convexToConcave * -axis;
+        callback.p1 = convexToConcave * axis;
+    }
+    // the triangles are inflated by the concave margin, like in the generic
+    // algorithm
+    callback.radius += concave->getMargin();
+
+    const btScalar extent = callback.radius + callback.threshold;
+    callback.aabbMin = callback.p0;
+    callback.aabbMax = callback.p0;
+    callback.aabbMin.setMin(callback.p1);
+    callback.aabbMax.setMax(callback.p1);
+    callback.aabbMin -= btVector3(extent, extent, extent);
+    callback.aabbMax += btVector3(extent, extent, extent);
+
+    // heightfield : nothing to do if the shape is above or below the heights
+    if (concave->getShapeType() != TERRAIN_SHAPE_PROXYTYPE
+            || static_cast<const jmeHeightfieldTerrainShape*> (concave)->overlapsHeights(callback.aabbMin, callback.aabbMax)) {
+        concave->processAllTriangles(&callback, callback.aabbMin, callback.aabbMax);
+    }
+    resultOut->refreshContactPoints();
+}
+
+void jmeSphereCapsuleConcaveAlgorithm::registerAlgorithms(btCollisionDispatcher* dispatcher) {
+    static CreateFunc createFunc;
+    static CreateFunc swappedCreateFunc;
+    swappedCreateFunc.m_swapped = true;
+    const int convexTypes[2] = {SPHERE_SHAPE_PROXYTYPE, CAPSULE_SHAPE_PROXYTYPE};
+    const int concaveTypes[2] = {TRIANGLE_MESH_SHAPE_PROXYTYPE, TERRAIN_SHAPE_PROXYTYPE};
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            dispatcher->registerCollisionCreateFunc(convexTypes[i], concaveTypes[j], &createFunc);
+            dispatcher->registerCollisionCreateFunc(concaveTypes[j], convexTypes[i], &swappedCreateFunc);
+        }
+    }
+}
+
+void jmeSphereCapsuleConcaveAlgorithm::unregisterAlgorithms(btCollisionDispatcher* dispatcher) {
+    btCollisionConfiguration* configuration = dispatcher->getCollisionConfiguration();
+    const int convexTypes[2] = {SPHERE_SHAPE_PROXYTYPE, CAPSULE_SHAPE_PROXYTYPE};
+    const int concaveTypes[2] = {TRIANGLE_MESH_SHAPE_PROXYTYPE, TERRAIN_SHAPE_PROXYTYPE};
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            dispatcher->registerCollisionCreateFunc(convexTypes[i], concaveTypes[j], configuration->getCollisionAlgorithmCreateFunc(convexTypes[i], concaveTypes[j]));
+            dispatcher->registerCollisionCreateFunc(concaveTypes[j], convexTypes[i], configuration->getCollisionAlgorithmCreateFunc(concaveTypes[j], convexTypes[i]));
+        }
+    }
+}
+
+int jmeSphereCapsuleConcaveAlgorithm::getMaxElementSize() {
+    return sizeof (jmeSphereCapsuleConcaveAlgorithm);
+}
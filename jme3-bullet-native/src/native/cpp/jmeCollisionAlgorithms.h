@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeCollisionAlgorithms
+#define _Included_jmeCollisionAlgorithms
+#include "btBulletCollisionCommon.h"
+#include "BulletCollision/CollisionDispatch/btConvexConcaveCollisionAlgorithm.h"
+
+/**
+ * Sphere and capsule versus triangle mesh and heightfield collision
+ * algorithm. The contacts are computed analytically (closest points between
+ * the sphere center or the capsule segment and each triangle) instead of a
+ * GJK/EPA run per triangle. The time of impact (ccd) is the one of bullet's
+ * convex versus concave algorithm.
+ *
+ * Author: dokthar
+ */
+class jmeSphereCapsuleConcaveAlgorithm : public btConvexConcaveCollisionAlgorithm {
+public:
+    jmeSphereCapsuleConcaveAlgorithm(const btCollisionAlgorithmConstructionInfo& ci, const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap, bool isSwapped);
+
+    virtual void processCollision(const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap, const btDispatcherInfo& dispatchInfo, btManifoldResult* resultOut);
+
+    struct CreateFunc : public btCollisionAlgorithmCreateFunc {
+
+        virtual btCollisionAlgorithm* CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo& ci, const btCollisionObjectWrapper* body0Wrap, const btCollisionObjectWrapper* body1Wrap) {
+            void* mem = ci.m_dispatcher1->allocateCollisionAlgorithm(sizeof (jmeSphereCapsuleConcaveAlgorithm));
+            return new(mem) jmeSphereCapsuleConcaveAlgorithm(ci, body0Wrap, body1Wrap, m_swapped);
+        }
+    };
+
+    // register the algorithm for sphere and capsule versus triangle mesh and
+    // heightfield, the collision configuration must have been created with
+    // m_customCollisionAlgorithmMaxElementSize >= getMaxElementSize()
+    static void registerAlgorithms(btCollisionDispatcher* dispatcher);
+    // restore the create functions of the dispatcher collision configuration
+    // for those pairs, to compare with bullet's convex versus concave one
+    static void unregisterAlgorithms(btCollisionDispatcher* dispatcher);
+    static int getMaxElementSize();
+
+private:
+    btPersistentManifold* manifold;
+    bool swapped;
+};
+#endif
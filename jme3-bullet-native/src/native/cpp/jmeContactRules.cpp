@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeContactRules.h"
+#include "jmeBulletUtil.h"
+#include "jmePhysicsSpace.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/**
+ * Author: dokthar
+ */
+jmeContactRules jmeContactRules::shared;
+
+// the lock of the shared table, java may edit it while a space is stepped on
+// another thread
+#ifdef _WIN32
+static SRWLOCK sharedLock = SRWLOCK_INIT;
+
+static void lockShared() {
+    AcquireSRWLockExclusive(&sharedLock);
+}
+
+static void unlockShared() {
+    ReleaseSRWLockExclusive(&sharedLock);
+}
+#else
+static pthread_mutex_t sharedLock = PTHREAD_MUTEX_INITIALIZER;
+
+static void lockShared() {
+    pthread_mutex_lock(&sharedLock);
+}
+
+static void unlockShared() {
+    pthread_mutex_unlock(&sharedLock);
+}
+#endif
+
+jmeContactRules::jmeContactRules() : surfaceVelocity(false), revision(0) {
+}
+
+int jmeContactRules::createMaterial() {
+    lockShared();
+    if (shared.materials.size() == 0) {
+        // the id 0 is no material
+        shared.materials.expand();
+        gContactAddedCallback = &jmeContactRules::contactAddedCallback;
+    }
+    jmeContactMaterial& material = shared.materials.expand();
+    material.frictionCombine = JME_COMBINE_DEFAULT;
+    material.restitutionCombine = JME_COMBINE_DEFAULT;
+    material.surfaceVelocity.setZero();
+    material.oneWayDirection.setValue(0, 1, 0);
+    material.oneWayCos = 0;
+    material.oneWay = false;
+    material.disabled = false;
+    const int id = shared.materials.size() - 1;
+    shared.revision++;
+    unlockShared();
+    return id;
+}
+
+bool jmeContactRules::readMaterial(int id, jmeContactMaterial& material) {
+    lockShared();
+    const jmeContactMaterial* found = shared.getMaterial(id);
+    if (found != NULL) {
+        material = *found;
+    }
+    unlockShared();
+    return found != NULL;
+}
+
+bool jmeContactRules::writeMaterial(int id, const jmeContactMaterial& material) {
+    lockShared();
+    const bool found = shared.getMaterial(id) != NULL;
+    if (found) {
+        shared.materials[id] = material;
+        // a space only clears the friction caching when no surface velocity
+        // is left
+        shared.surfaceVelocity = false;
+        for (int i = 1; i < shared.materials.size(); ++i) {
+            if (!shared.materials[i].surfaceVelocity.fuzzyZero()) {
+                shared.surfaceVelocity = true;
+                break;
+            }
+        }
+        shared.revision++;
+    }
+    unlockShared();
+    return found;
+}
+
+void jmeContactRules::setMaterial(btCollisionObject* object, int id) {
+    jmeUserPointer* userPointer = (jmeUserPointer*) object->getUserPointer();
+    if (userPointer == NULL) {
+        return;
+    }
+    lockShared();
+    const bool found = shared.getMaterial(id) != NULL;
+    unlockShared();
+    userPointer->material = found ? id : 0;
+    if (found) {
+        object->setCollisionFlags(object->getCollisionFlags() | btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK);
+    } else {
+        object->setCollisionFlags(object->getCollisionFlags() & ~btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK);
+    }
+}
+
+void jmeContactRules::setPairRule(int id0, int id1, bool disabled, btScalar friction, btScalar restitution) {
+    jmeContactPairRule rule;
+    rule.disabled = disabled;
+    rule.friction = friction;
+    rule.restitution = restitution;
+    lockShared();
+    shared.pairs.insert(jmeContactPairKey(id0, id1), rule);
+    shared.revision++;
+    unlockShared();
+}
+
+void jmeContactRules::removePairRule(int id0, int id1) {
+    lockShared();
+    shared.pairs.remove(jmeContactPairKey(id0, id1));
+    shared.revision++;
+    unlockShared();
+}
+
+void jmeContactRules::update(jmeContactRules& rules) {
+    lockShared();
+    if (rules.revision != shared.revision) {
+        rules.materials = shared.materials;
+        rules.pairs = shared.pairs;
+        rules.surfaceVelocity = shared.surfaceVelocity;
+        rules.revision = shared.revision;
+    }
+    unlockShared();
+}
+
+const jmeContactMaterial* jmeContactRules::getMaterial(int id) const {
+    if (id <= 0 || id >= materials.size()) {
+        return NULL;
+    }
+    return &materials[id];
+}
+
+const jmeContactMaterial* jmeContactRules::getMaterial(const btCollisionObject* object) const {
+    if (!(object->getCollisionFlags() & btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK)) {
+        return NULL;
+    }
+    const jmeUserPointer* userPointer = (const jmeUserPointer*) object->getUserPointer();
+    return userPointer != NULL ? getMaterial(userPointer->material) : NULL;
+}
+
+const jmeContactPairRule* jmeContactRules::getPairRule(int id0, int id1) const {
+    if (pairs.size() == 0) {
+        return NULL;
+    }
+    return pairs.find(jmeContactPairKey(id0, id1));
+}
+
+static btScalar combine(int mode, btScalar value0, btScalar value1, btScalar value) {
+    switch (mode) {
+        case JME_COMBINE_AVERAGE:
+            return (value0 + value1) * btScalar(0.5);
+        case JME_COMBINE_MIN:
+            return btMin(value0, value1);
+        case JME_COMBINE_MAX:
+            return btMax(value0, value1);
+        case JME_COMBINE_MULTIPLY:
+            return value0 * value1;
+        default:
+            return value;
+    }
+}
+
+// one way test of the material of object, normal is from object to the other
+static bool oneWayRejects(const jmeContactMaterial* material, const btCollisionObject* object, const btVector3& normal) {
+    if (material == NULL || !material->oneWay) {
+        return false;
+    }
+    const btVector3 direction = object->getWorldTransform().getBasis() * material->oneWayDirection;
+    return normal.dot(direction) < material->oneWayCos;
+}
+
+bool jmeContactRules::isDisabled(const btManifoldPoint& cp, const btCollisionObject* object0, const btCollisionObject* object1) const {
+    const jmeContactMaterial* material0 = getMaterial(object0);
+    const jmeContactMaterial* material1 = getMaterial(object1);
+    if (material0 == NULL && material1 == NULL) {
+        return false;
+    }
+    if ((material0 != NULL && material0->disabled) || (material1 != NULL && material1->disabled)) {
+        return true;
+    }
+    if (material0 != NULL && material1 != NULL) {
+        const jmeContactPairRule* rule = getPairRule(((const jmeUserPointer*) object0->getUserPointer())->material, ((const jmeUserPointer*) object1->getUserPointer())->material);
+        if (rule != NULL && rule->disabled) {
+            return true;
+        }
+    }
+    // the normal is on B, pointing to A
+    return oneWayRejects(material0, object0, -cp.m_normalWorldOnB) || oneWayRejects(material1, object1, cp.m_normalWorldOnB);
+}
+
+bool jmeContactRules::contactAddedCallback(btManifoldPoint& cp, const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0, const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1) {
+    const btCollisionObject* object0 = colObj0Wrap->getCollisionObject();
+    const btCollisionObject* object1 = colObj1Wrap->getCollisionObject();
+    // the rules of the space of the objects
+    const jmeUserPointer* userPointer = (const jmeUserPointer*) object0->getUserPointer();
+    if (userPointer == NULL || userPointer->space == NULL) {
+        userPointer = (const jmeUserPointer*) object1->getUserPointer();
+    }
+    if (userPointer == NULL || userPointer->space == NULL) {
+        return false;
+    }
+    ((jmePhysicsSpace*) userPointer->space)->getContactRules().contactAdded(cp, object0, object1);
+    return true;
+}
+
+void jmeContactRules::contactAdded(btManifoldPoint& cp, const btCollisionObject* object0, const btCollisionObject* object1) const {
+    const jmeContactMaterial* material0 = getMaterial(object0);
+    const jmeContactMaterial* material1 = getMaterial(object1);
+    if (material0 == NULL && material1 == NULL) {
+        return;
+    }
+
+    // combine modes, the highest mode of the two materials wins
+    const int frictionCombine = btMax(material0 != NULL ? material0->frictionCombine : 0, material1 != NULL ? material1->frictionCombine : 0);
+    const int restitutionCombine = btMax(material0 != NULL ? material0->restitutionCombine : 0, material1 != NULL ? material1->restitutionCombine : 0);
+    cp.m_combinedFriction = btMin(combine(frictionCombine, object0->getFriction(), object1->getFriction(), cp.m_combinedFriction), btScalar(10));
+    cp.m_combinedRestitution = combine(restitutionCombine, object0->getRestitution(), object1->getRestitution(), cp.m_combinedRestitution);
+    if (material0 != NULL && material1 != NULL) {
+        const jmeContactPairRule* rule = getPairRule(((const jmeUserPointer*) object0->getUserPointer())->material, ((const jmeUserPointer*) object1->getUserPointer())->material);
+        if (rule != NULL) {
+            if (rule->friction >= 0) {
+                cp.m_combinedFriction = rule->friction;
+            }
+            if (rule->restitution >= 0) {
+                cp.m_combinedRestitution = rule->restitution;
+            }
+        }
+    }
+
+    // surface velocity : the friction drives the relative velocity of the
+    // bodies (A - B) to the relative velocity of the surfaces (B - A)
+    btVector3 velocity(0, 0, 0);
+    if (material0 != NULL) {
+        velocity -= object0->getWorldTransform().getBasis() * material0->surfaceVelocity;
+    }
+    if (material1 != NULL) {
+        velocity += object1->getWorldTransform().getBasis() * material1->surfaceVelocity;
+    }
+    const btVector3& normal = cp.m_normalWorldOnB;
+    velocity -= normal * normal.dot(velocity);
+    const btScalar speed = velocity.length();
+    if (speed > SIMD_EPSILON) {
+        cp.m_lateralFrictionDir1 = velocity / speed;
+        cp.m_lateralFrictionDir2 = cp.m_lateralFrictionDir1.cross(normal);
+        cp.m_contactMotion1 = speed;
+        cp.m_contactMotion2 = 0;
+        cp.m_lateralFrictionInitialized = true;
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeContactRules
+#define _Included_jmeContactRules
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+#include "LinearMath/btHashMap.h"
+
+#define JME_COMBINE_DEFAULT 0
+#define JME_COMBINE_AVERAGE 1
+#define JME_COMBINE_MIN 2
+#define JME_COMBINE_MAX 3
+#define JME_COMBINE_MULTIPLY 4
+
+/**
+ * Contact rules of a material, the vectors are in the local space of the
+ * collision object using the material.
+ */
+struct jmeContactMaterial {
+    int frictionCombine;
+    int restitutionCombine;
+    btVector3 surfaceVelocity;
+    // contacts are kept only when the contact normal (from this object to
+    // the other) is within the one way angle of the direction
+    btVector3 oneWayDirection;
+    btScalar oneWayCos;
+    bool oneWay;
+    bool disabled;
+};
+
+/**
+ * Friction and restitution override for a pair of materials, a negative
+ * value keeps the combined value.
+ */
+struct jmeContactPairRule {
+    bool disabled;
+    btScalar friction;
+    btScalar restitution;
+};
+
+// the two material ids of a pair rule, the smallest first
+struct jmeContactPairKey {
+    int id0;
+    int id1;
+
+    jmeContactPairKey(int a, int b) : id0(btMin(a, b)), id1(btMax(a, b)) {
+    }
+
+    unsigned int getHash() const {
+        return ((unsigned int) id0 * 73856093u) ^ ((unsigned int) id1 * 19349663u);
+    }
+
+    bool equals(const jmeContactPairKey& other) const {
+        return id0 == other.id0 && id1 == other.id1;
+    }
+};
+
+/**
+ * Table of the contact materials and of the pair rules, applied natively when
+ * the contacts are added (gContactAddedCallback) so no java code runs per
+ * contact. A collision object uses the rules when its user pointer has a
+ * material and the CF_CUSTOM_MATERIAL_CALLBACK flag.
+ *
+ * The materials are edited from java in a shared table guarded by a lock,
+ * each physics space copies it before its ticks when it changed, so the
+ * contact callbacks read the rules of their space without locking.
+ *
+ * Author: dokthar
+ */
+class jmeContactRules {
+public:
+    jmeContactRules();
+
+    // create a new material, its id is > 0
+    static int createMaterial();
+    // copy the material of the given id, false if there is none
+    static bool readMaterial(int id, jmeContactMaterial& material);
+    static bool writeMaterial(int id, const jmeContactMaterial& material);
+    static void setMaterial(btCollisionObject* object, int id);
+
+    static void setPairRule(int id0, int id1, bool disabled, btScalar friction, btScalar restitution);
+    static void removePairRule(int id0, int id1);
+
+    // copy the shared table in the rules of a space if it changed since
+    static void update(jmeContactRules& rules);
+
+    // true when the point must not be solved, used by the contact processed
+    // callback once the points of a manifold have been refreshed
+    bool isDisabled(const btManifoldPoint& cp, const btCollisionObject* object0, const btCollisionObject* object1) const;
+
+    // the solver needs the friction direction caching for surface velocities
+    bool useSurfaceVelocity() const {
+        return surfaceVelocity;
+    }
+
+    static bool contactAddedCallback(btManifoldPoint& cp, const btCollisionObjectWrapper* colObj0Wrap, int partId0, int index0, const btCollisionObjectWrapper* colObj1Wrap, int partId1, int index1);
+
+private:
+    btAlignedObjectArray<jmeContactMaterial> materials;
+    btHashMap<jmeContactPairKey, jmeContactPairRule> pairs;
+    bool surfaceVelocity;
+    int revision;
+
+    // the table edited from java
+    static jmeContactRules shared;
+
+    const jmeContactMaterial* getMaterial(int id) const;
+    const jmeContactMaterial* getMaterial(const btCollisionObject* object) const;
+    const jmeContactPairRule* getPairRule(int id0, int id1) const;
+    void contactAdded(btManifoldPoint& cp, const btCollisionObject* object0, const btCollisionObject* object1) const;
+};
+#endif
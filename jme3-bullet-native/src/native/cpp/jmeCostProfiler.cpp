@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeCostProfiler.h"
+#include "jmeBulletUtil.h"
+#include "jmePhysicsSpace.h"
+
+/**
+ * Author: dokthar
+ */
+jmeCostProfiler::jmeCostProfiler(btDynamicsWorld* world) : ticks(0) {
+    dispatcher = (btCollisionDispatcher*) world->getDispatcher();
+    previousCallback = dispatcher->getNearCallback();
+    dispatcher->setNearCallback(&jmeCostProfiler::nearCallback);
+}
+
+jmeCostProfiler::~jmeCostProfiler() {
+    dispatcher->setNearCallback(previousCallback);
+}
+
+jmeCostProfiler::jmeObjectCost* jmeCostProfiler::getCost(const btCollisionObject* object) {
+    // the internal objects (like the fixed body of the joints) are not exported
+    if (object->getUserPointer() == NULL) {
+        return NULL;
+    }
+    int* index = indices.find(btHashPtr(object));
+    if (index != NULL) {
+        return &costs[*index];
+    }
+    indices.insert(btHashPtr(object), costs.size());
+    jmeObjectCost& cost = costs.expandNonInitializing();
+    cost.object = object;
+    cost.time = 0;
+    cost.manifolds = 0;
+    cost.contacts = 0;
+    cost.solverRows = 0;
+    cost.ccdSweeps = 0;
+    return &cost;
+}
+
+void jmeCostProfiler::nearCallback(btBroadphasePair& collisionPair, btCollisionDispatcher& dispatcher, const btDispatcherInfo& dispatchInfo) {
+    btCollisionObject* object0 = (btCollisionObject*) collisionPair.m_pProxy0->m_clientObject;
+    btCollisionObject* object1 = (btCollisionObject*) collisionPair.m_pProxy1->m_clientObject;
+    jmeUserPointer *userPointer = (jmeUserPointer*) object0->getUserPointer();
+    if (userPointer == NULL) {
+        userPointer = (jmeUserPointer*) object1->getUserPointer();
+    }
+    jmeCostProfiler* profiler = NULL;
+    if (userPointer != NULL && userPointer->space != NULL) {
+        profiler = ((jmePhysicsSpace*) userPointer->space)->getCostProfiler();
+    }
+    if (profiler == NULL) {
+        btCollisionDispatcher::defaultNearCallback(collisionPair, dispatcher, dispatchInfo);
+        return;
+    }
+    // most pairs take less than a microsecond, the truncated differences
+    // still add up to the right total over many pairs
+    unsigned long start = profiler->clock.getTimeMicroseconds();
+    profiler->previousCallback(collisionPair, dispatcher, dispatchInfo);
+    btScalar time = (btScalar) (profiler->clock.getTimeMicroseconds() - start);
+
+    jmeObjectCost* cost = profiler->getCost(object0);
+    if (cost != NULL) {
+        cost->time += time;
+    }
+    cost = profiler->getCost(object1);
+    if (cost != NULL) {
+        cost->time += time;
+    }
+}
+
+void jmeCostProfiler::postTick(btDynamicsWorld* world, btScalar timeStep) {
+    ticks++;
+    // contacts : one normal row and one or two friction rows per point, and
+    // three more with rolling friction
+    int frictionRows = (world->getSolverInfo().m_solverMode & SOLVER_USE_2_FRICTION_DIRECTIONS) ? 2 : 1;
+    int numManifolds = dispatcher->getNumManifolds();
+    for (int i = 0; i < numManifolds; i++) {
+        btPersistentManifold* manifold = dispatcher->getManifoldByIndexInternal(i);
+        int numContacts = manifold->getNumContacts();
+        if (numContacts == 0) {
+            continue;
+        }
+        int rows = 0;
+        for (int j = 0; j < numContacts; j++) {
+            rows += 1 + frictionRows + (manifold->getContactPoint(j).m_combinedRollingFriction > 0 ? 3 : 0);
+        }
+        const btCollisionObject* objects[2] = {manifold->getBody0(), manifold->getBody1()};
+        for (int k = 0; k < 2; k++) {
+            jmeObjectCost* cost = getCost(objects[k]);
+            if (cost != NULL) {
+                cost->manifolds++;
+                cost->contacts += numContacts;
+                cost->solverRows += rows;
+            }
+        }
+    }
+    // joints
+    for (int i = 0; i < world->getNumConstraints(); i++) {
+        btTypedConstraint* constraint = world->getConstraint(i);
+        if (!constraint->isEnabled()) {
+            continue;
+        }
+        btTypedConstraint::btConstraintInfo1 info;
+        constraint->getInfo1(&info);
+        jmeObjectCost* cost = getCost(&constraint->getRigidBodyA());
+        if (cost != NULL) {
+            cost->solverRows += info.m_numConstraintRows;
+        }
+        cost = getCost(&constraint->getRigidBodyB());
+        if (cost != NULL) {
+            cost->solverRows += info.m_numConstraintRows;
+        }
+    }
+    // same test as the integration of the transforms
+    btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++) {
+        btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if (body == NULL || !body->isActive() || body->isStaticOrKinematicObject() || body->getCcdSquareMotionThreshold() == 0) {
+            continue;
+        }
+        if ((body->getLinearVelocity() * timeStep).length2() > body->getCcdSquareMotionThreshold()) {
+            jmeObjectCost* cost = getCost(body);
+            if (cost != NULL) {
+                cost->ccdSweeps++;
+            }
+        }
+    }
+}
+
+int jmeCostProfiler::getCosts(btCollisionObject** objects, float* values, int max, int sortIndex) {
+    btAlignedObjectArray<jmeObjectCost> sorted;
+    sorted.copyFromArray(costs);
+    jmeCostSort sort;
+    sort.sortIndex = sortIndex;
+    sorted.quickSort(sort);
+    float scale = ticks > 0 ? 1.0f / ticks : 0;
+    int count = btMin(max, sorted.size());
+    for (int i = 0; i < count; i++) {
+        const jmeObjectCost& cost = sorted[i];
+        objects[i] = (btCollisionObject*) cost.object;
+        float* value = &values[i * JME_COST_SIZE];
+        value[0] = cost.time * scale;
+        value[1] = cost.manifolds * scale;
+        value[2] = cost.contacts * scale;
+        value[3] = cost.solverRows * scale;
+        value[4] = cost.ccdSweeps * scale;
+    }
+    return count;
+}
+
+void jmeCostProfiler::objectRemoved(const btCollisionObject* object) {
+    int* found = indices.find(btHashPtr(object));
+    if (found == NULL) {
+        return;
+    }
+    int index = *found;
+    int last = costs.size() - 1;
+    indices.remove(btHashPtr(object));
+    if (index != last) {
+        costs[index] = costs[last];
+        indices.insert(btHashPtr(costs[index].object), index);
+    }
+    costs.pop_back();
+}
+
+void jmeCostProfiler::reset() {
+    indices.clear();
+    costs.clear();
+    ticks = 0;
+}
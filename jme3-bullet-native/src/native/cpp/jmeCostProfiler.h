@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeCostProfiler
+#define _Included_jmeCostProfiler
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+#include "LinearMath/btHashMap.h"
+#include "LinearMath/btQuickprof.h"
+
+#define JME_COST_SIZE 5
+
+/**
+ * Per collision object cost accounting : the narrowphase time of the pairs
+ * involving the object, its contact manifolds and points, its solver rows
+ * (contacts and joints) and its ccd sweeps, accumulated over the ticks until
+ * the next reset.
+ * The narrowphase time is measured in the dispatcher near callback, so only
+ * the pairs processed by the sequential dispatcher are timed.
+ *
+ * Author: dokthar
+ */
+class jmeCostProfiler {
+public:
+    jmeCostProfiler(btDynamicsWorld* world);
+    ~jmeCostProfiler();
+
+    void postTick(btDynamicsWorld* world, btScalar timeStep);
+    // sort the objects by the cost at sortIndex and store at most max of them,
+    // JME_COST_SIZE values per object averaged over the ticks, returns the
+    // stored count
+    int getCosts(btCollisionObject** objects, float* costs, int max, int sortIndex);
+    void reset();
+    // drop the costs of an object removed from the world, its address may be
+    // reused by a new object
+    void objectRemoved(const btCollisionObject* object);
+
+    static void nearCallback(btBroadphasePair& collisionPair, btCollisionDispatcher& dispatcher, const btDispatcherInfo& dispatchInfo);
+
+private:
+    struct jmeObjectCost {
+        const btCollisionObject* object;
+        btScalar time;
+        int manifolds;
+        int contacts;
+        int solverRows;
+        int ccdSweeps;
+    };
+
+    struct jmeCostSort {
+        int sortIndex;
+
+        btScalar value(const jmeObjectCost& cost) const {
+            switch (sortIndex) {
+                case 1: return (btScalar) cost.manifolds;
+                case 2: return (btScalar) cost.contacts;
+                case 3: return (btScalar) cost.solverRows;
+                case 4: return (btScalar) cost.ccdSweeps;
+                default: return cost.time;
+            }
+        }
+
+        bool operator()(const jmeObjectCost& a, const jmeObjectCost& b) const {
+            btScalar valueA = value(a);
+            btScalar valueB = value(b);
+            if (valueA != valueB) {
+                return valueA > valueB;
+            }
+            return a.solverRows > b.solverRows;
+        }
+    };
+    btCollisionDispatcher* dispatcher;
+    btNearCallback previousCallback;
+    btClock clock;
+    btHashMap<btHashPtr, int> indices;
+    btAlignedObjectArray<jmeObjectCost> costs;
+    int ticks;
+
+    jmeObjectCost* getCost(const btCollisionObject* object);
+};
+#endif
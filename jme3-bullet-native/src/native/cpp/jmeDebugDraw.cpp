@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeDebugDraw.h"
+#include <string.h>
+
+/**
+ * Author: dokthar
+ */
+jmeDebugDraw::jmeDebugDraw()
+: contactLength(0.25f), debugMode(DBG_NoDebug) {
+}
+
+void jmeDebugDraw::addVertex(const btVector3& position, const btVector3& color) {
+    positions.push_back(position.x());
+    positions.push_back(position.y());
+    positions.push_back(position.z());
+    colors.push_back(color.x());
+    colors.push_back(color.y());
+    colors.push_back(color.z());
+    colors.push_back(1);
+}
+
+void jmeDebugDraw::drawLine(const btVector3& from, const btVector3& to, const btVector3& color) {
+    addVertex(from, color);
+    addVertex(to, color);
+}
+
+void jmeDebugDraw::drawContactPoint(const btVector3& pointOnB, const btVector3& normalOnB, btScalar distance, int lifeTime, const btVector3& color) {
+    drawLine(pointOnB, pointOnB + normalOnB * contactLength, color);
+}
+
+// the warnings kept between two reads, the next ones are dropped
+#define JME_DEBUG_DRAW_MAX_WARNINGS 4096
+
+void jmeDebugDraw::reportErrorWarning(const char* warningString) {
+    int length = (int) strlen(warningString);
+    while (length > 0 && warningString[length - 1] == '\n') {
+        length--;
+    }
+    if (length == 0 || warnings.size() + length + 1 > JME_DEBUG_DRAW_MAX_WARNINGS) {
+        return;
+    }
+    for (int i = 0; i < length; ++i) {
+        warnings.push_back(warningString[i]);
+    }
+    warnings.push_back('\n');
+}
+
+void jmeDebugDraw::draw3dText(const btVector3& location, const char* textString) {
+}
+
+void jmeDebugDraw::setDebugMode(int debugMode) {
+    this->debugMode = debugMode;
+}
+
+int jmeDebugDraw::getDebugMode() const {
+    return debugMode;
+}
+
+int jmeDebugDraw::draw(btCollisionWorld* world) {
+    // keep the capacity from one frame to the other
+    positions.resizeNoInitialize(0);
+    colors.resizeNoInitialize(0);
+    world->debugDrawWorld();
+    return getVertexCount();
+}
+
+int jmeDebugDraw::getVertexCount() const {
+    return positions.size() / 3;
+}
+
+void jmeDebugDraw::copy(float* positions, float* colors, int count) const {
+    count = btMin(count, getVertexCount());
+    if (count > 0) {
+        memcpy(positions, &this->positions[0], count * 3 * sizeof (float));
+        memcpy(colors, &this->colors[0], count * 4 * sizeof (float));
+    }
+}
+
+const char* jmeDebugDraw::getWarnings() {
+    if (warnings.size() == 0) {
+        return NULL;
+    }
+    warnings.push_back('\0');
+    return &warnings[0];
+}
+
+void jmeDebugDraw::clearWarnings() {
+    warnings.resizeNoInitialize(0);
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeDebugDraw
+#define _Included_jmeDebugDraw
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btIDebugDraw.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+/**
+ * Debug drawer collecting the lines drawn by debugDrawWorld() into a line
+ * list : 3 floats (position) and 4 floats (color) per vertex, 2 vertices per
+ * line. The contact points are drawn as their normal. The warnings reported
+ * by bullet are kept until java reads them and logs them.
+ *
+ * Author: dokthar
+ */
+class jmeDebugDraw : public btIDebugDraw {
+public:
+    jmeDebugDraw();
+
+    virtual void drawLine(const btVector3& from, const btVector3& to, const btVector3& color);
+    virtual void drawContactPoint(const btVector3& pointOnB, const btVector3& normalOnB, btScalar distance, int lifeTime, const btVector3& color);
+    virtual void reportErrorWarning(const char* warningString);
+    virtual void draw3dText(const btVector3& location, const char* textString);
+    virtual void setDebugMode(int debugMode);
+    virtual int getDebugMode() const;
+
+    // clear the lines and draw the world
+    int draw(btCollisionWorld* world);
+    int getVertexCount() const;
+    // copy at most count vertices
+    void copy(float* positions, float* colors, int count) const;
+    // the warnings reported since the last call, one per line, NULL if none
+    const char* getWarnings();
+    void clearWarnings();
+
+    // length of the contact normals
+    btScalar contactLength;
+
+private:
+    int debugMode;
+    btAlignedObjectArray<float> positions;
+    btAlignedObjectArray<float> colors;
+    btAlignedObjectArray<char> warnings;
+
+    void addVertex(const btVector3& position, const btVector3& color);
+};
+#endif
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeForceFields.h"
+#include "jmeBulletUtil.h"
+#include "LinearMath/btAabbUtil2.h"
+
+/**
+ * Author: dokthar
+ */
+void jmeForceField::getAabb(btVector3& aabbMin, btVector3& aabbMax) const {
+    btVector3 halfExtents;
+    switch (shape) {
+        case JME_FIELD_SPHERE:
+            halfExtents.setValue(extents.x(), extents.x(), extents.x());
+            break;
+        case JME_FIELD_CAPSULE:
+            halfExtents.setValue(extents.x(), extents.y() + extents.x(), extents.x());
+            break;
+        default:
+            halfExtents = extents;
+    }
+    btTransformAabb(halfExtents, 0, transform, aabbMin, aabbMax);
+}
+
+btScalar jmeForceField::getDistance(const btVector3& local) const {
+    switch (shape) {
+        case JME_FIELD_SPHERE:
+            return local.length() / extents.x();
+        case JME_FIELD_CAPSULE:
+        {
+            // distance to the segment of the capsule
+            btScalar y = btMax(-extents.y(), btMin(local.y(), extents.y()));
+            return (local - btVector3(0, y, 0)).length() / extents.x();
+        }
+        default:
+            return btMax(btFabs(local.x()) / extents.x(), btMax(btFabs(local.y()) / extents.y(), btFabs(local.z()) / extents.z()));
+    }
+}
+
+btVector3 jmeForceField::getForce(const btVector3& position, btScalar time) const {
+    btVector3 local = transform.invXform(position);
+    btScalar distance = getDistance(local);
+    if (distance > 1) {
+        return btVector3(0, 0, 0);
+    }
+    btVector3 force;
+    switch (profile) {
+        case JME_FIELD_RADIAL:
+            force = local.fuzzyZero() ? btVector3(0, 0, 0) : -local.normalized();
+            break;
+        case JME_FIELD_VORTEX:
+        {
+            btVector3 radial(local.x(), 0, local.z());
+            force = radial.fuzzyZero() ? btVector3(0, 0, 0) : btVector3(0, 1, 0).cross(radial.normalized());
+            break;
+        }
+        case JME_FIELD_NOISE:
+        {
+            // cheap turbulence, a sum of sines moving with time
+            btVector3 p = local * noiseFrequency;
+            btVector3 turbulence(
+                    btSin(p.y() * 1.7f + time * 1.3f) + btSin(p.z() * 2.3f - time * 0.7f),
+                    btSin(p.z() * 1.9f + time * 1.1f) + btSin(p.x() * 2.9f + time * 0.5f),
+                    btSin(p.x() * 1.3f - time * 1.7f) + btSin(p.y() * 2.1f + time * 0.9f));
+            force = direction + turbulence * 0.5f;
+            break;
+        }
+        default:
+            force = direction;
+    }
+    btScalar scale;
+    switch (falloff) {
+        case JME_FALLOFF_LINEAR:
+            scale = 1 - distance;
+            break;
+        case JME_FALLOFF_SMOOTH:
+            scale = 1 - distance * distance * (3 - 2 * distance);
+            break;
+        case JME_FALLOFF_INVERSE_SQUARE:
+        {
+            // the strength is given at a distance of one unit
+            btScalar radius2 = btMax(local.length2(), btScalar(0.01));
+            scale = 1 / radius2;
+            break;
+        }
+        default:
+            scale = 1;
+    }
+    return transform.getBasis() * force * (strength * scale);
+}
+
+jmeForceFields::jmeForceFields() : nextId(1), time(0) {
+}
+
+int jmeForceFields::add() {
+    jmeForceField& field = fields.expand();
+    field.id = nextId++;
+    field.shape = JME_FIELD_SPHERE;
+    field.extents.setValue(1, 1, 1);
+    field.transform.setIdentity();
+    field.profile = JME_FIELD_LINEAR;
+    field.falloff = JME_FALLOFF_NONE;
+    field.direction.setValue(0, 1, 0);
+    field.strength = 0;
+    field.noiseFrequency = 1;
+    field.massIndependent = false;
+    field.groups = -1;
+    return field.id;
+}
+
+bool jmeForceFields::remove(int id) {
+    for (int i = 0; i < fields.size(); i++) {
+        if (fields[i].id == id) {
+            fields.swap(i, fields.size() - 1);
+            fields.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+jmeForceField* jmeForceFields::get(int id) {
+    for (int i = 0; i < fields.size(); i++) {
+        if (fields[i].id == id) {
+            return &fields[i];
+        }
+    }
+    return NULL;
+}
+
+struct jmeFieldCallback : public btBroadphaseAabbCallback {
+    btAlignedObjectArray<btCollisionObject*>* objects;
+
+    virtual bool process(const btBroadphaseProxy* proxy) {
+        objects->push_back((btCollisionObject*) proxy->m_clientObject);
+        return true;
+    }
+};
+
+void jmeForceFields::apply(btDynamicsWorld* world, btScalar timeStep) {
+    time += timeStep;
+    jmeFieldCallback callback;
+    callback.objects = &overlaps;
+    for (int i = 0; i < fields.size(); i++) {
+        const jmeForceField& field = fields[i];
+        if (field.strength == 0) {
+            continue;
+        }
+        btVector3 aabbMin, aabbMax;
+        field.getAabb(aabbMin, aabbMax);
+        overlaps.resize(0);
+        world->getBroadphase()->aabbTest(aabbMin, aabbMax, callback);
+        for (int j = 0; j < overlaps.size(); j++) {
+            btRigidBody* body = btRigidBody::upcast(overlaps[j]);
+            // like the gravity, the sleeping bodies are left asleep
+            if (body == NULL || body->isStaticOrKinematicObject() || !body->isActive()) {
+                continue;
+            }
+            jmeUserPointer *userPointer = (jmeUserPointer*) body->getUserPointer();
+            if (userPointer != NULL && (userPointer->group & field.groups) == 0) {
+                continue;
+            }
+            btVector3 force = field.getForce(body->getCenterOfMassPosition(), time);
+            if (field.massIndependent) {
+                force /= body->getInvMass();
+            }
+            body->applyCentralImpulse(force * timeStep);
+        }
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeForceFields
+#define _Included_jmeForceFields
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+#define JME_FIELD_BOX 0
+#define JME_FIELD_SPHERE 1
+#define JME_FIELD_CAPSULE 2
+
+#define JME_FIELD_LINEAR 0
+#define JME_FIELD_RADIAL 1
+#define JME_FIELD_VORTEX 2
+#define JME_FIELD_NOISE 3
+
+#define JME_FALLOFF_NONE 0
+#define JME_FALLOFF_LINEAR 1
+#define JME_FALLOFF_SMOOTH 2
+#define JME_FALLOFF_INVERSE_SQUARE 3
+
+/**
+ * A force field volume : box (half extents), sphere (extents.x radius) or
+ * capsule along the local y axis (extents.x radius, extents.y half height).
+ * Profiles, in the local space of the field :
+ * - linear : strength along the direction
+ * - radial : strength toward the center, negative to repel
+ * - vortex : strength around the y axis
+ * - noise : strength along the direction plus a turbulence
+ *
+ * Author: dokthar
+ */
+class jmeForceField {
+public:
+    int id;
+    int shape;
+    btVector3 extents;
+    btTransform transform;
+    int profile;
+    int falloff;
+    btVector3 direction;
+    btScalar strength;
+    btScalar noiseFrequency;
+    // the strength is an acceleration instead of a force
+    bool massIndependent;
+    // the collision groups affected
+    int groups;
+
+    void getAabb(btVector3& aabbMin, btVector3& aabbMax) const;
+    // in the local space of the field, 0 at the center, above 1 outside
+    btScalar getDistance(const btVector3& local) const;
+    // the force in world space at a world position, with the falloff
+    btVector3 getForce(const btVector3& position, btScalar time) const;
+};
+
+/**
+ * The force fields of a physics space, applied to the active rigid bodies
+ * overlapping them before each internal tick, as impulses so they do not
+ * accumulate over the substeps like the forces do.
+ *
+ * Author: dokthar
+ */
+class jmeForceFields {
+public:
+    jmeForceFields();
+
+    int add();
+    bool remove(int id);
+    jmeForceField* get(int id);
+    void apply(btDynamicsWorld* world, btScalar timeStep);
+
+private:
+    btAlignedObjectArray<jmeForceField> fields;
+    btAlignedObjectArray<btCollisionObject*> overlaps;
+    int nextId;
+    btScalar time;
+};
+#endif
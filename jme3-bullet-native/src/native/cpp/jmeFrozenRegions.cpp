@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeFrozenRegions.h"
+#include "jmeBulletUtil.h"
+
+/**
+ * Author: dokthar
+ */
+class jmeFrozenObject {
+public:
+    int region;
+    int activationState;
+    btScalar linearVelocity[3];
+    btScalar angularVelocity[3];
+};
+
+// remove the pairs of the frozen objects, except the ones with ghosts
+struct jmeFreezePairsCallback : public btOverlapCallback {
+
+    virtual bool processOverlap(btBroadphasePair& pair) {
+        return !jmeFrozenRegions::needsPair((btCollisionObject*) pair.m_pProxy0->m_clientObject,
+                (btCollisionObject*) pair.m_pProxy1->m_clientObject);
+    }
+};
+
+struct jmeFreezeCallback : public btBroadphaseAabbCallback {
+    btAlignedObjectArray<btCollisionObject*> objects;
+
+    virtual bool process(const btBroadphaseProxy* proxy) {
+        objects.push_back((btCollisionObject*) proxy->m_clientObject);
+        return true;
+    }
+};
+
+jmeFrozenRegions::jmeFrozenRegions() : nextRegion(1) {
+}
+
+int jmeFrozenRegions::freeze(btCollisionWorld* world, const btVector3& aabbMin, const btVector3& aabbMax) {
+    // collect first, the broadphase tree must not change during the query
+    jmeFreezeCallback callback;
+    world->getBroadphase()->aabbTest(aabbMin, aabbMax, callback);
+    if (callback.objects.size() == 0) {
+        return freeze(world, (btCollisionObject**) NULL, 0);
+    }
+    return freeze(world, &callback.objects[0], callback.objects.size());
+}
+
+int jmeFrozenRegions::freeze(btCollisionWorld* world, btCollisionObject** objects, int count) {
+    int region = nextRegion++;
+    int frozen = 0;
+    for (int i = 0; i < count; i++) {
+        if (objects[i] != NULL && freeze(objects[i], region)) {
+            frozen++;
+        }
+    }
+    if (frozen > 0) {
+        // the current pairs are removed with their manifolds, all in one pass
+        jmeFreezePairsCallback callback;
+        world->getBroadphase()->getOverlappingPairCache()->processAllOverlappingPairs(&callback, world->getDispatcher());
+    }
+    return region;
+}
+
+bool jmeFrozenRegions::freeze(btCollisionObject* object, int region) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) object->getUserPointer();
+    if (userPointer == NULL || userPointer->frozen != NULL
+            || object->isStaticOrKinematicObject()
+            || object->getInternalType() == btCollisionObject::CO_SOFT_BODY
+            || object->getInternalType() == btCollisionObject::CO_GHOST_OBJECT) {
+        return false;
+    }
+    jmeFrozenObject* frozen = new jmeFrozenObject();
+    frozen->region = region;
+    frozen->activationState = object->getActivationState();
+    btRigidBody* body = btRigidBody::upcast(object);
+    if (body != NULL) {
+        for (int i = 0; i < 3; i++) {
+            frozen->linearVelocity[i] = body->getLinearVelocity()[i];
+            frozen->angularVelocity[i] = body->getAngularVelocity()[i];
+        }
+        body->setLinearVelocity(btVector3(0, 0, 0));
+        body->setAngularVelocity(btVector3(0, 0, 0));
+    }
+    object->forceActivationState(DISABLE_SIMULATION);
+    // the overlap filter refuses the new pairs of a frozen object
+    userPointer->frozen = frozen;
+    return true;
+}
+
+int jmeFrozenRegions::unfreeze(btCollisionWorld* world, int region) {
+    btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    int count = 0;
+    for (int i = 0; i < objects.size(); i++) {
+        jmeUserPointer *userPointer = (jmeUserPointer*) objects[i]->getUserPointer();
+        if (userPointer != NULL && userPointer->frozen != NULL
+                && ((jmeFrozenObject*) userPointer->frozen)->region == region) {
+            restore(world, objects[i]);
+            count++;
+        }
+    }
+    return count;
+}
+
+void jmeFrozenRegions::restore(btCollisionWorld* world, btCollisionObject* object) {
+    restoreState(object);
+    btBroadphaseProxy* proxy = object->getBroadphaseHandle();
+    if (proxy != NULL) {
+        // a new proxy finds its overlapping pairs right away, even if the object does not move
+        btBroadphaseInterface* broadphase = world->getBroadphase();
+        short int group = proxy->m_collisionFilterGroup;
+        short int mask = proxy->m_collisionFilterMask;
+        broadphase->destroyProxy(proxy, world->getDispatcher());
+        btVector3 aabbMin, aabbMax;
+        object->getCollisionShape()->getAabb(object->getWorldTransform(), aabbMin, aabbMax);
+        object->setBroadphaseHandle(broadphase->createProxy(aabbMin, aabbMax,
+                object->getCollisionShape()->getShapeType(), object, group, mask, world->getDispatcher(), 0));
+    }
+}
+
+void jmeFrozenRegions::restoreState(btCollisionObject* object) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) object->getUserPointer();
+    jmeFrozenObject* frozen = (jmeFrozenObject*) userPointer->frozen;
+    object->forceActivationState(frozen->activationState);
+    object->setDeactivationTime(0);
+    btRigidBody* body = btRigidBody::upcast(object);
+    if (body != NULL) {
+        body->setLinearVelocity(btVector3(frozen->linearVelocity[0], frozen->linearVelocity[1], frozen->linearVelocity[2]));
+        body->setAngularVelocity(btVector3(frozen->angularVelocity[0], frozen->angularVelocity[1], frozen->angularVelocity[2]));
+    }
+    delete(frozen);
+    userPointer->frozen = NULL;
+}
+
+bool jmeFrozenRegions::isFrozen(const btCollisionObject* object) {
+    const jmeUserPointer *userPointer = (const jmeUserPointer*) object->getUserPointer();
+    return userPointer != NULL && userPointer->frozen != NULL;
+}
+
+bool jmeFrozenRegions::needsPair(const btCollisionObject* object0, const btCollisionObject* object1) {
+    if (isFrozen(object0)) {
+        return object1->getInternalType() == btCollisionObject::CO_GHOST_OBJECT;
+    }
+    if (isFrozen(object1)) {
+        return object0->getInternalType() == btCollisionObject::CO_GHOST_OBJECT;
+    }
+    return true;
+}
+
+void jmeFrozenRegions::objectRemoved(btCollisionObject* object) {
+    if (isFrozen(object)) {
+        // the object leaves the world with its own state, not added back frozen
+        restoreState(object);
+    }
+}
+
+void jmeFrozenRegions::release(btCollisionObject* object) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) object->getUserPointer();
+    if (userPointer != NULL && userPointer->frozen != NULL) {
+        delete((jmeFrozenObject*) userPointer->frozen);
+        userPointer->frozen = NULL;
+    }
+}
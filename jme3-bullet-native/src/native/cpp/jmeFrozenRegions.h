@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeFrozenRegions
+#define _Included_jmeFrozenRegions
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+/**
+ * Region freezing : the objects of a region are set to DISABLE_SIMULATION
+ * and their broadphase pairs are removed without removing them from the
+ * world, the overlap filter of the space refuses their new pairs except with
+ * ghost objects. They keep their broadphase proxy and collision mask, so the
+ * ray, sweep and projectile tests still hit them and the ghosts still see
+ * them. Their activation state and velocities are restored when the region
+ * is unfrozen or when they are removed from the world.
+ * Static, kinematic, soft and ghost objects (characters too) are not frozen.
+ *
+ * Author: dokthar
+ */
+class jmeFrozenRegions {
+public:
+    jmeFrozenRegions();
+
+    // freeze the objects overlapping the aabb, returns the region id
+    int freeze(btCollisionWorld* world, const btVector3& aabbMin, const btVector3& aabbMax);
+    // freeze the given objects, returns the region id
+    int freeze(btCollisionWorld* world, btCollisionObject** objects, int count);
+    // restore the objects of a region, returns the number of objects restored
+    int unfreeze(btCollisionWorld* world, int region);
+
+    static bool isFrozen(const btCollisionObject* object);
+    // false if one of the objects is frozen and the other is not a ghost,
+    // used by the overlap filter of the spaces
+    static bool needsPair(const btCollisionObject* object0, const btCollisionObject* object1);
+    // restore the state of an object removed from the world while frozen
+    static void objectRemoved(btCollisionObject* object);
+    // free the frozen state of a destroyed object
+    static void release(btCollisionObject* object);
+
+private:
+    int nextRegion;
+
+    // the pairs of the object are left to the caller
+    bool freeze(btCollisionObject* object, int region);
+    void restore(btCollisionWorld* world, btCollisionObject* object);
+    static void restoreState(btCollisionObject* object);
+};
+#endif
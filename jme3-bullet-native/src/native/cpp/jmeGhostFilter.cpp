@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeGhostFilter.h"
+#include "jmeBulletUtil.h"
+#include "jmePhysicsSpace.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h"
+#include "BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h"
+#include "BulletCollision/NarrowPhaseCollision/btPointCollector.h"
+#include "BulletCollision/CollisionShapes/btTriangleShape.h"
+#ifdef _WIN32
+#include "BulletMultiThreaded/Win32ThreadSupport.h"
+#elif defined (USE_PTHREADS)
+#include "BulletMultiThreaded/PosixThreadSupport.h"
+#endif
+
+/**
+ * Author: dokthar
+ */
+#define JME_GHOST_FILTER_THREADS 4
+
+typedef btAlignedObjectArray<const btCollisionObject*> jmeGhostOverlaps;
+
+struct jmeGhostFilterTask {
+    jmeGhostFilter* filter;
+    int begin;
+    int end;
+};
+
+static void jmeGhostFilterThreadFunc(void* userPtr, void* lsMemory) {
+    jmeGhostFilterTask* task = (jmeGhostFilterTask*) userPtr;
+    task->filter->filterRange(task->begin, task->end);
+}
+
+static void* jmeGhostFilterMemoryFunc() {
+    return NULL;
+}
+
+jmeGhostFilter::jmeGhostFilter() : threads(NULL), numThreads(1) {
+#ifdef _WIN32
+    Win32ThreadSupport::Win32ThreadConstructionInfo threadConstructionInfo("ghostFilter", jmeGhostFilterThreadFunc, jmeGhostFilterMemoryFunc, JME_GHOST_FILTER_THREADS);
+    threads = new Win32ThreadSupport(threadConstructionInfo);
+    threads->startSPU();
+    numThreads = JME_GHOST_FILTER_THREADS;
+#elif defined (USE_PTHREADS)
+    PosixThreadSupport::ThreadConstructionInfo constructionInfo("ghostFilter", jmeGhostFilterThreadFunc,
+            jmeGhostFilterMemoryFunc, JME_GHOST_FILTER_THREADS);
+    threads = new PosixThreadSupport(constructionInfo);
+    threads->startSPU();
+    numThreads = JME_GHOST_FILTER_THREADS;
+#endif
+}
+
+jmeGhostFilter::~jmeGhostFilter() {
+    if (threads != NULL) {
+        threads->stopSPU();
+        delete(threads);
+    }
+}
+
+void jmeGhostFilter::filter(btCollisionWorld* world) {
+    ghosts.resize(0);
+    serialGhosts.resize(0);
+    btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++) {
+        btPairCachingGhostObject* ghost = (btPairCachingGhostObject*) btGhostObject::upcast(objects[i]);
+        if (ghost != NULL && isEnabled(ghost)) {
+            if (threads != NULL && usesGImpact(ghost)) {
+                serialGhosts.push_back(ghost);
+            } else {
+                ghosts.push_back(ghost);
+            }
+        }
+    }
+    int count = ghosts.size();
+    if (threads == NULL || count < 2) {
+        filterRange(0, count);
+        for (int i = 0; i < serialGhosts.size(); i++) {
+            filterGhost(serialGhosts[i]);
+        }
+        return;
+    }
+    int tasks = btMin(numThreads, count);
+    jmeGhostFilterTask task[JME_GHOST_FILTER_THREADS];
+    for (int i = 0; i < tasks; i++) {
+        task[i].filter = this;
+        task[i].begin = count * i / tasks;
+        task[i].end = count * (i + 1) / tasks;
+        threads->sendRequest(1, (ppu_address_t) & task[i], i);
+    }
+    // the workers never touch a gimpact shape while these are filtered
+    for (int i = 0; i < serialGhosts.size(); i++) {
+        filterGhost(serialGhosts[i]);
+    }
+    for (int i = 0; i < tasks; i++) {
+        unsigned int taskId;
+        unsigned int status;
+        threads->waitForResponse(&taskId, &status);
+    }
+}
+
+void jmeGhostFilter::filterRange(int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        filterGhost(ghosts[i]);
+    }
+}
+
+void jmeGhostFilter::filterGhost(btPairCachingGhostObject* ghost) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) ghost->getUserPointer();
+    jmeGhostOverlaps* overlaps = (jmeGhostOverlaps*) userPointer->exactOverlaps;
+    overlaps->resize(0);
+    btBroadphasePairArray& pairs = ghost->getOverlappingPairCache()->getOverlappingPairArray();
+    for (int i = 0; i < pairs.size(); i++) {
+        btCollisionObject* other = (btCollisionObject*) pairs[i].m_pProxy0->m_clientObject;
+        if (other == ghost) {
+            other = (btCollisionObject*) pairs[i].m_pProxy1->m_clientObject;
+        }
+        if (intersects(ghost->getCollisionShape(), ghost->getWorldTransform(), other->getCollisionShape(), other->getWorldTransform())) {
+            overlaps->push_back(other);
+        }
+    }
+}
+
+static bool jmeHasGImpact(const btCollisionShape* shape) {
+    if (shape->getShapeType() == GIMPACT_SHAPE_PROXYTYPE) {
+        return true;
+    }
+    if (shape->isCompound()) {
+        const btCompoundShape* compound = (const btCompoundShape*) shape;
+        for (int i = 0; i < compound->getNumChildShapes(); i++) {
+            if (jmeHasGImpact(compound->getChildShape(i))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool jmeGhostFilter::usesGImpact(btPairCachingGhostObject* ghost) {
+    if (jmeHasGImpact(ghost->getCollisionShape())) {
+        return true;
+    }
+    btBroadphasePairArray& pairs = ghost->getOverlappingPairCache()->getOverlappingPairArray();
+    for (int i = 0; i < pairs.size(); i++) {
+        btCollisionObject* other = (btCollisionObject*) pairs[i].m_pProxy0->m_clientObject;
+        if (other == ghost) {
+            other = (btCollisionObject*) pairs[i].m_pProxy1->m_clientObject;
+        }
+        if (jmeHasGImpact(other->getCollisionShape())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+struct jmeGhostTriangleCallback : public btTriangleCallback {
+    const btConvexShape* convex;
+    btTransform convexTransform;
+    btTransform concaveTransform;
+    bool hit;
+
+    virtual void processTriangle(btVector3* triangle, int partId, int triangleIndex) {
+        if (hit) {
+            return;
+        }
+        btTriangleShape triangleShape(triangle[0], triangle[1], triangle[2]);
+        hit = jmeGhostFilter::intersects(convex, convexTransform, &triangleShape, concaveTransform);
+    }
+};
+
+bool jmeGhostFilter::intersects(const btCollisionShape* shapeA, const btTransform& transformA, const btCollisionShape* shapeB, const btTransform& transformB) {
+    if (shapeA->isCompound()) {
+        const btCompoundShape* compound = (const btCompoundShape*) shapeA;
+        for (int i = 0; i < compound->getNumChildShapes(); i++) {
+            if (intersects(compound->getChildShape(i), transformA * compound->getChildTransform(i), shapeB, transformB)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    if (shapeB->isCompound()) {
+        return intersects(shapeB, transformB, shapeA, transformA);
+    }
+    if (shapeA->isConvex() && shapeB->isConvex()) {
+        btVoronoiSimplexSolver simplexSolver;
+        btGjkEpaPenetrationDepthSolver penetrationSolver;
+        btGjkPairDetector detector((const btConvexShape*) shapeA, (const btConvexShape*) shapeB, &simplexSolver, &penetrationSolver);
+        btGjkPairDetector::ClosestPointInput input;
+        input.m_transformA = transformA;
+        input.m_transformB = transformB;
+        btPointCollector result;
+        detector.getClosestPoints(input, result, NULL);
+        return result.m_hasResult && result.m_distance < 0;
+    }
+    if (shapeA->isConvex() && shapeB->isConcave()) {
+        jmeGhostTriangleCallback callback;
+        callback.convex = (const btConvexShape*) shapeA;
+        callback.convexTransform = transformA;
+        callback.concaveTransform = transformB;
+        callback.hit = false;
+        // the convex aabb in the space of the concave shape
+        btVector3 aabbMin, aabbMax;
+        shapeA->getAabb(transformB.inverseTimes(transformA), aabbMin, aabbMax);
+        ((const btConcaveShape*) shapeB)->processAllTriangles(&callback, aabbMin, aabbMax);
+        return callback.hit;
+    }
+    if (shapeA->isConcave() && shapeB->isConvex()) {
+        return intersects(shapeB, transformB, shapeA, transformA);
+    }
+    // not tested, kept as overlapping
+    return true;
+}
+
+void jmeGhostFilter::setEnabled(btCollisionObject* ghost, bool enabled) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) ghost->getUserPointer();
+    if (userPointer == NULL || enabled == (userPointer->exactOverlaps != NULL)) {
+        return;
+    }
+    if (enabled) {
+        userPointer->exactOverlaps = new jmeGhostOverlaps();
+    } else {
+        release(ghost);
+    }
+    if (userPointer->space != NULL) {
+        ((jmePhysicsSpace*) userPointer->space)->exactOverlapsChanged(enabled);
+    }
+}
+
+bool jmeGhostFilter::isEnabled(btCollisionObject* ghost) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) ghost->getUserPointer();
+    return userPointer != NULL && userPointer->exactOverlaps != NULL;
+}
+
+bool jmeGhostFilter::isOverlapping(btCollisionObject* ghost, const btCollisionObject* other) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) ghost->getUserPointer();
+    if (userPointer == NULL || userPointer->exactOverlaps == NULL) {
+        return true;
+    }
+    jmeGhostOverlaps* overlaps = (jmeGhostOverlaps*) userPointer->exactOverlaps;
+    return overlaps->findLinearSearch(other) != overlaps->size();
+}
+
+int jmeGhostFilter::getOverlapping(btPairCachingGhostObject* ghost, btCollisionObject** store, int max) {
+    // through the pair cache, the objects removed since the last step are not in it
+    btBroadphasePairArray& pairs = ghost->getOverlappingPairCache()->getOverlappingPairArray();
+    int count = 0;
+    for (int i = 0; i < pairs.size(); i++) {
+        btCollisionObject* other = (btCollisionObject*) pairs[i].m_pProxy0->m_clientObject;
+        if (other == ghost) {
+            other = (btCollisionObject*) pairs[i].m_pProxy1->m_clientObject;
+        }
+        if (isOverlapping(ghost, other)) {
+            if (count < max) {
+                store[count] = other;
+            }
+            count++;
+        }
+    }
+    return count;
+}
+
+void jmeGhostFilter::release(btCollisionObject* ghost) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) ghost->getUserPointer();
+    if (userPointer != NULL && userPointer->exactOverlaps != NULL) {
+        delete((jmeGhostOverlaps*) userPointer->exactOverlaps);
+        userPointer->exactOverlaps = NULL;
+    }
+}
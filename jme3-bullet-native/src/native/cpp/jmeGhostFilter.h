@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeGhostFilter
+#define _Included_jmeGhostFilter
+#include "btBulletDynamicsCommon.h"
+#include "BulletCollision/CollisionDispatch/btGhostObject.h"
+#include "BulletMultiThreaded/btThreadSupportInterface.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+/**
+ * Exact overlaps for ghost objects : after each step the broadphase pairs of
+ * the ghosts with exact overlaps enabled are tested against the real shapes,
+ * and only the intersecting objects are kept.
+ * The tests use stack allocated GJK solvers instead of the dispatcher, so
+ * the ghosts are filtered in parallel when thread support is available.
+ * The gimpact shapes lock their mesh while processing the triangles, so the
+ * ghosts with a gimpact shape in their pairs are filtered on one thread.
+ * Convex, compound and convex versus concave shapes are tested, other pairs
+ * (concave versus concave, soft bodies) are kept as overlapping.
+ *
+ * Author: dokthar
+ */
+class jmeGhostFilter {
+public:
+    jmeGhostFilter();
+    ~jmeGhostFilter();
+
+    void filter(btCollisionWorld* world);
+    void filterRange(int begin, int end);
+
+    static void setEnabled(btCollisionObject* ghost, bool enabled);
+    static bool isEnabled(btCollisionObject* ghost);
+    // the exact result of the last step, true for a ghost without filtering
+    static bool isOverlapping(btCollisionObject* ghost, const btCollisionObject* other);
+    // store at most max overlapping objects, returns the overlapping count
+    static int getOverlapping(btPairCachingGhostObject* ghost, btCollisionObject** store, int max);
+    static void release(btCollisionObject* ghost);
+    static bool intersects(const btCollisionShape* shapeA, const btTransform& transformA, const btCollisionShape* shapeB, const btTransform& transformB);
+
+private:
+    btAlignedObjectArray<btPairCachingGhostObject*> ghosts;
+    // the ghosts touching a gimpact shape, filtered on the calling thread
+    btAlignedObjectArray<btPairCachingGhostObject*> serialGhosts;
+    btThreadSupportInterface* threads;
+    int numThreads;
+
+    void filterGhost(btPairCachingGhostObject* ghost);
+    static bool usesGImpact(btPairCachingGhostObject* ghost);
+};
+#endif
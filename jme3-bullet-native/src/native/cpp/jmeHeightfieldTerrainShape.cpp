@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeHeightfieldTerrainShape.h"
+#include <math.h>
+
+/**
+ * Author: dokthar
+ */
+jmeHeightfieldTerrainShape::jmeHeightfieldTerrainShape(int heightStickWidth, int heightStickLength, const void* heightfieldData, btScalar heightScale, btScalar minHeight, btScalar maxHeight, int upAxis, PHY_ScalarType heightDataType, bool flipQuadEdges)
+: btHeightfieldTerrainShape(heightStickWidth, heightStickLength, heightfieldData, heightScale, minHeight, maxHeight, upAxis, heightDataType, flipQuadEdges), updateRevision(0) {
+    tilesX = (heightStickWidth - 2) / JME_HEIGHTFIELD_TILE + 1;
+    tilesY = (heightStickLength - 2) / JME_HEIGHTFIELD_TILE + 1;
+    tileMin.resize(tilesX * tilesY);
+    tileMax.resize(tilesX * tilesY);
+    updateTiles(0, 0, heightStickWidth - 1, heightStickLength - 1);
+}
+
+void jmeHeightfieldTerrainShape::getTileRange(int minX, int minY, int maxX, int maxY, int& firstX, int& firstY, int& lastX, int& lastY) const {
+    // a vertex on a tile border belongs to both tiles
+    firstX = btMax(0, (minX - 1) / JME_HEIGHTFIELD_TILE);
+    firstY = btMax(0, (minY - 1) / JME_HEIGHTFIELD_TILE);
+    lastX = btMin(tilesX - 1, maxX / JME_HEIGHTFIELD_TILE);
+    lastY = btMin(tilesY - 1, maxY / JME_HEIGHTFIELD_TILE);
+}
+
+void jmeHeightfieldTerrainShape::updateTiles(int minX, int minY, int maxX, int maxY) {
+    int firstX, firstY, lastX, lastY;
+    getTileRange(minX, minY, maxX, maxY, firstX, firstY, lastX, lastY);
+    for (int ty = firstY; ty <= lastY; ++ty) {
+        for (int tx = firstX; tx <= lastX; ++tx) {
+            const int endX = btMin(m_heightStickWidth - 1, (tx + 1) * JME_HEIGHTFIELD_TILE);
+            const int endY = btMin(m_heightStickLength - 1, (ty + 1) * JME_HEIGHTFIELD_TILE);
+            btScalar min = getRawHeightFieldValue(tx * JME_HEIGHTFIELD_TILE, ty * JME_HEIGHTFIELD_TILE);
+            btScalar max = min;
+            for (int y = ty * JME_HEIGHTFIELD_TILE; y <= endY; ++y) {
+                for (int x = tx * JME_HEIGHTFIELD_TILE; x <= endX; ++x) {
+                    const btScalar height = getRawHeightFieldValue(x, y);
+                    min = btMin(min, height);
+                    max = btMax(max, height);
+                }
+            }
+            tileMin[ty * tilesX + tx] = min;
+            tileMax[ty * tilesX + tx] = max;
+        }
+    }
+}
+
+bool jmeHeightfieldTerrainShape::heightsChanged(int minX, int minY, int maxX, int maxY) {
+    minX = btMax(0, minX);
+    minY = btMax(0, minY);
+    maxX = btMin(m_heightStickWidth - 1, maxX);
+    maxY = btMin(m_heightStickLength - 1, maxY);
+    if (minX > maxX || minY > maxY) {
+        return false;
+    }
+    updateTiles(minX, minY, maxX, maxY);
+    updateRevision++;
+
+    // the vertexes are placed relative to the middle of the bounds, so they
+    // grow on both sides and never shrink : the local origin doesn't move
+    const btScalar center = (m_minHeight + m_maxHeight) * btScalar(0.5);
+    const btScalar halfHeight = (m_maxHeight - m_minHeight) * btScalar(0.5);
+    btScalar newHalfHeight = halfHeight;
+    int firstX, firstY, lastX, lastY;
+    getTileRange(minX, minY, maxX, maxY, firstX, firstY, lastX, lastY);
+    for (int ty = firstY; ty <= lastY; ++ty) {
+        for (int tx = firstX; tx <= lastX; ++tx) {
+            newHalfHeight = btMax(newHalfHeight, tileMax[ty * tilesX + tx] - center);
+            newHalfHeight = btMax(newHalfHeight, center - tileMin[ty * tilesX + tx]);
+        }
+    }
+    if (newHalfHeight == halfHeight) {
+        return false;
+    }
+    m_minHeight = center - newHalfHeight;
+    m_maxHeight = center + newHalfHeight;
+    m_localAabbMin[m_upAxis] = m_minHeight;
+    m_localAabbMax[m_upAxis] = m_maxHeight;
+    return true;
+}
+
+void jmeHeightfieldTerrainShape::getLocalBounds(int minX, int minY, int maxX, int maxY, btVector3& aabbMin, btVector3& aabbMax) const {
+    // same placement than btHeightfieldTerrainShape::getVertex
+    const int xAxis = m_upAxis == 0 ? 1 : 0;
+    const int yAxis = m_upAxis == 2 ? 1 : 2;
+    btVector3 min, max;
+    min[xAxis] = minX - m_width * btScalar(0.5);
+    max[xAxis] = maxX - m_width * btScalar(0.5);
+    min[yAxis] = minY - m_length * btScalar(0.5);
+    max[yAxis] = maxY - m_length * btScalar(0.5);
+    min[m_upAxis] = m_minHeight - m_localOrigin[m_upAxis];
+    max[m_upAxis] = m_maxHeight - m_localOrigin[m_upAxis];
+    min *= m_localScaling;
+    max *= m_localScaling;
+    aabbMin = min;
+    aabbMax = max;
+    aabbMin.setMin(max);
+    aabbMax.setMax(min);
+}
+
+void jmeHeightfieldTerrainShape::processCell(int x, int j, btTriangleCallback* callback) const {
+    // same triangles than btHeightfieldTerrainShape::processAllTriangles
+    btVector3 vertices[3];
+    if (m_flipQuadEdges || (m_useDiamondSubdivision && !((j + x) & 1))) {
+        getVertex(x, j, vertices[0]);
+        getVertex(x, j + 1, vertices[1]);
+        getVertex(x + 1, j + 1, vertices[2]);
+        callback->processTriangle(vertices, x, j);
+        getVertex(x, j, vertices[0]);
+        getVertex(x + 1, j + 1, vertices[1]);
+        getVertex(x + 1, j, vertices[2]);
+        callback->processTriangle(vertices, x, j);
+    } else {
+        getVertex(x, j, vertices[0]);
+        getVertex(x, j + 1, vertices[1]);
+        getVertex(x + 1, j, vertices[2]);
+        callback->processTriangle(vertices, x, j);
+        getVertex(x + 1, j, vertices[0]);
+        getVertex(x, j + 1, vertices[1]);
+        getVertex(x + 1, j + 1, vertices[2]);
+        callback->processTriangle(vertices, x, j);
+    }
+}
+
+// grid walk (Amanatides & Woo) of the segment origin + direction * t, t in
+// [t0, t1], on cells of the given size
+
+struct jmeGridWalk {
+    int x, y;
+    int stepX, stepY;
+    btScalar nextX, nextY;
+    btScalar deltaX, deltaY;
+
+    // the start cell is clamped in [minX, maxX] x [minY, maxY], the entry
+    // point may be rounded just outside of it
+    jmeGridWalk(const btScalar* origin, const btScalar* direction, btScalar t, btScalar size, int minX, int minY, int maxX, int maxY) {
+        const btScalar px = origin[0] + direction[0] * t;
+        const btScalar py = origin[1] + direction[1] * t;
+        x = btMin(maxX, btMax(minX, (int) floor(px / size)));
+        y = btMin(maxY, btMax(minY, (int) floor(py / size)));
+        init(direction[0], px, x, size, stepX, nextX, deltaX, t);
+        init(direction[1], py, y, size, stepY, nextY, deltaY, t);
+    }
+
+    static void init(btScalar d, btScalar p, int cell, btScalar size, int& step, btScalar& next, btScalar& delta, btScalar t) {
+        if (d > 0) {
+            step = 1;
+            delta = size / d;
+            next = t + ((cell + 1) * size - p) / d;
+        } else if (d < 0) {
+            step = -1;
+            delta = -size / d;
+            next = t + (cell * size - p) / d;
+        } else {
+            step = 0;
+            delta = BT_LARGE_FLOAT;
+            next = BT_LARGE_FLOAT;
+        }
+    }
+
+    // return the end of the current cell
+    btScalar exit() const {
+        return btMin(nextX, nextY);
+    }
+
+    void advance() {
+        if (nextX < nextY) {
+            x += stepX;
+            nextX += deltaX;
+        } else {
+            y += stepY;
+            nextY += deltaY;
+        }
+    }
+};
+
+bool jmeHeightfieldTerrainShape::overlapsHeights(const btVector3& aabbMin, const btVector3& aabbMax) const {
+    const int axisX = m_upAxis == 0 ? 1 : 0;
+    const int axisY = m_upAxis == 2 ? 1 : 2;
+    const btVector3 scale = getLocalScaling();
+    if (scale[axisX] == 0 || scale[axisY] == 0 || scale[m_upAxis] <= 0) {
+        return true;
+    }
+    const btScalar width = btScalar(m_heightStickWidth - 1);
+    const btScalar length = btScalar(m_heightStickLength - 1);
+    btScalar x0 = aabbMin[axisX] / scale[axisX] + width / 2;
+    btScalar x1 = aabbMax[axisX] / scale[axisX] + width / 2;
+    btScalar y0 = aabbMin[axisY] / scale[axisY] + length / 2;
+    btScalar y1 = aabbMax[axisY] / scale[axisY] + length / 2;
+    if (x0 > x1) {
+        btSwap(x0, x1);
+    }
+    if (y0 > y1) {
+        btSwap(y0, y1);
+    }
+    if (x1 < 0 || y1 < 0 || x0 > width || y0 > length) {
+        return false;
+    }
+    const btScalar h0 = aabbMin[m_upAxis] / scale[m_upAxis] + m_localOrigin[m_upAxis];
+    const btScalar h1 = aabbMax[m_upAxis] / scale[m_upAxis] + m_localOrigin[m_upAxis];
+    const int firstX = btMax(0, int(floor(x0)) / JME_HEIGHTFIELD_TILE);
+    const int firstY = btMax(0, int(floor(y0)) / JME_HEIGHTFIELD_TILE);
+    const int lastX = btMin(tilesX - 1, int(floor(x1)) / JME_HEIGHTFIELD_TILE);
+    const int lastY = btMin(tilesY - 1, int(floor(y1)) / JME_HEIGHTFIELD_TILE);
+    for (int ty = firstY; ty <= lastY; ++ty) {
+        for (int tx = firstX; tx <= lastX; ++tx) {
+            const int tile = ty * tilesX + tx;
+            if (h1 >= tileMin[tile] && h0 <= tileMax[tile]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void jmeHeightfieldTerrainShape::rayTest(const btVector3& from, const btVector3& to, btTriangleRaycastCallback* callback) const {
+    // grid space : o[0], o[1] along the grid, o[2] the raw height
+    const int axisX = m_upAxis == 0 ? 1 : 0;
+    const int axisY = m_upAxis == 2 ? 1 : 2;
+    const btVector3 scale = getLocalScaling();
+    if (scale[axisX] == 0 || scale[axisY] == 0 || scale[m_upAxis] == 0) {
+        btVector3 min = from;
+        btVector3 max = from;
+        min.setMin(to);
+        max.setMax(to);
+        btHeightfieldTerrainShape::processAllTriangles(callback, min, max);
+        return;
+    }
+    const btScalar width = btScalar(m_heightStickWidth - 1);
+    const btScalar length = btScalar(m_heightStickLength - 1);
+    btScalar o[3];
+    btScalar e[3];
+    o[0] = from[axisX] / scale[axisX] + width / 2;
+    o[1] = from[axisY] / scale[axisY] + length / 2;
+    o[2] = from[m_upAxis] / scale[m_upAxis] + m_localOrigin[m_upAxis];
+    e[0] = to[axisX] / scale[axisX] + width / 2;
+    e[1] = to[axisY] / scale[axisY] + length / 2;
+    e[2] = to[m_upAxis] / scale[m_upAxis] + m_localOrigin[m_upAxis];
+    btScalar d[3] = {e[0] - o[0], e[1] - o[1], e[2] - o[2]};
+
+    // clip the ray to the grid
+    btScalar t0 = 0;
+    btScalar t1 = 1;
+    const btScalar size[2] = {width, length};
+    for (int i = 0; i < 2; ++i) {
+        if (d[i] == 0) {
+            if (o[i] < 0 || o[i] > size[i]) {
+                return;
+            }
+        } else {
+            btScalar a = (0 - o[i]) / d[i];
+            btScalar b = (size[i] - o[i]) / d[i];
+            if (a > b) {
+                btSwap(a, b);
+            }
+            t0 = btMax(t0, a);
+            t1 = btMin(t1, b);
+        }
+    }
+    if (t0 > t1) {
+        return;
+    }
+
+    jmeGridWalk tiles(o, d, t0, JME_HEIGHTFIELD_TILE, 0, 0, tilesX - 1, tilesY - 1);
+    btScalar t = t0;
+    while (t <= t1 && t <= callback->m_hitFraction) {
+        const btScalar exit = btMin(tiles.exit(), t1);
+        const btScalar h0 = o[2] + d[2] * t;
+        const btScalar h1 = o[2] + d[2] * exit;
+        const int tile = tiles.y * tilesX + tiles.x;
+        if (btMax(h0, h1) >= tileMin[tile] && btMin(h0, h1) <= tileMax[tile]) {
+            if (rayTestCells(o, d, t, exit, tiles.x, tiles.y, callback)) {
+                return;
+            }
+        }
+        if (exit >= t1) {
+            return;
+        }
+        t = exit;
+        tiles.advance();
+        if (tiles.x < 0 || tiles.x >= tilesX || tiles.y < 0 || tiles.y >= tilesY) {
+            return;
+        }
+    }
+}
+
+bool jmeHeightfieldTerrainShape::rayTestCells(const btScalar* o, const btScalar* d, btScalar t0, btScalar t1, int tileX, int tileY, btTriangleRaycastCallback* callback) const {
+    const int firstX = tileX * JME_HEIGHTFIELD_TILE;
+    const int firstY = tileY * JME_HEIGHTFIELD_TILE;
+    const int lastX = btMin(m_heightStickWidth - 2, firstX + JME_HEIGHTFIELD_TILE - 1);
+    const int lastY = btMin(m_heightStickLength - 2, firstY + JME_HEIGHTFIELD_TILE - 1);
+    jmeGridWalk cells(o, d, t0, 1, firstX, firstY, lastX, lastY);
+    btScalar t = t0;
+    while (true) {
+        if (cells.x < firstX || cells.x > lastX || cells.y < firstY || cells.y > lastY) {
+            return false;
+        }
+        if (t > callback->m_hitFraction) {
+            // a closer hit has been found, stop the walk
+            return true;
+        }
+        const btScalar exit = btMin(cells.exit(), t1);
+        const btScalar h0 = o[2] + d[2] * t;
+        const btScalar h1 = o[2] + d[2] * exit;
+        const btScalar c00 = getRawHeightFieldValue(cells.x, cells.y);
+        const btScalar c10 = getRawHeightFieldValue(cells.x + 1, cells.y);
+        const btScalar c01 = getRawHeightFieldValue(cells.x, cells.y + 1);
+        const btScalar c11 = getRawHeightFieldValue(cells.x + 1, cells.y + 1);
+        const btScalar min = btMin(btMin(c00, c10), btMin(c01, c11));
+        const btScalar max = btMax(btMax(c00, c10), btMax(c01, c11));
+        if (btMax(h0, h1) >= min && btMin(h0, h1) <= max) {
+            processCell(cells.x, cells.y, callback);
+        }
+        if (exit >= t1) {
+            return false;
+        }
+        t = exit;
+        cells.advance();
+    }
+}
+
+// the hits of the local space ray of a terrain object, reported like the
+// bridge callback of btCollisionWorld::rayTestSingle
+struct jmeTerrainRayCallback : public btTriangleRaycastCallback {
+    btCollisionWorld::RayResultCallback* resultCallback;
+    const btCollisionObject* object;
+
+    jmeTerrainRayCallback(const btVector3& from, const btVector3& to, btCollisionWorld::RayResultCallback* resultCallback, const btCollisionObject* object)
+    : btTriangleRaycastCallback(from, to, resultCallback->m_flags), resultCallback(resultCallback), object(object) {
+    }
+
+    virtual btScalar reportHit(const btVector3& hitNormalLocal, btScalar hitFraction, int partId, int triangleIndex) {
+        btCollisionWorld::LocalShapeInfo shapeInfo;
+        shapeInfo.m_shapePart = partId;
+        shapeInfo.m_triangleIndex = triangleIndex;
+        const btVector3 hitNormalWorld = object->getWorldTransform().getBasis() * hitNormalLocal;
+        btCollisionWorld::LocalRayResult rayResult(object, &shapeInfo, hitNormalWorld, hitFraction);
+        return resultCallback->addSingleResult(rayResult, true);
+    }
+};
+
+// same broadphase walk than btCollisionWorld::rayTest, the terrains excepted
+struct jmeWorldRayCallback : public btBroadphaseRayCallback {
+    btVector3 from;
+    btVector3 to;
+    btTransform fromTransform;
+    btTransform toTransform;
+    btCollisionWorld::RayResultCallback& resultCallback;
+
+    jmeWorldRayCallback(const btVector3& from, const btVector3& to, btCollisionWorld::RayResultCallback& resultCallback)
+    : from(from), to(to), resultCallback(resultCallback) {
+        fromTransform.setIdentity();
+        fromTransform.setOrigin(from);
+        toTransform.setIdentity();
+        toTransform.setOrigin(to);
+        btVector3 direction = to - from;
+        direction.normalize();
+        for (int i = 0; i < 3; i++) {
+            m_rayDirectionInverse[i] = direction[i] == btScalar(0) ? btScalar(BT_LARGE_FLOAT) : btScalar(1) / direction[i];
+            m_signs[i] = m_rayDirectionInverse[i] < 0;
+        }
+        m_lambda_max = direction.dot(to - from);
+    }
+
+    virtual bool process(const btBroadphaseProxy* proxy) {
+        if (resultCallback.m_closestHitFraction == btScalar(0)) {
+            return false;
+        }
+        btCollisionObject* object = (btCollisionObject*) proxy->m_clientObject;
+        if (!resultCallback.needsCollision(object->getBroadphaseHandle())) {
+            return true;
+        }
+        const btCollisionShape* shape = object->getCollisionShape();
+        // all the terrain shapes are made by HeightfieldCollisionShape
+        if (shape->getShapeType() == TERRAIN_SHAPE_PROXYTYPE) {
+            const btTransform& transform = object->getWorldTransform();
+            jmeTerrainRayCallback callback(transform.invXform(from), transform.invXform(to), &resultCallback, object);
+            callback.m_hitFraction = resultCallback.m_closestHitFraction;
+            ((const jmeHeightfieldTerrainShape*) shape)->rayTest(callback.m_from, callback.m_to, &callback);
+        } else {
+            btCollisionWorld::rayTestSingle(fromTransform, toTransform, object, shape, object->getWorldTransform(), resultCallback);
+        }
+        return true;
+    }
+};
+
+void jmeHeightfieldTerrainShape::rayTest(btCollisionWorld* world, const btVector3& from, const btVector3& to, btCollisionWorld::RayResultCallback& callback) {
+    jmeWorldRayCallback rayCallback(from, to, callback);
+    world->getBroadphase()->rayTest(from, to, rayCallback);
+}
+
+struct jmeHeightfieldRefreshCallback : public btBroadphaseAabbCallback {
+    btAlignedObjectArray<btBroadphaseProxy*> proxies;
+
+    virtual bool process(const btBroadphaseProxy* proxy) {
+        proxies.push_back((btBroadphaseProxy*) proxy);
+        return true;
+    }
+};
+
+int jmeHeightfieldTerrainShape::refreshObjects(btCollisionWorld* world, btCollisionObject* terrain, int minX, int minY, int maxX, int maxY) {
+    btCollisionShape* shape = terrain->getCollisionShape();
+    btBroadphaseProxy* terrainProxy = terrain->getBroadphaseHandle();
+    if (shape->getShapeType() != TERRAIN_SHAPE_PROXYTYPE || terrainProxy == NULL) {
+        return 0;
+    }
+    jmeHeightfieldTerrainShape* heightfield = (jmeHeightfieldTerrainShape*) shape;
+    if (minX > maxX || minY > maxY) {
+        return 0;
+    }
+    // a changed height moves the cells around it, one more vertex on each side
+    minX = btMax(0, minX - 1);
+    minY = btMax(0, minY - 1);
+    maxX = btMin(heightfield->m_heightStickWidth - 1, maxX + 1);
+    maxY = btMin(heightfield->m_heightStickLength - 1, maxY + 1);
+    if (minX > maxX || minY > maxY) {
+        return 0;
+    }
+    // the bounds of the shape may have grown
+    world->updateSingleAabb(terrain);
+
+    btVector3 localMin, localMax;
+    heightfield->getLocalBounds(minX, minY, maxX, maxY, localMin, localMax);
+    btVector3 aabbMin, aabbMax;
+    btTransformAabb(localMin, localMax, shape->getMargin(), terrain->getWorldTransform(), aabbMin, aabbMax);
+
+    // collect first, the pairs are removed while walking them
+    jmeHeightfieldRefreshCallback callback;
+    world->getBroadphase()->aabbTest(aabbMin, aabbMax, callback);
+    btOverlappingPairCache* pairCache = world->getBroadphase()->getOverlappingPairCache();
+    int count = 0;
+    for (int i = 0; i < callback.proxies.size(); i++) {
+        btBroadphaseProxy* proxy = callback.proxies[i];
+        btCollisionObject* object = (btCollisionObject*) proxy->m_clientObject;
+        if (object == terrain) {
+            continue;
+        }
+        // the persistent contacts are kept on the previous heights otherwise
+        btBroadphasePair* pair = pairCache->findPair(terrainProxy, proxy);
+        if (pair != NULL) {
+            pairCache->cleanOverlappingPair(*pair, world->getDispatcher());
+        }
+        if (!object->isStaticOrKinematicObject()) {
+            object->activate();
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeHeightfieldTerrainShape
+#define _Included_jmeHeightfieldTerrainShape
+#include "btBulletCollisionCommon.h"
+#include "BulletCollision/CollisionShapes/btHeightfieldTerrainShape.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+// cells per tile side, for the tiles min/max heights
+#define JME_HEIGHTFIELD_TILE 16
+
+/**
+ * Heightfield shape with a fast ray test : the ray walks the grid (DDA),
+ * first by tiles skipped when the ray is above or below the tile min/max
+ * heights, then by cells. Only the triangles of the crossed cells are tested,
+ * instead of all the triangles in the bounding box of the ray.
+ * The fast walk is used by the world ray tests made through rayTest(world...),
+ * the rays made by bullet itself (vehicles) test the box of the ray.
+ *
+ * Author: dokthar
+ */
+class jmeHeightfieldTerrainShape : public btHeightfieldTerrainShape {
+public:
+    jmeHeightfieldTerrainShape(int heightStickWidth, int heightStickLength, const void* heightfieldData, btScalar heightScale, btScalar minHeight, btScalar maxHeight, int upAxis, PHY_ScalarType heightDataType, bool flipQuadEdges);
+
+    int getCellsPerRow() const {
+        return m_heightStickWidth - 1;
+    }
+
+    // the construction parameters, used by the physics recorder
+    int getHeightStickWidth() const {
+        return m_heightStickWidth;
+    }
+
+    int getHeightStickLength() const {
+        return m_heightStickLength;
+    }
+
+    const btScalar* getHeights() const {
+        return m_heightfieldDataFloat;
+    }
+
+    btScalar getHeightScale() const {
+        return m_heightScale;
+    }
+
+    btScalar getMinHeight() const {
+        return m_minHeight;
+    }
+
+    btScalar getMaxHeight() const {
+        return m_maxHeight;
+    }
+
+    int getUpAxis() const {
+        return m_upAxis;
+    }
+
+    bool getFlipQuadEdges() const {
+        return m_flipQuadEdges;
+    }
+
+    // recompute the min/max heights of the tiles covering the given vertexes
+    void updateTiles(int minX, int minY, int maxX, int maxY);
+
+    // the heights of the given vertexes were changed in the height data,
+    // update their tiles and grow the bounds around the same local origin if
+    // the new heights are out of them, return true if the bounds changed
+    bool heightsChanged(int minX, int minY, int maxX, int maxY);
+
+    // incremented on each height change, for the physics recorder
+    int getUpdateRevision() const {
+        return updateRevision;
+    }
+
+    // local space box of the given vertexes from the min to the max height,
+    // scaling applied
+    void getLocalBounds(int minX, int minY, int maxX, int maxY, btVector3& aabbMin, btVector3& aabbMax) const;
+
+    // false if the local space box is above or below all the tiles it covers
+    bool overlapsHeights(const btVector3& aabbMin, const btVector3& aabbMax) const;
+
+    // ray in local space, the triangles are given in order along the ray and
+    // the walk stop once the callback have a closer hit
+    void rayTest(const btVector3& from, const btVector3& to, btTriangleRaycastCallback* callback) const;
+
+    // ray test of the whole world, same results than btCollisionWorld::rayTest
+    // but the terrains use the fast walk. The shapes can't tell a ray from the
+    // triangle callback the world gives them, so the rays go through here
+    static void rayTest(btCollisionWorld* world, const btVector3& from, const btVector3& to, btCollisionWorld::RayResultCallback& callback);
+
+    // after a height change of the given vertexes : wake the objects over them
+    // and free their contacts with the terrain object made on the previous
+    // heights, return the number of objects woken
+    static int refreshObjects(btCollisionWorld* world, btCollisionObject* terrain, int minX, int minY, int maxX, int maxY);
+
+private:
+    int tilesX;
+    int tilesY;
+    btAlignedObjectArray<btScalar> tileMin;
+    btAlignedObjectArray<btScalar> tileMax;
+    int updateRevision;
+
+    void getTileRange(int minX, int minY, int maxX, int maxY, int& firstX, int& firstY, int& lastX, int& lastY) const;
+
+    void processCell(int x, int y, btTriangleCallback* callback) const;
+    bool rayTestCells(const btScalar* origin, const btScalar* direction, btScalar t0, btScalar t1, int tileX, int tileY, btTriangleRaycastCallback* callback) const;
+};
+#endif
@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeParallelBvh.h"
+#include "BulletMultiThreaded/btThreadSupportInterface.h"
+#ifdef _WIN32
+#include "BulletMultiThreaded/Win32ThreadSupport.h"
+#elif defined (USE_PTHREADS)
+#include "BulletMultiThreaded/PosixThreadSupport.h"
+#endif
+
+/**
+ * Author: dokthar
+ */
+#define JME_PARALLEL_BVH_THREADS 4
+#define JME_PARALLEL_BVH_BINS 16
+// triangles per leaf job, and the smallest subtree given to a thread
+#define JME_PARALLEL_BVH_MIN_JOB 4096
+
+struct jmeParallelBvhTask {
+    jmeParallelBvh* bvh;
+    btStridingMeshInterface* triangles;
+    btAlignedObjectArray<jmeParallelBvhJob> jobs;
+    int size;
+
+    void run() {
+        for (int i = 0; i < jobs.size(); i++) {
+            const jmeParallelBvhJob& job = jobs[i];
+            if (job.part >= 0) {
+                bvh->buildLeaves(triangles, job.part, job.begin, job.end, job.index);
+            } else {
+                bvh->buildSubtree(job.begin, job.end, job.index);
+            }
+        }
+    }
+};
+
+static void jmeParallelBvhThreadFunc(void* userPtr, void* lsMemory) {
+    jmeParallelBvhTask* task = (jmeParallelBvhTask*) userPtr;
+    task->run();
+}
+
+static void* jmeParallelBvhMemoryFunc() {
+    return NULL;
+}
+
+static btThreadSupportInterface* jmeParallelBvhStartThreads() {
+#ifdef _WIN32
+    Win32ThreadSupport::Win32ThreadConstructionInfo threadConstructionInfo("parallelBvh", jmeParallelBvhThreadFunc, jmeParallelBvhMemoryFunc, JME_PARALLEL_BVH_THREADS);
+    btThreadSupportInterface* threads = new Win32ThreadSupport(threadConstructionInfo);
+    threads->startSPU();
+    return threads;
+#elif defined (USE_PTHREADS)
+    PosixThreadSupport::ThreadConstructionInfo constructionInfo("parallelBvh", jmeParallelBvhThreadFunc,
+            jmeParallelBvhMemoryFunc, JME_PARALLEL_BVH_THREADS);
+    btThreadSupportInterface* threads = new PosixThreadSupport(constructionInfo);
+    threads->startSPU();
+    return threads;
+#else
+    return NULL;
+#endif
+}
+
+struct jmeParallelBvhJobGreater {
+
+    bool operator()(const jmeParallelBvhJob& a, const jmeParallelBvhJob& b) const {
+        return a.end - a.begin > b.end - b.begin;
+    }
+};
+
+// the biggest jobs first, each one to the least loaded thread
+static void jmeParallelBvhRun(btThreadSupportInterface* threads, jmeParallelBvh* bvh, btStridingMeshInterface* triangles, btAlignedObjectArray<jmeParallelBvhJob>& jobs) {
+    jmeParallelBvhTask task[JME_PARALLEL_BVH_THREADS];
+    int tasks = threads == NULL ? 1 : btMax(1, btMin(JME_PARALLEL_BVH_THREADS, jobs.size()));
+    for (int i = 0; i < tasks; i++) {
+        task[i].bvh = bvh;
+        task[i].triangles = triangles;
+        task[i].size = 0;
+    }
+    jobs.quickSort(jmeParallelBvhJobGreater());
+    for (int i = 0; i < jobs.size(); i++) {
+        int best = 0;
+        for (int j = 1; j < tasks; j++) {
+            if (task[j].size < task[best].size) {
+                best = j;
+            }
+        }
+        task[best].jobs.push_back(jobs[i]);
+        task[best].size += jobs[i].end - jobs[i].begin;
+    }
+    if (tasks < 2) {
+        task[0].run();
+        return;
+    }
+    for (int i = 0; i < tasks; i++) {
+        threads->sendRequest(1, (ppu_address_t) & task[i], i);
+    }
+    for (int i = 0; i < tasks; i++) {
+        unsigned int taskId;
+        unsigned int status;
+        threads->waitForResponse(&taskId, &status);
+    }
+}
+
+bool jmeParallelBvh::isSupported(btStridingMeshInterface* triangles) {
+    if (triangles->getNumSubParts() > (1 << MAX_NUM_PARTS_IN_BITS)) {
+        return false;
+    }
+    for (int part = 0; part < triangles->getNumSubParts(); part++) {
+        const unsigned char* vertexbase;
+        int numverts;
+        PHY_ScalarType type;
+        int stride;
+        const unsigned char* indexbase;
+        int indexstride;
+        int numfaces;
+        PHY_ScalarType indicestype;
+        triangles->getLockedReadOnlyVertexIndexBase(&vertexbase, numverts, type, stride, &indexbase, indexstride, numfaces, indicestype, part);
+        triangles->unLockReadOnlyVertexBase(part);
+        if (numfaces > (1 << (31 - MAX_NUM_PARTS_IN_BITS))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void jmeParallelBvh::buildParallel(btStridingMeshInterface* triangles, const btVector3& bvhAabbMin, const btVector3& bvhAabbMax) {
+    m_useQuantization = true;
+    setQuantizationValues(bvhAabbMin, bvhAabbMax);
+    m_SubtreeHeaders.resize(0);
+    m_curNodeIndex = 0;
+
+    btThreadSupportInterface* threads = jmeParallelBvhStartThreads();
+    btAlignedObjectArray<jmeParallelBvhJob> jobs;
+    int numLeafNodes = 0;
+    for (int part = 0; part < triangles->getNumSubParts(); part++) {
+        const unsigned char* vertexbase;
+        int numverts;
+        PHY_ScalarType type;
+        int stride;
+        const unsigned char* indexbase;
+        int indexstride;
+        int numfaces;
+        PHY_ScalarType indicestype;
+        triangles->getLockedReadOnlyVertexIndexBase(&vertexbase, numverts, type, stride, &indexbase, indexstride, numfaces, indicestype, part);
+        triangles->unLockReadOnlyVertexBase(part);
+        for (int begin = 0; begin < numfaces; begin += JME_PARALLEL_BVH_MIN_JOB) {
+            jmeParallelBvhJob& job = jobs.expand();
+            job.part = part;
+            job.begin = begin;
+            job.end = btMin(begin + JME_PARALLEL_BVH_MIN_JOB, numfaces);
+            job.index = numLeafNodes + begin;
+        }
+        numLeafNodes += numfaces;
+    }
+    m_quantizedLeafNodes.resize(numLeafNodes);
+    m_quantizedContiguousNodes.resize(2 * numLeafNodes);
+    jmeParallelBvhRun(threads, this, triangles, jobs);
+
+    if (numLeafNodes > 0) {
+        // a few subtrees per thread, to balance the uneven splits
+        int maxSubtree = threads == NULL ? numLeafNodes : btMax(JME_PARALLEL_BVH_MIN_JOB, numLeafNodes / (JME_PARALLEL_BVH_THREADS * 4));
+        btAlignedObjectArray<int> topNodes;
+        jobs.resize(0);
+        splitTop(0, numLeafNodes, 0, maxSubtree, jobs, topNodes);
+        jmeParallelBvhRun(threads, this, triangles, jobs);
+        // the children of a top node come after it
+        for (int i = topNodes.size() - 2; i >= 0; i -= 2) {
+            int nodeIndex = topNodes[i];
+            int leftIndex = nodeIndex + 1;
+            const btQuantizedBvhNode& left = m_quantizedContiguousNodes[leftIndex];
+            int rightIndex = leftIndex + (left.isLeafNode() ? 1 : left.getEscapeIndex());
+            setInternalNode(nodeIndex, leftIndex, rightIndex, topNodes[i + 1]);
+        }
+        m_curNodeIndex = 2 * numLeafNodes - 1;
+        addSubtreeHeaders(0);
+        // the whole tree is smaller than a subtree
+        if (m_SubtreeHeaders.size() == 0) {
+            btBvhSubtreeInfo& subtree = m_SubtreeHeaders.expand();
+            subtree.setAabbFromQuantizeNode(m_quantizedContiguousNodes[0]);
+            subtree.m_rootNodeIndex = 0;
+            subtree.m_subtreeSize = m_quantizedContiguousNodes[0].isLeafNode() ? 1 : m_quantizedContiguousNodes[0].getEscapeIndex();
+        }
+    }
+    m_subtreeHeaderCount = m_SubtreeHeaders.size();
+    m_quantizedLeafNodes.clear();
+    m_leafNodes.clear();
+
+    if (threads != NULL) {
+        threads->stopSPU();
+        delete(threads);
+    }
+}
+
+void jmeParallelBvh::buildLeaves(btStridingMeshInterface* triangles, int part, int begin, int end, int leafIndex) {
+    const unsigned char* vertexbase;
+    int numverts;
+    PHY_ScalarType type;
+    int stride;
+    const unsigned char* indexbase;
+    int indexstride;
+    int numfaces;
+    PHY_ScalarType indicestype;
+    triangles->getLockedReadOnlyVertexIndexBase(&vertexbase, numverts, type, stride, &indexbase, indexstride, numfaces, indicestype, part);
+    const btVector3& scaling = triangles->getScaling();
+    // same as the leaves of btOptimizedBvh::build
+    const btScalar MIN_AABB_DIMENSION = btScalar(0.002);
+    const btScalar MIN_AABB_HALF_DIMENSION = btScalar(0.001);
+    for (int i = begin; i < end; i++) {
+        const unsigned char* index = indexbase + i * indexstride;
+        btVector3 aabbMin(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+        btVector3 aabbMax(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+        for (int j = 0; j < 3; j++) {
+            int vertexIndex;
+            if (indicestype == PHY_INTEGER) {
+                vertexIndex = ((const unsigned int*) index)[j];
+            } else if (indicestype == PHY_SHORT) {
+                vertexIndex = ((const unsigned short*) index)[j];
+            } else {
+                vertexIndex = ((const unsigned char*) index)[j];
+            }
+            btVector3 vertex;
+            if (type == PHY_DOUBLE) {
+                const double* v = (const double*) (vertexbase + vertexIndex * stride);
+                vertex.setValue(btScalar(v[0]) * scaling.getX(), btScalar(v[1]) * scaling.getY(), btScalar(v[2]) * scaling.getZ());
+            } else {
+                const float* v = (const float*) (vertexbase + vertexIndex * stride);
+                vertex.setValue(v[0] * scaling.getX(), v[1] * scaling.getY(), v[2] * scaling.getZ());
+            }
+            aabbMin.setMin(vertex);
+            aabbMax.setMax(vertex);
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            if (aabbMax[axis] - aabbMin[axis] < MIN_AABB_DIMENSION) {
+                aabbMax[axis] += MIN_AABB_HALF_DIMENSION;
+                aabbMin[axis] -= MIN_AABB_HALF_DIMENSION;
+            }
+        }
+        btQuantizedBvhNode& node = m_quantizedLeafNodes[leafIndex + i - begin];
+        quantize(&node.m_quantizedAabbMin[0], aabbMin, 0);
+        quantize(&node.m_quantizedAabbMax[0], aabbMax, 1);
+        node.m_escapeIndexOrTriangleIndex = (part << (31 - MAX_NUM_PARTS_IN_BITS)) | i;
+    }
+    triangles->unLockReadOnlyVertexBase(part);
+}
+
+void jmeParallelBvh::splitTop(int begin, int end, int nodeIndex, int maxSubtree, btAlignedObjectArray<jmeParallelBvhJob>& subtrees, btAlignedObjectArray<int>& topNodes) {
+    if (end - begin <= maxSubtree) {
+        jmeParallelBvhJob& job = subtrees.expand();
+        job.part = -1;
+        job.begin = begin;
+        job.end = end;
+        job.index = nodeIndex;
+        return;
+    }
+    topNodes.push_back(nodeIndex);
+    topNodes.push_back(2 * (end - begin) - 1);
+    int mid = split(begin, end);
+    int leftIndex = nodeIndex + 1;
+    splitTop(begin, mid, leftIndex, maxSubtree, subtrees, topNodes);
+    splitTop(mid, end, leftIndex + 2 * (mid - begin) - 1, maxSubtree, subtrees, topNodes);
+}
+
+void jmeParallelBvh::buildSubtree(int begin, int end, int nodeIndex) {
+    if (end - begin == 1) {
+        m_quantizedContiguousNodes[nodeIndex] = m_quantizedLeafNodes[begin];
+        return;
+    }
+    int mid = split(begin, end);
+    int leftIndex = nodeIndex + 1;
+    int rightIndex = leftIndex + 2 * (mid - begin) - 1;
+    buildSubtree(begin, mid, leftIndex);
+    buildSubtree(mid, end, rightIndex);
+    setInternalNode(nodeIndex, leftIndex, rightIndex, 2 * (end - begin) - 1);
+}
+
+void jmeParallelBvh::setInternalNode(int nodeIndex, int leftIndex, int rightIndex, int escapeIndex) {
+    btQuantizedBvhNode& node = m_quantizedContiguousNodes[nodeIndex];
+    const btQuantizedBvhNode& left = m_quantizedContiguousNodes[leftIndex];
+    const btQuantizedBvhNode& right = m_quantizedContiguousNodes[rightIndex];
+    for (int axis = 0; axis < 3; axis++) {
+        node.m_quantizedAabbMin[axis] = btMin(left.m_quantizedAabbMin[axis], right.m_quantizedAabbMin[axis]);
+        node.m_quantizedAabbMax[axis] = btMax(left.m_quantizedAabbMax[axis], right.m_quantizedAabbMax[axis]);
+    }
+    node.m_escapeIndexOrTriangleIndex = -escapeIndex;
+}
+
+// same headers, in the same order, as btQuantizedBvh::buildTree
+void jmeParallelBvh::addSubtreeHeaders(int nodeIndex) {
+    const btQuantizedBvhNode& node = m_quantizedContiguousNodes[nodeIndex];
+    if (node.isLeafNode() || node.getEscapeIndex() * (int) sizeof (btQuantizedBvhNode) <= MAX_SUBTREE_SIZE_IN_BYTES) {
+        return;
+    }
+    int leftIndex = nodeIndex + 1;
+    const btQuantizedBvhNode& left = m_quantizedContiguousNodes[leftIndex];
+    int rightIndex = leftIndex + (left.isLeafNode() ? 1 : left.getEscapeIndex());
+    addSubtreeHeaders(leftIndex);
+    addSubtreeHeaders(rightIndex);
+    updateSubtreeHeaders(leftIndex, rightIndex);
+}
+
+struct jmeParallelBvhBin {
+    int count;
+    unsigned short aabbMin[3];
+    unsigned short aabbMax[3];
+
+    void clear() {
+        count = 0;
+        for (int axis = 0; axis < 3; axis++) {
+            aabbMin[axis] = 0xffff;
+            aabbMax[axis] = 0;
+        }
+    }
+
+    void merge(const unsigned short* otherMin, const unsigned short* otherMax) {
+        for (int axis = 0; axis < 3; axis++) {
+            aabbMin[axis] = btMin(aabbMin[axis], otherMin[axis]);
+            aabbMax[axis] = btMax(aabbMax[axis], otherMax[axis]);
+        }
+    }
+
+    // integer surface heuristic, the splits do not depend on the compiler
+    unsigned long long cost() const {
+        unsigned long long x = aabbMax[0] - aabbMin[0];
+        unsigned long long y = aabbMax[1] - aabbMin[1];
+        unsigned long long z = aabbMax[2] - aabbMin[2];
+        return (x * y + y * z + z * x) * count;
+    }
+};
+
+// twice the centroid of a leaf, in the quantized space
+static inline int jmeParallelBvhCentroid(const btQuantizedBvhNode& node, int axis) {
+    return node.m_quantizedAabbMin[axis] + node.m_quantizedAabbMax[axis];
+}
+
+struct jmeParallelBvhCentroidLess {
+    int axis;
+
+    bool operator()(const btQuantizedBvhNode& a, const btQuantizedBvhNode& b) const {
+        int ca = jmeParallelBvhCentroid(a, axis);
+        int cb = jmeParallelBvhCentroid(b, axis);
+        // the triangle index makes the order total
+        return ca < cb || (ca == cb && a.m_escapeIndexOrTriangleIndex < b.m_escapeIndexOrTriangleIndex);
+    }
+};
+
+// quickselect : the leaf at nth is the one a full sort would put there, the
+// lesser leaves before it and the greater ones after
+static void jmeParallelBvhSelect(btQuantizedBvhNode* leaves, int begin, int end, int nth, const jmeParallelBvhCentroidLess& less) {
+    int left = begin;
+    int right = end - 1;
+    while (left < right) {
+        // median of three, the pivot stays inside the range
+        int middle = left + (right - left) / 2;
+        if (less(leaves[middle], leaves[left])) {
+            btSwap(leaves[middle], leaves[left]);
+        }
+        if (less(leaves[right], leaves[left])) {
+            btSwap(leaves[right], leaves[left]);
+        }
+        if (less(leaves[right], leaves[middle])) {
+            btSwap(leaves[right], leaves[middle]);
+        }
+        const btQuantizedBvhNode pivot = leaves[middle];
+        int i = left;
+        int j = right;
+        while (i <= j) {
+            while (less(leaves[i], pivot)) {
+                i++;
+            }
+            while (less(pivot, leaves[j])) {
+                j--;
+            }
+            if (i <= j) {
+                btSwap(leaves[i], leaves[j]);
+                i++;
+                j--;
+            }
+        }
+        // [left, j] are not greater than the pivot, [i, right] not lesser
+        if (nth <= j) {
+            right = j;
+        } else if (nth >= i) {
+            left = i;
+        } else {
+            return;
+        }
+    }
+}
+
+int jmeParallelBvh::split(int begin, int end) {
+    btQuantizedBvhNode* leaves = &m_quantizedLeafNodes[0];
+    int count = end - begin;
+    int centroidMin[3] = {0x7fffffff, 0x7fffffff, 0x7fffffff};
+    int centroidMax[3] = {-1, -1, -1};
+    for (int i = begin; i < end; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            int centroid = jmeParallelBvhCentroid(leaves[i], axis);
+            centroidMin[axis] = btMin(centroidMin[axis], centroid);
+            centroidMax[axis] = btMax(centroidMax[axis], centroid);
+        }
+    }
+    int axis = 0;
+    for (int i = 1; i < 3; i++) {
+        if (centroidMax[i] - centroidMin[i] > centroidMax[axis] - centroidMin[axis]) {
+            axis = i;
+        }
+    }
+    int extent = centroidMax[axis] - centroidMin[axis];
+    if (extent == 0) {
+        // all the centroids are the same, any split will do
+        return begin + count / 2;
+    }
+
+    jmeParallelBvhBin bins[JME_PARALLEL_BVH_BINS];
+    for (int i = 0; i < JME_PARALLEL_BVH_BINS; i++) {
+        bins[i].clear();
+    }
+    for (int i = begin; i < end; i++) {
+        int bin = (jmeParallelBvhCentroid(leaves[i], axis) - centroidMin[axis]) * JME_PARALLEL_BVH_BINS / (extent + 1);
+        bins[bin].count++;
+        bins[bin].merge(leaves[i].m_quantizedAabbMin, leaves[i].m_quantizedAabbMax);
+    }
+    unsigned long long rightCost[JME_PARALLEL_BVH_BINS];
+    jmeParallelBvhBin accumulated;
+    accumulated.clear();
+    for (int i = JME_PARALLEL_BVH_BINS - 1; i > 0; i--) {
+        accumulated.count += bins[i].count;
+        accumulated.merge(bins[i].aabbMin, bins[i].aabbMax);
+        rightCost[i] = accumulated.cost();
+    }
+    accumulated.clear();
+    int bestBin = -1;
+    int bestCount = 0;
+    unsigned long long bestCost = 0;
+    for (int i = 0; i < JME_PARALLEL_BVH_BINS - 1; i++) {
+        accumulated.count += bins[i].count;
+        accumulated.merge(bins[i].aabbMin, bins[i].aabbMax);
+        if (accumulated.count == 0 || accumulated.count == count) {
+            continue;
+        }
+        unsigned long long cost = accumulated.cost() + rightCost[i + 1];
+        if (bestBin < 0 || cost < bestCost) {
+            bestBin = i;
+            bestCost = cost;
+            bestCount = accumulated.count;
+        }
+    }
+
+    // keep the tree depth, and the recursion, bounded
+    if (bestCount < count / 8 || count - bestCount < count / 8) {
+        int mid = begin + count / 2;
+        jmeParallelBvhCentroidLess less;
+        less.axis = axis;
+        jmeParallelBvhSelect(leaves, begin, end, mid, less);
+        return mid;
+    }
+    int i = begin;
+    int j = end - 1;
+    while (i <= j) {
+        int bin = (jmeParallelBvhCentroid(leaves[i], axis) - centroidMin[axis]) * JME_PARALLEL_BVH_BINS / (extent + 1);
+        if (bin <= bestBin) {
+            i++;
+        } else {
+            btQuantizedBvhNode tmp = leaves[i];
+            leaves[i] = leaves[j];
+            leaves[j] = tmp;
+            j--;
+        }
+    }
+    return begin + bestCount;
+}
+
+jmeParallelBvhTriangleMeshShape::jmeParallelBvhTriangleMeshShape(btStridingMeshInterface* meshInterface)
+: btBvhTriangleMeshShape(meshInterface, true, false) {
+    void* mem = btAlignedAlloc(sizeof (jmeParallelBvh), 16);
+    parallelBvh = new(mem) jmeParallelBvh();
+    parallelBvh->buildParallel(meshInterface, getLocalAabbMin(), getLocalAabbMax());
+    // not owned by the base shape, so it is never rebuilt with the serial builder
+    setOptimizedBvh(parallelBvh);
+}
+
+jmeParallelBvhTriangleMeshShape::~jmeParallelBvhTriangleMeshShape() {
+    parallelBvh->~jmeParallelBvh();
+    btAlignedFree(parallelBvh);
+}
+
+void jmeParallelBvhTriangleMeshShape::setLocalScaling(const btVector3& scaling) {
+    if ((getLocalScaling() - scaling).length2() > SIMD_EPSILON) {
+        btTriangleMeshShape::setLocalScaling(scaling);
+        parallelBvh->buildParallel(getMeshInterface(), getLocalAabbMin(), getLocalAabbMax());
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeParallelBvh
+#define _Included_jmeParallelBvh
+#include "btBulletDynamicsCommon.h"
+#include "BulletCollision/CollisionShapes/btOptimizedBvh.h"
+
+// a triangle range of a part for the leaves, or a subtree when part is -1
+struct jmeParallelBvhJob {
+    int part;
+    int begin;
+    int end;
+    int index;
+};
+
+/**
+ * A quantized BVH built on several threads. The nodes use the btOptimizedBvh
+ * layout, so the Bullet traversal, serialization and refit work unchanged.
+ * The triangle aabbs are computed in parallel, the top of the tree is split on
+ * the calling thread until there are enough subtrees, then the subtrees are
+ * built in parallel, in place : a subtree of n triangles always has 2n-1
+ * nodes, so each one is written at a known offset.
+ * The splits use a binned SAH on the quantized centroids, with a median split
+ * when the SAH split is too unbalanced. The tree only depends on the
+ * triangles, not on the thread count or the scheduling.
+ *
+ * Author: dokthar
+ */
+class jmeParallelBvh : public btOptimizedBvh {
+public:
+    void buildParallel(btStridingMeshInterface* triangles, const btVector3& bvhAabbMin, const btVector3& bvhAabbMax);
+    void buildLeaves(btStridingMeshInterface* triangles, int part, int begin, int end, int leafIndex);
+    void buildSubtree(int begin, int end, int nodeIndex);
+
+    // false if a part has more triangles than the node encoding allows
+    static bool isSupported(btStridingMeshInterface* triangles);
+
+private:
+    void splitTop(int begin, int end, int nodeIndex, int maxSubtree, btAlignedObjectArray<jmeParallelBvhJob>& subtrees, btAlignedObjectArray<int>& topNodes);
+    int split(int begin, int end);
+    void setInternalNode(int nodeIndex, int leftIndex, int rightIndex, int escapeIndex);
+    void addSubtreeHeaders(int nodeIndex);
+};
+
+/**
+ * A bvh triangle mesh shape using a jmeParallelBvh, rebuilt in parallel when
+ * the scaling changes.
+ *
+ * Author: dokthar
+ */
+class jmeParallelBvhTriangleMeshShape : public btBvhTriangleMeshShape {
+public:
+    jmeParallelBvhTriangleMeshShape(btStridingMeshInterface* meshInterface);
+    virtual ~jmeParallelBvhTriangleMeshShape();
+
+    virtual void setLocalScaling(const btVector3& scaling);
+
+private:
+    jmeParallelBvh* parallelBvh;
+};
+#endif
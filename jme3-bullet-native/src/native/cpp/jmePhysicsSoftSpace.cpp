@@ -31,6 +31,8 @@
  */
 #include "jmePhysicsSoftSpace.h"
 #include "jmeBulletUtil.h"
+#include "jmeCollisionAlgorithms.h"
+#include "jmeSoftBodyExt.h"
 #include <stdio.h>
 
 /**
@@ -48,6 +50,7 @@ void jmePhysicsSoftSpace::createPhysicsSoftSpace(jobject min_vec, jobject max_ve
     //    if(threading){
     //        cci.m_defaultMaxPersistentManifoldPoolSize = 32768;
     //    }
+    cci.m_customCollisionAlgorithmMaxElementSize = jmeSphereCapsuleConcaveAlgorithm::getMaxElementSize();
 
     btVector3 min = btVector3();
     btVector3 max = btVector3();
@@ -78,7 +81,7 @@ void jmePhysicsSoftSpace::createPhysicsSoftSpace(jobject min_vec, jobject max_ve
             break;
     }
 
-    btSoftBodyRigidBodyCollisionConfiguration* collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration();
+    btSoftBodyRigidBodyCollisionConfiguration* collisionConfiguration = new btSoftBodyRigidBodyCollisionConfiguration(cci);
 
     btCollisionDispatcher* dispatcher;
     // use the default collision dispatcher. For parallel processing you can use a different dispatcher (see Extras/BulletMultiThreaded)
@@ -89,6 +92,8 @@ void jmePhysicsSoftSpace::createPhysicsSoftSpace(jobject min_vec, jobject max_ve
     } else {
         dispatcher = new btCollisionDispatcher(collisionConfiguration);
     }
+    // sphere and capsule versus mesh and heightfield contacts
+    jmeSphereCapsuleConcaveAlgorithm::registerAlgorithms(dispatcher);
 
 
 
@@ -142,6 +147,9 @@ void jmePhysicsSoftSpace::createPhysicsSoftSpace(jobject min_vec, jobject max_ve
                 jmeUserPointer *up0 = (jmeUserPointer*) co0 -> getUserPointer();
                 jmeUserPointer *up1 = (jmeUserPointer*) co1 -> getUserPointer();
                 if (up0 != NULL && up1 != NULL) {
+                    if (!jmeFrozenRegions::needsPair(co0, co1)) {
+                        return false;
+                    }
                     collides = (up0->group & up1->groups) != 0;
                     collides = collides && (up1->group & up0->groups);
 
@@ -154,13 +162,31 @@ void jmePhysicsSoftSpace::createPhysicsSoftSpace(jobject min_vec, jobject max_ve
         }
     };
     dynamicsWorld->getPairCache()->setOverlapFilterCallback(new jmeFilterCallback());
-    dynamicsWorld->setInternalTickCallback(&jmePhysicsSpace::preTickCallback, static_cast<void *> (this), true);
-    dynamicsWorld->setInternalTickCallback(&jmePhysicsSpace::postTickCallback, static_cast<void *> (this));
+    dynamicsWorld->setInternalTickCallback(&jmePhysicsSoftSpace::preTickCallback, static_cast<void *> (this), true);
+    dynamicsWorld->setInternalTickCallback(&jmePhysicsSoftSpace::postTickCallback, static_cast<void *> (this));
     if (gContactProcessedCallback == NULL) {
         gContactProcessedCallback = &jmePhysicsSpace::contactProcessedCallback;
     }
 }
 
+void jmePhysicsSoftSpace::preTickCallback(btDynamicsWorld *world, btScalar timeStep) {
+    jmePhysicsSpace::preTickCallback(world, timeStep);
+    // native soft body features, after the java listeners so they get the last word
+    btSoftBodyArray& softBodies = ((btSoftRigidDynamicsWorld*) world)->getSoftBodyArray();
+    for (int i = 0; i < softBodies.size(); ++i) {
+        jmeSoftBodyExt::preTick(softBodies[i], timeStep);
+    }
+}
+
+void jmePhysicsSoftSpace::postTickCallback(btDynamicsWorld *world, btScalar timeStep) {
+    // called before bullet solve the soft bodies constraints
+    btSoftBodyArray& softBodies = ((btSoftRigidDynamicsWorld*) world)->getSoftBodyArray();
+    for (int i = 0; i < softBodies.size(); ++i) {
+        jmeSoftBodyExt::postTick(softBodies[i], timeStep);
+    }
+    jmePhysicsSpace::postTickCallback(world, timeStep);
+}
+
 btSoftRigidDynamicsWorld* jmePhysicsSoftSpace::getSoftDynamicsWorld() {
     return (btSoftRigidDynamicsWorld*) dynamicsWorld;
 }
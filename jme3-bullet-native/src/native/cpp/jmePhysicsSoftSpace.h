@@ -46,4 +46,6 @@ public:
         // Signature: (Lcom/jme3/math/Vector3f;Lcom/jme3/math/Vector3f;IZ)V
         void createPhysicsSoftSpace(jobject, jobject, jint, jboolean);
         btSoftRigidDynamicsWorld* getSoftDynamicsWorld();
+        static void preTickCallback(btDynamicsWorld*, btScalar);
+        static void postTickCallback(btDynamicsWorld*, btScalar);
 };
\ No newline at end of file
@@ -31,12 +31,15 @@
  */
 #include "jmePhysicsSpace.h"
 #include "jmeBulletUtil.h"
+#include "jmeCollisionAlgorithms.h"
+#include "jmeContactRules.h"
 #include <stdio.h>
 
 /**
  * Author: Normen Hansen
  */
-jmePhysicsSpace::jmePhysicsSpace(JNIEnv* env, jobject javaSpace) {
+jmePhysicsSpace::jmePhysicsSpace(JNIEnv* env, jobject javaSpace)
+: projectiles(NULL), debugDraw(NULL), simulationLod(NULL), frozenRegions(NULL), tickPlugins(NULL), forceFields(NULL), ghostFilter(NULL), costProfiler(NULL), recorder(NULL), frictionCaching(false), exactOverlapGhosts(0), javaTickCallbacks(true) {
     //TODO: global ref? maybe not -> cleaning, rather callback class?
     this->javaPhysicsSpace = env->NewWeakGlobalRef(javaSpace);
     this->env = env;
@@ -63,7 +66,16 @@ JNIEnv* jmePhysicsSpace::getEnv() {
 }
 
 void jmePhysicsSpace::stepSimulation(jfloat tpf, jint maxSteps, jfloat accuracy) {
+    if (recorder != NULL) {
+        recorder->step(tpf, maxSteps, accuracy);
+    }
     dynamicsWorld->stepSimulation(tpf, maxSteps, accuracy);
+    if (exactOverlapGhosts > 0) {
+        if (ghostFilter == NULL) {
+            ghostFilter = new jmeGhostFilter();
+        }
+        ghostFilter->filter(dynamicsWorld);
+    }
 }
 
 btThreadSupportInterface* jmePhysicsSpace::createSolverThreadSupport(int maxNumThreads) {
@@ -108,6 +120,7 @@ void jmePhysicsSpace::createPhysicsSpace(jfloat minX, jfloat minY, jfloat minZ,
     //    if(threading){
     //        cci.m_defaultMaxPersistentManifoldPoolSize = 32768;
     //    }
+    cci.m_customCollisionAlgorithmMaxElementSize = jmeSphereCapsuleConcaveAlgorithm::getMaxElementSize();
     btCollisionConfiguration* collisionConfiguration = new btDefaultCollisionConfiguration(cci);
 
     btVector3 min = btVector3(minX, minY, minZ);
@@ -147,6 +160,8 @@ void jmePhysicsSpace::createPhysicsSpace(jfloat minX, jfloat minY, jfloat minZ,
     } else {
         dispatcher = new btCollisionDispatcher(collisionConfiguration);
     }
+    // sphere and capsule versus mesh and heightfield contacts
+    jmeSphereCapsuleConcaveAlgorithm::registerAlgorithms(dispatcher);
 
     // the default constraint solver. For parallel processing you can use a different solver (see Extras/BulletMultiThreaded)
     if (threading) {
@@ -187,6 +202,9 @@ void jmePhysicsSpace::createPhysicsSpace(jfloat minX, jfloat minY, jfloat minZ,
                 jmeUserPointer *up0 = (jmeUserPointer*) co0 -> getUserPointer();
                 jmeUserPointer *up1 = (jmeUserPointer*) co1 -> getUserPointer();
                 if (up0 != NULL && up1 != NULL) {
+                    if (!jmeFrozenRegions::needsPair(co0, co1)) {
+                        return false;
+                    }
                     collides = (up0->group & up1->groups) != 0 || (up1->group & up0->groups) != 0;
                     
                     if(collides){
@@ -228,20 +246,66 @@ void jmePhysicsSpace::createPhysicsSpace(jfloat minX, jfloat minY, jfloat minZ,
 
 void jmePhysicsSpace::preTickCallback(btDynamicsWorld *world, btScalar timeStep) {
     jmePhysicsSpace* dynamicsWorld = (jmePhysicsSpace*) world->getWorldUserInfo();
-    JNIEnv* env = dynamicsWorld->getEnv();
-    jobject javaPhysicsSpace = env->NewLocalRef(dynamicsWorld->getJavaPhysicsSpace());
-    if (javaPhysicsSpace != NULL) {
-        env->CallVoidMethod(javaPhysicsSpace, jmeClasses::PhysicsSpace_preTick, timeStep);
-        env->DeleteLocalRef(javaPhysicsSpace);
-        if (env->ExceptionCheck()) {
-            env->Throw(env->ExceptionOccurred());
-            return;
+    if (dynamicsWorld->forceFields != NULL) {
+        dynamicsWorld->forceFields->apply(world, timeStep);
+    }
+    if (dynamicsWorld->simulationLod != NULL) {
+        dynamicsWorld->simulationLod->preTick(world);
+    }
+    if (dynamicsWorld->tickPlugins != NULL) {
+        dynamicsWorld->tickPlugins->preTick(world, timeStep);
+    }
+    if (dynamicsWorld->javaTickCallbacks) {
+        JNIEnv* env = dynamicsWorld->getEnv();
+        jobject javaPhysicsSpace = env->NewLocalRef(dynamicsWorld->getJavaPhysicsSpace());
+        if (javaPhysicsSpace != NULL) {
+            env->CallVoidMethod(javaPhysicsSpace, jmeClasses::PhysicsSpace_preTick, timeStep);
+            env->DeleteLocalRef(javaPhysicsSpace);
+            if (env->ExceptionCheck()) {
+                env->Throw(env->ExceptionOccurred());
+            }
         }
     }
+    // the materials edited until now, java listeners included
+    jmeContactRules::update(dynamicsWorld->contactRules);
+    btContactSolverInfo& solverInfo = world->getSolverInfo();
+    if (dynamicsWorld->contactRules.useSurfaceVelocity()) {
+        // the surface velocities are given as cached friction directions
+        if (!(solverInfo.m_solverMode & SOLVER_ENABLE_FRICTION_DIRECTION_CACHING)) {
+            solverInfo.m_solverMode |= SOLVER_ENABLE_FRICTION_DIRECTION_CACHING;
+            dynamicsWorld->frictionCaching = true;
+        }
+    } else if (dynamicsWorld->frictionCaching) {
+        solverInfo.m_solverMode &= ~SOLVER_ENABLE_FRICTION_DIRECTION_CACHING;
+        dynamicsWorld->frictionCaching = false;
+    }
+    // after all the changes made before the tick
+    if (dynamicsWorld->recorder != NULL) {
+        dynamicsWorld->recorder->preTick(world, timeStep);
+    }
 }
 
 void jmePhysicsSpace::postTickCallback(btDynamicsWorld *world, btScalar timeStep) {
     jmePhysicsSpace* dynamicsWorld = (jmePhysicsSpace*) world->getWorldUserInfo();
+    // before any change made after the tick
+    if (dynamicsWorld->recorder != NULL) {
+        dynamicsWorld->recorder->postTick(world);
+    }
+    if (dynamicsWorld->costProfiler != NULL) {
+        dynamicsWorld->costProfiler->postTick(world, timeStep);
+    }
+    if (dynamicsWorld->simulationLod != NULL) {
+        dynamicsWorld->simulationLod->postTick(world);
+    }
+    if (dynamicsWorld->projectiles != NULL) {
+        dynamicsWorld->projectiles->step(world, world->getGravity(), timeStep);
+    }
+    if (dynamicsWorld->tickPlugins != NULL) {
+        dynamicsWorld->tickPlugins->postTick(world, timeStep);
+    }
+    if (!dynamicsWorld->javaTickCallbacks) {
+        return;
+    }
     JNIEnv* env = dynamicsWorld->getEnv();
     jobject javaPhysicsSpace = env->NewLocalRef(dynamicsWorld->getJavaPhysicsSpace());
     if (javaPhysicsSpace != NULL) {
@@ -260,6 +324,12 @@ bool jmePhysicsSpace::contactProcessedCallback(btManifoldPoint &cp, void *body0,
     jmeUserPointer *up0 = (jmeUserPointer*) co0 -> getUserPointer();
     btCollisionObject* co1 = (btCollisionObject*) body1;
     jmeUserPointer *up1 = (jmeUserPointer*) co1 -> getUserPointer();
+    jmeUserPointer *spaceUp = up0 != NULL && up0->space != NULL ? up0 : up1;
+    if (spaceUp != NULL && spaceUp->space != NULL && ((jmePhysicsSpace*) spaceUp->space)->contactRules.isDisabled(cp, co0, co1)) {
+        // beyond the contact processing threshold, the solver skip it
+        cp.m_distance1 = SIMD_INFINITY;
+        return true;
+    }
     if (up0 != NULL) {
         jmePhysicsSpace *dynamicsWorld = (jmePhysicsSpace *)up0->space;
         if (dynamicsWorld != NULL) {
@@ -290,6 +360,132 @@ jobject jmePhysicsSpace::getJavaPhysicsSpace() {
     return javaPhysicsSpace;
 }
 
+jmeProjectiles* jmePhysicsSpace::getProjectiles() {
+    if (projectiles == NULL) {
+        projectiles = new jmeProjectiles();
+    }
+    return projectiles;
+}
+
+void jmePhysicsSpace::objectAdded(btCollisionObject* object) {
+    if (jmeGhostFilter::isEnabled(object)) {
+        exactOverlapGhosts++;
+    }
+}
+
+void jmePhysicsSpace::objectRemoved(btCollisionObject* object) {
+    if (jmeGhostFilter::isEnabled(object)) {
+        exactOverlapGhosts--;
+    }
+    jmeFrozenRegions::objectRemoved(object);
+    if (projectiles != NULL) {
+        projectiles->objectRemoved(object);
+    }
+    if (costProfiler != NULL) {
+        costProfiler->objectRemoved(object);
+    }
+}
+
+void jmePhysicsSpace::exactOverlapsChanged(bool enabled) {
+    exactOverlapGhosts += enabled ? 1 : -1;
+}
+
+jmeDebugDraw* jmePhysicsSpace::getDebugDraw() {
+    if (debugDraw == NULL) {
+        debugDraw = new jmeDebugDraw();
+    }
+    return debugDraw;
+}
+
+jmeSimulationLod* jmePhysicsSpace::getSimulationLod() {
+    return simulationLod;
+}
+
+void jmePhysicsSpace::setSimulationLodEnabled(bool enabled) {
+    if (enabled && simulationLod == NULL) {
+        simulationLod = new jmeSimulationLod();
+    } else if (!enabled && simulationLod != NULL) {
+        delete(simulationLod);
+        simulationLod = NULL;
+    }
+}
+
+jmeFrozenRegions* jmePhysicsSpace::getFrozenRegions() {
+    if (frozenRegions == NULL) {
+        frozenRegions = new jmeFrozenRegions();
+    }
+    return frozenRegions;
+}
+
+jmeTickPlugins* jmePhysicsSpace::getTickPlugins() {
+    if (tickPlugins == NULL) {
+        tickPlugins = new jmeTickPlugins();
+    }
+    return tickPlugins;
+}
+
+jmeForceFields* jmePhysicsSpace::getForceFields() {
+    if (forceFields == NULL) {
+        forceFields = new jmeForceFields();
+    }
+    return forceFields;
+}
+
+jmeCostProfiler* jmePhysicsSpace::getCostProfiler() {
+    return costProfiler;
+}
+
+void jmePhysicsSpace::setCostProfilingEnabled(bool enabled) {
+    if (enabled && costProfiler == NULL) {
+        costProfiler = new jmeCostProfiler(dynamicsWorld);
+    } else if (!enabled && costProfiler != NULL) {
+        delete(costProfiler);
+        costProfiler = NULL;
+    }
+}
+
+bool jmePhysicsSpace::startRecording(const char* path) {
+    stopRecording();
+    recorder = jmeRecorder::open(path);
+    return recorder != NULL;
+}
+
+void jmePhysicsSpace::stopRecording() {
+    if (recorder != NULL) {
+        delete(recorder);
+        recorder = NULL;
+    }
+}
+
+void jmePhysicsSpace::setJavaTickCallbacks(bool enabled) {
+    javaTickCallbacks = enabled;
+}
+
 jmePhysicsSpace::~jmePhysicsSpace() {
+    if (projectiles != NULL) {
+        delete(projectiles);
+    }
+    if (costProfiler != NULL) {
+        delete(costProfiler);
+    }
+    stopRecording();
     delete(dynamicsWorld);
+    if (debugDraw != NULL) {
+        delete(debugDraw);
+    }
+    if (simulationLod != NULL) {
+        delete(simulationLod);
+    }
+    if (frozenRegions != NULL) {
+        delete(frozenRegions);
+    }
+    if (tickPlugins != NULL) {
+        delete(tickPlugins);
+    }
+    if (forceFields != NULL) {
+        delete(forceFields);
+    }
+    if (ghostFilter != NULL) {
+        delete(ghostFilter);
+    }
 }
\ No newline at end of file
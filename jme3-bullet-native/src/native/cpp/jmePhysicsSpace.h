@@ -48,6 +48,16 @@
 #include "BulletCollision/CollisionDispatch/btSimulationIslandManager.h"
 #include "BulletCollision/NarrowPhaseCollision/btManifoldPoint.h"
 #include "BulletCollision/NarrowPhaseCollision/btPersistentManifold.h"
+#include "jmeProjectiles.h"
+#include "jmeDebugDraw.h"
+#include "jmeSimulationLod.h"
+#include "jmeFrozenRegions.h"
+#include "jmeTickPlugins.h"
+#include "jmeForceFields.h"
+#include "jmeGhostFilter.h"
+#include "jmeCostProfiler.h"
+#include "jmeRecorder.h"
+#include "jmeContactRules.h"
 
 /**
  * Author: Normen Hansen
@@ -59,11 +69,28 @@ private:
        	jobject javaPhysicsSpace;
 protected:
 	btDynamicsWorld* dynamicsWorld;
+        jmeProjectiles* projectiles;
+        jmeDebugDraw* debugDraw;
+        jmeSimulationLod* simulationLod;
+        jmeFrozenRegions* frozenRegions;
+        jmeTickPlugins* tickPlugins;
+        jmeForceFields* forceFields;
+        jmeGhostFilter* ghostFilter;
+        jmeCostProfiler* costProfiler;
+        jmeRecorder* recorder;
+        // this space copy of the contact materials, updated before the ticks
+        jmeContactRules contactRules;
+        // the friction direction caching was enabled for surface velocities
+        bool frictionCaching;
+        // the ghosts with exact overlaps in this space
+        int exactOverlapGhosts;
+        // call the java tick methods, only needed with tick listeners or tasks
+        bool javaTickCallbacks;
         btThreadSupportInterface* createSolverThreadSupport(int);
         btThreadSupportInterface* createDispatchThreadSupport(int);
         void attachThread();
 public:
-	jmePhysicsSpace(){};
+	jmePhysicsSpace() : projectiles(NULL), debugDraw(NULL), simulationLod(NULL), frozenRegions(NULL), tickPlugins(NULL), forceFields(NULL), ghostFilter(NULL), costProfiler(NULL), recorder(NULL), frictionCaching(false), exactOverlapGhosts(0), javaTickCallbacks(true) {};
 	~jmePhysicsSpace();
         jmePhysicsSpace(JNIEnv*, jobject);
 	void stepSimulation(jfloat, jint, jfloat);
@@ -71,6 +98,26 @@ public:
         btDynamicsWorld* getDynamicsWorld();
         jobject getJavaPhysicsSpace();
         JNIEnv* getEnv();
+        jmeProjectiles* getProjectiles();
+        jmeDebugDraw* getDebugDraw();
+        jmeSimulationLod* getSimulationLod();
+        void setSimulationLodEnabled(bool);
+        jmeFrozenRegions* getFrozenRegions();
+        jmeTickPlugins* getTickPlugins();
+        jmeForceFields* getForceFields();
+        jmeCostProfiler* getCostProfiler();
+        const jmeContactRules& getContactRules() const {
+            return contactRules;
+        }
+        void setCostProfilingEnabled(bool);
+        bool startRecording(const char*);
+        void stopRecording();
+        void setJavaTickCallbacks(bool);
+        // count the exact overlap ghosts added to the world
+        void objectAdded(btCollisionObject*);
+        // forget the native references to an object removed from the world
+        void objectRemoved(btCollisionObject*);
+        void exactOverlapsChanged(bool);
         static void preTickCallback(btDynamicsWorld*, btScalar);
         static void postTickCallback(btDynamicsWorld*, btScalar);
         static bool contactProcessedCallback(btManifoldPoint &, void *, void *);
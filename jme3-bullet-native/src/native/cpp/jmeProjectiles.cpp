@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeProjectiles.h"
+#include "jmeTriangleMaterials.h"
+#include "jmeHeightfieldTerrainShape.h"
+
+/**
+ * Author: dokthar
+ */
+jmeProjectiles::jmeProjectiles()
+: hits(NULL), hitIds(NULL), maxHits(0), hitCount(0) {
+}
+
+void jmeProjectiles::setHitBuffers(jfloat* hits, jint* hitIds, int maxHits) {
+    this->hits = hits;
+    this->hitIds = hitIds;
+    this->maxHits = maxHits;
+    hitObjects.resize(maxHits);
+    if (hitCount > maxHits) {
+        hitCount = maxHits;
+    }
+}
+
+void jmeProjectiles::spawn(const btVector3& position, const btVector3& velocity, btScalar drag, btScalar radius, btScalar lifetime, int userId) {
+    positions.push_back(position);
+    velocities.push_back(velocity);
+    drags.push_back(drag);
+    radiuses.push_back(radius);
+    lifetimes.push_back(lifetime);
+    userIds.push_back(userId);
+}
+
+void jmeProjectiles::clear() {
+    positions.resize(0);
+    velocities.resize(0);
+    drags.resize(0);
+    radiuses.resize(0);
+    lifetimes.resize(0);
+    userIds.resize(0);
+}
+
+int jmeProjectiles::getCount() {
+    return positions.size();
+}
+
+int jmeProjectiles::getHitCount() {
+    return hitCount;
+}
+
+const btCollisionObject* jmeProjectiles::getHitObject(int hit) {
+    return hitObjects[hit];
+}
+
+void jmeProjectiles::objectRemoved(const btCollisionObject* object) {
+    // the hits are kept until java clears them, the object may be freed before
+    for (int i = 0; i < hitCount; ++i) {
+        if (hitObjects[i] == object) {
+            hitObjects[i] = NULL;
+        }
+    }
+}
+
+void jmeProjectiles::clearHits() {
+    hitCount = 0;
+}
+
+void jmeProjectiles::remove(int index) {
+    const int last = positions.size() - 1;
+    positions.swap(index, last);
+    velocities.swap(index, last);
+    drags.swap(index, last);
+    radiuses.swap(index, last);
+    lifetimes.swap(index, last);
+    userIds.swap(index, last);
+    positions.pop_back();
+    velocities.pop_back();
+    drags.pop_back();
+    radiuses.pop_back();
+    lifetimes.pop_back();
+    userIds.pop_back();
+}
+
+void jmeProjectiles::step(btCollisionWorld* world, const btVector3& gravity, btScalar timeStep) {
+    // integrate, all the projectiles at once
+    const int count = positions.size();
+    for (int i = 0; i < count; ++i) {
+        btVector3& v = velocities[i];
+        v += (gravity - v * (drags[i] * v.length())) * timeStep;
+        lifetimes[i] -= timeStep;
+    }
+
+    // sweep, iterate backward so removed projectiles are replaced by already
+    // processed ones
+    Hit hit;
+    for (int i = count - 1; i >= 0; --i) {
+        const btVector3 from = positions[i];
+        const btVector3 to = from + velocities[i] * timeStep;
+        if (sweep(world, from, to, radiuses[i], hit)) {
+            if (hitCount < maxHits) {
+                jfloat* out = &hits[hitCount * JME_PROJECTILE_HIT_SIZE];
+                out[0] = hit.point.x();
+                out[1] = hit.point.y();
+                out[2] = hit.point.z();
+                out[3] = hit.normal.x();
+                out[4] = hit.normal.y();
+                out[5] = hit.normal.z();
+                out[6] = velocities[i].x();
+                out[7] = velocities[i].y();
+                out[8] = velocities[i].z();
+                out[9] = hit.fraction;
+                out[10] = hit.material;
+                hitIds[hitCount] = userIds[i];
+                hitObjects[hitCount] = hit.object;
+                hitCount++;
+            }
+            remove(i);
+        } else if (lifetimes[i] <= 0) {
+            remove(i);
+        } else {
+            positions[i] = to;
+        }
+    }
+}
+
+// closest hit, ignoring the objects without contact response (ghosts)
+
+struct jmeClosestRayResultCallback : public btCollisionWorld::ClosestRayResultCallback {
+    int material;
+
+    jmeClosestRayResultCallback(const btVector3& from, const btVector3& to)
+    : btCollisionWorld::ClosestRayResultCallback(from, to), material(-1) {
+    }
+
+    virtual btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace) {
+        material = jmeTriangleMaterials::get(rayResult.m_collisionObject->getCollisionShape(), rayResult.m_localShapeInfo);
+        return btCollisionWorld::ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+    }
+
+    virtual bool needsCollision(btBroadphaseProxy* proxy) const {
+        const btCollisionObject* object = (const btCollisionObject*) proxy->m_clientObject;
+        if (object->hasContactResponse()) {
+            return btCollisionWorld::ClosestRayResultCallback::needsCollision(proxy);
+        }
+        return false;
+    }
+};
+
+struct jmeClosestConvexResultCallback : public btCollisionWorld::ClosestConvexResultCallback {
+    int material;
+
+    jmeClosestConvexResultCallback(const btVector3& from, const btVector3& to)
+    : btCollisionWorld::ClosestConvexResultCallback(from, to), material(-1) {
+    }
+
+    virtual btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace) {
+        material = jmeTriangleMaterials::get(convexResult.m_hitCollisionObject->getCollisionShape(), convexResult.m_localShapeInfo);
+        return btCollisionWorld::ClosestConvexResultCallback::addSingleResult(convexResult, normalInWorldSpace);
+    }
+
+    virtual bool needsCollision(btBroadphaseProxy* proxy) const {
+        const btCollisionObject* object = (const btCollisionObject*) proxy->m_clientObject;
+        if (object->hasContactResponse()) {
+            return btCollisionWorld::ClosestConvexResultCallback::needsCollision(proxy);
+        }
+        return false;
+    }
+};
+
+bool jmeProjectiles::sweep(btCollisionWorld* world, const btVector3& from, const btVector3& to, btScalar radius, Hit& hit) {
+    if (radius <= 0) {
+        jmeClosestRayResultCallback callback(from, to);
+        jmeHeightfieldTerrainShape::rayTest(world, from, to, callback);
+        if (!callback.hasHit()) {
+            return false;
+        }
+        hit.point = callback.m_hitPointWorld;
+        hit.normal = callback.m_hitNormalWorld;
+        hit.fraction = callback.m_closestHitFraction;
+        hit.object = callback.m_collisionObject;
+        hit.material = callback.material;
+        return true;
+    }
+    btSphereShape sphere(radius);
+    btTransform start;
+    start.setIdentity();
+    start.setOrigin(from);
+    btTransform end;
+    end.setIdentity();
+    end.setOrigin(to);
+    jmeClosestConvexResultCallback callback(from, to);
+    world->convexSweepTest(&sphere, start, end, callback);
+    if (!callback.hasHit()) {
+        return false;
+    }
+    hit.point = callback.m_hitPointWorld;
+    hit.normal = callback.m_hitNormalWorld;
+    hit.fraction = callback.m_closestHitFraction;
+    hit.object = callback.m_hitCollisionObject;
+    hit.material = callback.material;
+    return true;
+}
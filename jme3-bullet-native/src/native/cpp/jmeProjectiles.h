@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeProjectiles
+#define _Included_jmeProjectiles
+#include <jni.h>
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+// floats per hit event : point, normal, velocity, fraction of the step,
+// triangle material
+#define JME_PROJECTILE_HIT_SIZE 11
+
+/**
+ * Pool of projectiles of a physics space, stored as a struct of arrays.
+ * At each internal tick the projectiles are integrated (gravity and
+ * quadratic drag) and their motion is swept against the world, a projectile
+ * hitting an object is removed and a hit event is written into the hit
+ * buffers shared with java.
+ *
+ * Author: dokthar
+ */
+class jmeProjectiles {
+public:
+
+    struct Hit {
+        btVector3 point;
+        btVector3 normal;
+        btScalar fraction;
+        const btCollisionObject* object;
+        // material of the hit triangle, -1 if none
+        int material;
+    };
+
+    jmeProjectiles();
+
+    // 11 floats per hit in hits, 1 int (the user id) per hit in hitIds
+    void setHitBuffers(jfloat* hits, jint* hitIds, int maxHits);
+    void spawn(const btVector3& position, const btVector3& velocity, btScalar drag, btScalar radius, btScalar lifetime, int userId);
+    void clear();
+    int getCount();
+    int getHitCount();
+    // NULL if the object was removed from the world since the hit
+    const btCollisionObject* getHitObject(int hit);
+    void objectRemoved(const btCollisionObject* object);
+    void clearHits();
+
+    void step(btCollisionWorld* world, const btVector3& gravity, btScalar timeStep);
+
+    // sweep a ray (radius 0) or a sphere from -> to, return true on hit
+    static bool sweep(btCollisionWorld* world, const btVector3& from, const btVector3& to, btScalar radius, Hit& hit);
+
+private:
+    btAlignedObjectArray<btVector3> positions;
+    btAlignedObjectArray<btVector3> velocities;
+    btAlignedObjectArray<btScalar> drags;
+    btAlignedObjectArray<btScalar> radiuses;
+    btAlignedObjectArray<btScalar> lifetimes;
+    btAlignedObjectArray<int> userIds;
+
+    jfloat* hits;
+    jint* hitIds;
+    int maxHits;
+    int hitCount;
+    btAlignedObjectArray<const btCollisionObject*> hitObjects;
+
+    void remove(int index);
+};
+#endif
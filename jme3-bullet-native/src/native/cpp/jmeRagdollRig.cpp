@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeRagdollRig.h"
+
+/**
+ * Author: dokthar
+ */
+jmeRagdollRig::jmeRagdollRig(int boneCount) {
+    bodies.resize(boneCount, NULL);
+    bindRotations.resize(boneCount, btQuaternion::getIdentity());
+}
+
+int jmeRagdollRig::getBoneCount() const {
+    return bodies.size();
+}
+
+void jmeRagdollRig::setBone(int index, btRigidBody* body, const btQuaternion& bindRotation) {
+    bodies[index] = body;
+    bindRotations[index] = bindRotation;
+}
+
+void jmeRagdollRig::setBodies(const jlong* bodyIds) {
+    for (int i = 0; i < bodies.size(); i++) {
+        bodies[i] = reinterpret_cast<btRigidBody*> (bodyIds[i]);
+    }
+}
+
+void jmeRagdollRig::getPose(const btTransform& modelTransform, const btVector3& modelScale, const float* animated, btScalar blend, float* out) const {
+    btQuaternion inverseModelRotation = modelTransform.getRotation().inverse();
+    btVector3 inverseModelScale(1 / modelScale.x(), 1 / modelScale.y(), 1 / modelScale.z());
+    for (int i = 0; i < bodies.size(); i++) {
+        const float* animatedBone = animated != NULL ? animated + i * JME_RAGDOLL_BONE_SIZE : NULL;
+        float* outBone = out + i * JME_RAGDOLL_BONE_SIZE;
+        btRigidBody* body = bodies[i];
+        if (body == NULL) {
+            if (animatedBone != NULL) {
+                for (int j = 0; j < JME_RAGDOLL_BONE_SIZE; j++) {
+                    outBone[j] = animatedBone[j];
+                }
+            }
+            continue;
+        }
+        // the interpolated transform, as read by the controls
+        btTransform transform;
+        if (body->getMotionState() != NULL) {
+            body->getMotionState()->getWorldTransform(transform);
+        } else {
+            transform = body->getWorldTransform();
+        }
+        btVector3 position = quatRotate(inverseModelRotation, transform.getOrigin() - modelTransform.getOrigin()) * inverseModelScale;
+        btQuaternion rotation = inverseModelRotation * (transform.getRotation() * bindRotations[i]);
+        rotation.normalize();
+
+        if (animatedBone != NULL && blend < 1) {
+            btVector3 animatedPosition(animatedBone[0], animatedBone[1], animatedBone[2]);
+            btQuaternion animatedRotation(animatedBone[3], animatedBone[4], animatedBone[5], animatedBone[6]);
+            position = animatedPosition.lerp(position, blend);
+            // nlerp along the shortest path
+            if (animatedRotation.dot(rotation) < 0) {
+                rotation = -rotation;
+            }
+            rotation = animatedRotation * (1 - blend) + rotation * blend;
+            rotation.normalize();
+        }
+        outBone[0] = position.x();
+        outBone[1] = position.y();
+        outBone[2] = position.z();
+        outBone[3] = rotation.x();
+        outBone[4] = rotation.y();
+        outBone[5] = rotation.z();
+        outBone[6] = rotation.w();
+    }
+}
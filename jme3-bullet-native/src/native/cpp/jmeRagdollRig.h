@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeRagdollRig
+#define _Included_jmeRagdollRig
+#include <jni.h>
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+// model space position (3 floats) and rotation quaternion (4 floats) of a bone
+#define JME_RAGDOLL_BONE_SIZE 7
+
+/**
+ * Ragdoll rig : the rigid body and bind rotation of each bone, used to write
+ * the model space pose of the bones from the physics transforms, optionally
+ * blended with an animated pose.
+ * The bone rotation is the body rotation times the bind rotation, its
+ * position the body position, both in the space of the model.
+ *
+ * Author: dokthar
+ */
+class jmeRagdollRig {
+public:
+    jmeRagdollRig(int boneCount);
+
+    int getBoneCount() const;
+    void setBone(int index, btRigidBody* body, const btQuaternion& bindRotation);
+    // the current bodies, their native objects change when they are rebuilt
+    void setBodies(const jlong* bodyIds);
+    // the bones without body keep the animated pose, or are not written
+    // blend : 0 for the animated pose, 1 for the physics pose
+    void getPose(const btTransform& modelTransform, const btVector3& modelScale, const float* animated, btScalar blend, float* out) const;
+
+private:
+    btAlignedObjectArray<btRigidBody*> bodies;
+    btAlignedObjectArray<btQuaternion> bindRotations;
+};
+#endif
@@ -0,0 +1,691 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <string.h>
+#include "jmeRecorder.h"
+#include "jmeBulletUtil.h"
+#include "jmeHeightfieldTerrainShape.h"
+#include "BulletCollision/CollisionShapes/btShapeHull.h"
+#include "BulletCollision/Gimpact/btGImpactShape.h"
+
+/**
+ * Author: dokthar
+ */
+jmeRecorder* jmeRecorder::open(const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (file == NULL) {
+        return NULL;
+    }
+    return new jmeRecorder(file);
+}
+
+jmeRecorder::jmeRecorder(FILE* file) : file(file), worldWritten(false), generation(0) {
+    writeInt(JME_RECORD_MAGIC);
+    writeInt(JME_RECORD_VERSION);
+    writeInt(sizeof (btScalar));
+}
+
+jmeRecorder::~jmeRecorder() {
+    writeInt(JME_RECORD_END);
+    flush();
+    fclose(file);
+}
+
+void jmeRecorder::write(const void* data, int size) {
+    int offset = buffer.size();
+    buffer.resize(offset + size);
+    memcpy(&buffer[offset], data, size);
+}
+
+void jmeRecorder::writeInt(int value) {
+    write(&value, sizeof (int));
+}
+
+void jmeRecorder::writeId(const void* id) {
+    long long value = (long long) (size_t) id;
+    write(&value, sizeof (long long));
+}
+
+void jmeRecorder::writeScalar(btScalar value) {
+    write(&value, sizeof (btScalar));
+}
+
+void jmeRecorder::writeVector(const btVector3& vector) {
+    write(vector.m_floats, 3 * sizeof (btScalar));
+}
+
+void jmeRecorder::writeTransform(const btTransform& transform) {
+    btScalar values[JME_TRANSFORM_SIZE];
+    jmePackTransform(transform, values);
+    write(values, sizeof (values));
+}
+
+void jmeRecorder::flush() {
+    if (buffer.size() > 0) {
+        fwrite(&buffer[0], 1, buffer.size(), file);
+        buffer.resize(0);
+    }
+}
+
+void jmeRecorder::step(btScalar time, int maxSteps, btScalar fixedTimeStep) {
+    writeInt(JME_RECORD_STEP);
+    writeScalar(time);
+    writeInt(maxSteps);
+    writeScalar(fixedTimeStep);
+    // the ticks of the previous step are complete
+    flush();
+}
+
+void jmeRecorder::writeWorld(btDynamicsWorld* dynamicsWorld) {
+    jmeRecordWorld current;
+    memset(&current, 0, sizeof (jmeRecordWorld));
+    btVector3 gravity = dynamicsWorld->getGravity();
+    for (int i = 0; i < 3; i++) {
+        current.gravity[i] = gravity[i];
+    }
+    btContactSolverInfo& info = dynamicsWorld->getSolverInfo();
+    current.numIterations = info.m_numIterations;
+    current.solverMode = info.m_solverMode;
+    current.splitImpulse = info.m_splitImpulse;
+    current.erp = info.m_erp;
+    current.erp2 = info.m_erp2;
+    current.globalCfm = info.m_globalCfm;
+    current.splitImpulsePenetrationThreshold = info.m_splitImpulsePenetrationThreshold;
+    current.linearSlop = info.m_linearSlop;
+    current.warmstartingFactor = info.m_warmstartingFactor;
+    if (worldWritten && memcmp(&current, &world, sizeof (jmeRecordWorld)) == 0) {
+        return;
+    }
+    world = current;
+    worldWritten = true;
+    writeInt(JME_RECORD_WORLD);
+    write(&world, sizeof (jmeRecordWorld));
+}
+
+void jmeRecorder::writeShape(btCollisionShape* shape) {
+    jmeRecordedShape current;
+    current.type = shape->getShapeType();
+    btTransform identity;
+    identity.setIdentity();
+    shape->getAabb(identity, current.aabbMin, current.aabbMax);
+    current.data = NULL;
+    current.count = 0;
+    current.scaling = shape->getLocalScaling();
+    current.margin = shape->getMargin();
+    current.revision = 0;
+    switch (current.type) {
+        case COMPOUND_SHAPE_PROXYTYPE:
+            current.count = ((btCompoundShape*) shape)->getNumChildShapes();
+            current.data = current.count > 0 ? ((btCompoundShape*) shape)->getChildList() : NULL;
+            current.revision = ((btCompoundShape*) shape)->getUpdateRevision();
+            break;
+        case TERRAIN_SHAPE_PROXYTYPE:
+            // the heights are edited in place
+            current.data = ((jmeHeightfieldTerrainShape*) shape)->getHeights();
+            current.revision = ((jmeHeightfieldTerrainShape*) shape)->getUpdateRevision();
+            break;
+        case CONVEX_HULL_SHAPE_PROXYTYPE:
+            current.count = ((btConvexHullShape*) shape)->getNumPoints();
+            current.data = current.count > 0 ? ((btConvexHullShape*) shape)->getUnscaledPoints() : NULL;
+            break;
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE:
+            current.data = ((btTriangleMeshShape*) shape)->getMeshInterface();
+            break;
+        case GIMPACT_SHAPE_PROXYTYPE:
+            current.data = ((btGImpactMeshShape*) shape)->getMeshInterface();
+            break;
+    }
+    jmeRecordedShape* recorded = shapes.find(btHashPtr(shape));
+    if (recorded != NULL && recorded->equals(current)) {
+        return;
+    }
+    // the primitive shapes are recorded with their scaling applied, so they
+    // are recorded again when it changes
+    shapes.insert(btHashPtr(shape), current);
+    if (shape->isCompound()) {
+        btCompoundShape* compound = (btCompoundShape*) shape;
+        for (int i = 0; i < compound->getNumChildShapes(); i++) {
+            writeShape(compound->getChildShape(i));
+        }
+    }
+    writeInt(JME_RECORD_SHAPE);
+    writeId(shape);
+    switch (shape->getShapeType()) {
+        case EMPTY_SHAPE_PROXYTYPE:
+            writeInt(JME_SHAPE_EMPTY);
+            writeScalar(shape->getMargin());
+            break;
+        case BOX_SHAPE_PROXYTYPE:
+            writeInt(JME_SHAPE_BOX);
+            writeVector(((btBoxShape*) shape)->getHalfExtentsWithMargin());
+            writeScalar(shape->getMargin());
+            break;
+        case SPHERE_SHAPE_PROXYTYPE:
+            writeInt(JME_SHAPE_SPHERE);
+            writeScalar(((btSphereShape*) shape)->getRadius());
+            break;
+        case CAPSULE_SHAPE_PROXYTYPE:
+        {
+            btCapsuleShape* capsule = (btCapsuleShape*) shape;
+            writeInt(JME_SHAPE_CAPSULE);
+            writeInt(capsule->getUpAxis());
+            writeScalar(capsule->getRadius());
+            writeScalar(capsule->getHalfHeight());
+            break;
+        }
+        case CYLINDER_SHAPE_PROXYTYPE:
+        {
+            btCylinderShape* cylinder = (btCylinderShape*) shape;
+            writeInt(JME_SHAPE_CYLINDER);
+            writeInt(cylinder->getUpAxis());
+            writeVector(cylinder->getHalfExtentsWithMargin());
+            writeScalar(shape->getMargin());
+            break;
+        }
+        case CONE_SHAPE_PROXYTYPE:
+        {
+            btConeShape* cone = (btConeShape*) shape;
+            writeInt(JME_SHAPE_CONE);
+            writeInt(cone->getConeUpIndex());
+            writeScalar(cone->getRadius());
+            writeScalar(cone->getHeight());
+            writeScalar(shape->getMargin());
+            break;
+        }
+        case CONVEX_HULL_SHAPE_PROXYTYPE:
+        {
+            btConvexHullShape* hull = (btConvexHullShape*) shape;
+            writeInt(JME_SHAPE_HULL);
+            writeInt(hull->getNumPoints());
+            for (int i = 0; i < hull->getNumPoints(); i++) {
+                writeVector(hull->getUnscaledPoints()[i]);
+            }
+            writeVector(shape->getLocalScaling());
+            writeScalar(shape->getMargin());
+            break;
+        }
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE:
+            writeInt(JME_SHAPE_MESH);
+            writeTriangles(shape, ((btTriangleMeshShape*) shape)->getMeshInterface());
+            writeVector(shape->getLocalScaling());
+            writeScalar(shape->getMargin());
+            break;
+        case GIMPACT_SHAPE_PROXYTYPE:
+            writeInt(JME_SHAPE_GIMPACT);
+            writeTriangles(shape, ((btGImpactMeshShape*) shape)->getMeshInterface());
+            writeVector(shape->getLocalScaling());
+            writeScalar(shape->getMargin());
+            break;
+        case STATIC_PLANE_PROXYTYPE:
+        {
+            btStaticPlaneShape* plane = (btStaticPlaneShape*) shape;
+            writeInt(JME_SHAPE_PLANE);
+            writeVector(plane->getPlaneNormal());
+            writeScalar(plane->getPlaneConstant());
+            writeVector(shape->getLocalScaling());
+            break;
+        }
+        case COMPOUND_SHAPE_PROXYTYPE:
+        {
+            btCompoundShape* compound = (btCompoundShape*) shape;
+            writeInt(JME_SHAPE_COMPOUND);
+            writeInt(compound->getNumChildShapes());
+            for (int i = 0; i < compound->getNumChildShapes(); i++) {
+                writeTransform(compound->getChildTransform(i));
+                writeId(compound->getChildShape(i));
+            }
+            writeScalar(shape->getMargin());
+            break;
+        }
+        case TERRAIN_SHAPE_PROXYTYPE:
+        {
+            // the only heightfield created by the native library
+            jmeHeightfieldTerrainShape* terrain = (jmeHeightfieldTerrainShape*) shape;
+            writeInt(JME_SHAPE_HEIGHTFIELD);
+            writeInt(terrain->getHeightStickWidth());
+            writeInt(terrain->getHeightStickLength());
+            writeInt(terrain->getUpAxis());
+            writeInt(terrain->getFlipQuadEdges());
+            writeScalar(terrain->getHeightScale());
+            writeScalar(terrain->getMinHeight());
+            writeScalar(terrain->getMaxHeight());
+            write(terrain->getHeights(), terrain->getHeightStickWidth() * terrain->getHeightStickLength() * sizeof (btScalar));
+            writeVector(shape->getLocalScaling());
+            break;
+        }
+        default:
+            // other shapes are recorded as a hull or a triangle mesh of the
+            // same geometry, scaling included
+            if (shape->isConvex()) {
+                btShapeHull hull((btConvexShape*) shape);
+                hull.buildHull(shape->getMargin());
+                writeInt(JME_SHAPE_HULL);
+                writeInt(hull.numVertices());
+                for (int i = 0; i < hull.numVertices(); i++) {
+                    writeVector(hull.getVertexPointer()[i]);
+                }
+            } else if (shape->isConcave()) {
+                writeInt(JME_SHAPE_MESH);
+                writeTriangles(shape, NULL);
+            } else {
+                writeInt(JME_SHAPE_EMPTY);
+                writeScalar(shape->getMargin());
+                break;
+            }
+            writeVector(btVector3(1, 1, 1));
+            writeScalar(shape->getMargin());
+            break;
+    }
+}
+
+void jmeRecorder::writeTriangles(const btCollisionShape* shape, btStridingMeshInterface* mesh) {
+
+    struct jmeTriangleCollector : public btTriangleCallback {
+        btAlignedObjectArray<btVector3> vertices;
+        btAlignedObjectArray<int> indices;
+
+        virtual void processTriangle(btVector3* triangle, int partId, int triangleIndex) {
+            for (int k = 0; k < 3; k++) {
+                indices.push_back(vertices.size());
+                vertices.push_back(triangle[k]);
+            }
+        }
+    };
+    jmeTriangleCollector triangles;
+    if (mesh != NULL) {
+        // the unscaled vertexes of all the parts in a single mesh
+        for (int part = 0; part < mesh->getNumSubParts(); part++) {
+            const unsigned char* vertexBase;
+            int numVertices;
+            PHY_ScalarType vertexType;
+            int vertexStride;
+            const unsigned char* indexBase;
+            int indexStride;
+            int numFaces;
+            PHY_ScalarType indexType;
+            mesh->getLockedReadOnlyVertexIndexBase(&vertexBase, numVertices, vertexType, vertexStride, &indexBase, indexStride, numFaces, indexType, part);
+            int offset = triangles.vertices.size();
+            for (int i = 0; i < numVertices; i++) {
+                if (vertexType == PHY_DOUBLE) {
+                    const double* vertex = (const double*) (vertexBase + i * vertexStride);
+                    triangles.vertices.push_back(btVector3((btScalar) vertex[0], (btScalar) vertex[1], (btScalar) vertex[2]));
+                } else {
+                    const float* vertex = (const float*) (vertexBase + i * vertexStride);
+                    triangles.vertices.push_back(btVector3(vertex[0], vertex[1], vertex[2]));
+                }
+            }
+            for (int i = 0; i < numFaces; i++) {
+                const unsigned char* face = indexBase + i * indexStride;
+                for (int k = 0; k < 3; k++) {
+                    int index;
+                    if (indexType == PHY_SHORT) {
+                        index = ((const unsigned short*) face)[k];
+                    } else if (indexType == PHY_UCHAR) {
+                        index = face[k];
+                    } else {
+                        index = ((const int*) face)[k];
+                    }
+                    triangles.indices.push_back(offset + index);
+                }
+            }
+            mesh->unLockReadOnlyVertexBase(part);
+        }
+    } else {
+        ((const btConcaveShape*) shape)->processAllTriangles(&triangles, btVector3(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT), btVector3(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT));
+    }
+    writeInt(triangles.vertices.size());
+    for (int i = 0; i < triangles.vertices.size(); i++) {
+        writeVector(triangles.vertices[i]);
+    }
+    writeInt(triangles.indices.size() / 3);
+    if (triangles.indices.size() > 0) {
+        write(&triangles.indices[0], triangles.indices.size() * sizeof (int));
+    }
+}
+
+void jmeRecorder::getProperties(btCollisionObject* object, jmeRecordObject& properties) {
+    // zeroed for the comparisons
+    memset(&properties, 0, sizeof (jmeRecordObject));
+    writeShape(object->getCollisionShape());
+    properties.shape = (long long) (size_t) object->getCollisionShape();
+    btRigidBody* body = btRigidBody::upcast(object);
+    if (body != NULL) {
+        properties.type = JME_OBJECT_RIGID_BODY;
+    } else if (object->getInternalType() == btCollisionObject::CO_GHOST_OBJECT) {
+        properties.type = JME_OBJECT_GHOST;
+    } else {
+        properties.type = JME_OBJECT_COLLISION_OBJECT;
+    }
+    properties.collisionFlags = object->getCollisionFlags();
+    btBroadphaseProxy* proxy = object->getBroadphaseHandle();
+    if (proxy != NULL) {
+        properties.filterGroup = proxy->m_collisionFilterGroup;
+        properties.filterMask = proxy->m_collisionFilterMask;
+    }
+    jmeUserPointer *userPointer = (jmeUserPointer*) object->getUserPointer();
+    properties.group = userPointer != NULL ? userPointer->group : -1;
+    properties.groups = userPointer != NULL ? userPointer->groups : -1;
+    properties.friction = object->getFriction();
+    properties.rollingFriction = object->getRollingFriction();
+    properties.restitution = object->getRestitution();
+    properties.contactProcessingThreshold = object->getContactProcessingThreshold();
+    properties.ccdMotionThreshold = object->getCcdMotionThreshold();
+    properties.ccdSweptSphereRadius = object->getCcdSweptSphereRadius();
+    if (body == NULL) {
+        return;
+    }
+    properties.rigidBodyFlags = body->getFlags();
+    properties.mass = body->getInvMass() != 0 ? 1 / body->getInvMass() : 0;
+    const btVector3& inverseInertia = body->getInvInertiaDiagLocal();
+    for (int i = 0; i < 3; i++) {
+        properties.inertia[i] = inverseInertia[i] != 0 ? 1 / inverseInertia[i] : 0;
+        properties.linearFactor[i] = body->getLinearFactor()[i];
+        properties.angularFactor[i] = body->getAngularFactor()[i];
+        properties.gravity[i] = body->getGravity()[i];
+    }
+    properties.linearDamping = body->getLinearDamping();
+    properties.angularDamping = body->getAngularDamping();
+    properties.linearSleepingThreshold = body->getLinearSleepingThreshold();
+    properties.angularSleepingThreshold = body->getAngularSleepingThreshold();
+}
+
+void jmeRecorder::getJoint(btTypedConstraint* joint, jmeRecordJoint& properties) {
+    memset(&properties, 0, sizeof (jmeRecordJoint));
+    btRigidBody* fixedBody = &btTypedConstraint::getFixedBody();
+    properties.bodyA = &joint->getRigidBodyA() != fixedBody ? (long long) (size_t) &joint->getRigidBodyA() : 0;
+    properties.bodyB = &joint->getRigidBodyB() != fixedBody ? (long long) (size_t) &joint->getRigidBodyB() : 0;
+    properties.type = joint->getConstraintType();
+    properties.breakingImpulseThreshold = joint->getBreakingImpulseThreshold();
+    if (joint->isEnabled()) {
+        properties.flags |= JME_JOINT_ENABLED;
+    }
+    if (!joint->getRigidBodyA().checkCollideWith(&joint->getRigidBodyB())) {
+        properties.flags |= JME_JOINT_DISABLE_COLLISIONS;
+    }
+    switch (joint->getConstraintType()) {
+        case POINT2POINT_CONSTRAINT_TYPE:
+        {
+            btPoint2PointConstraint* point = (btPoint2PointConstraint*) joint;
+            jmePackTransform(btTransform(btMatrix3x3::getIdentity(), point->getPivotInA()), properties.frameA);
+            jmePackTransform(btTransform(btMatrix3x3::getIdentity(), point->getPivotInB()), properties.frameB);
+            properties.limits[0] = point->m_setting.m_tau;
+            properties.limits[1] = point->m_setting.m_damping;
+            properties.limits[2] = point->m_setting.m_impulseClamp;
+            break;
+        }
+        case HINGE_CONSTRAINT_TYPE:
+        {
+            btHingeConstraint* hinge = (btHingeConstraint*) joint;
+            jmePackTransform(hinge->getAFrame(), properties.frameA);
+            jmePackTransform(hinge->getBFrame(), properties.frameB);
+            properties.limits[0] = hinge->getLowerLimit();
+            properties.limits[1] = hinge->getUpperLimit();
+            properties.limits[2] = hinge->getLimitSoftness();
+            properties.limits[3] = hinge->getLimitBiasFactor();
+            properties.limits[4] = hinge->getLimitRelaxationFactor();
+            properties.limits[5] = hinge->getMotorTargetVelosity();
+            properties.limits[6] = hinge->getMaxMotorImpulse();
+            if (hinge->getAngularOnly()) {
+                properties.flags |= JME_JOINT_ANGULAR_ONLY;
+            }
+            if (hinge->getEnableAngularMotor()) {
+                properties.flags |= JME_JOINT_MOTOR;
+            }
+            break;
+        }
+        case CONETWIST_CONSTRAINT_TYPE:
+        {
+            btConeTwistConstraint* cone = (btConeTwistConstraint*) joint;
+            jmePackTransform(cone->getAFrame(), properties.frameA);
+            jmePackTransform(cone->getBFrame(), properties.frameB);
+            properties.limits[0] = cone->getSwingSpan1();
+            properties.limits[1] = cone->getSwingSpan2();
+            properties.limits[2] = cone->getTwistSpan();
+            break;
+        }
+        case SLIDER_CONSTRAINT_TYPE:
+        {
+            btSliderConstraint* slider = (btSliderConstraint*) joint;
+            jmePackTransform(slider->getFrameOffsetA(), properties.frameA);
+            jmePackTransform(slider->getFrameOffsetB(), properties.frameB);
+            properties.limits[0] = slider->getLowerLinLimit();
+            properties.limits[1] = slider->getUpperLinLimit();
+            properties.limits[2] = slider->getLowerAngLimit();
+            properties.limits[3] = slider->getUpperAngLimit();
+            if (slider->getUseLinearReferenceFrameA()) {
+                properties.flags |= JME_JOINT_LINEAR_REFERENCE_FRAME_A;
+            }
+            break;
+        }
+        case D6_CONSTRAINT_TYPE:
+        case D6_SPRING_CONSTRAINT_TYPE:
+        {
+            // the springs are not recorded, the joint is replayed as a
+            // generic 6 dof joint with the linear reference frame A (the
+            // default of the SixDofJoint)
+            btGeneric6DofConstraint* sixDof = (btGeneric6DofConstraint*) joint;
+            jmePackTransform(sixDof->getFrameOffsetA(), properties.frameA);
+            jmePackTransform(sixDof->getFrameOffsetB(), properties.frameB);
+            btVector3 limit;
+            sixDof->getLinearLowerLimit(limit);
+            properties.limits[0] = limit.x();
+            properties.limits[1] = limit.y();
+            properties.limits[2] = limit.z();
+            sixDof->getLinearUpperLimit(limit);
+            properties.limits[3] = limit.x();
+            properties.limits[4] = limit.y();
+            properties.limits[5] = limit.z();
+            sixDof->getAngularLowerLimit(limit);
+            properties.limits[6] = limit.x();
+            properties.limits[7] = limit.y();
+            properties.limits[8] = limit.z();
+            sixDof->getAngularUpperLimit(limit);
+            properties.limits[9] = limit.x();
+            properties.limits[10] = limit.y();
+            properties.limits[11] = limit.z();
+            properties.flags |= JME_JOINT_LINEAR_REFERENCE_FRAME_A;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void jmeRecorder::saveState(btCollisionObject* object, jmeRecordedState& state) {
+    state.transform = object->getWorldTransform();
+    state.activationState = object->getActivationState();
+    state.deactivationTime = object->getDeactivationTime();
+    btRigidBody* body = btRigidBody::upcast(object);
+    if (body != NULL) {
+        state.linearVelocity = body->getLinearVelocity();
+        state.angularVelocity = body->getAngularVelocity();
+        state.force = body->getTotalForce();
+        state.torque = body->getTotalTorque();
+    }
+}
+
+void jmeRecorder::writeState(btCollisionObject* object, jmeRecordedState& state, int flags) {
+    btRigidBody* body = btRigidBody::upcast(object);
+    if (!(object->getWorldTransform() == state.transform)) {
+        flags |= JME_STATE_TRANSFORM;
+    }
+    if (object->getActivationState() != state.activationState || object->getDeactivationTime() != state.deactivationTime) {
+        flags |= JME_STATE_ACTIVATION;
+    }
+    if (body != NULL) {
+        if (body->getLinearVelocity() != state.linearVelocity || body->getAngularVelocity() != state.angularVelocity) {
+            flags |= JME_STATE_VELOCITY;
+        }
+        // the forces are kept over the ticks of a step, the gravity applied
+        // at each step is then a change only for the bodies waking up
+        if (body->getTotalForce() != state.force || body->getTotalTorque() != state.torque) {
+            flags |= JME_STATE_FORCE;
+        }
+    } else {
+        flags &= JME_STATE_TRANSFORM | JME_STATE_ACTIVATION;
+    }
+    if (flags == 0) {
+        return;
+    }
+    writeInt(JME_RECORD_STATE);
+    writeId(object);
+    writeInt(flags);
+    if (flags & JME_STATE_TRANSFORM) {
+        writeTransform(object->getWorldTransform());
+    }
+    if (flags & JME_STATE_VELOCITY) {
+        writeVector(body->getLinearVelocity());
+        writeVector(body->getAngularVelocity());
+    }
+    if (flags & JME_STATE_FORCE) {
+        writeVector(body->getTotalForce());
+        writeVector(body->getTotalTorque());
+    }
+    if (flags & JME_STATE_ACTIVATION) {
+        writeInt(object->getActivationState());
+        writeScalar(object->getDeactivationTime());
+    }
+    saveState(object, state);
+}
+
+jmeRecorder::jmeRecordedState& jmeRecorder::addState(const void* object, bool joint) {
+    indices.insert(btHashPtr(object), states.size());
+    jmeRecordedState& state = states.expandNonInitializing();
+    state.object = object;
+    state.joint = joint;
+    state.generation = generation;
+    return state;
+}
+
+void jmeRecorder::removeState(int index) {
+    indices.remove(btHashPtr(states[index].object));
+    int last = states.size() - 1;
+    if (index != last) {
+        states[index] = states[last];
+        indices.insert(btHashPtr(states[index].object), index);
+    }
+    states.pop_back();
+}
+
+void jmeRecorder::preTick(btDynamicsWorld* dynamicsWorld, btScalar timeStep) {
+    generation++;
+    writeWorld(dynamicsWorld);
+    btCollisionObjectArray& objects = dynamicsWorld->getCollisionObjectArray();
+    int numJoints = dynamicsWorld->getNumConstraints();
+    // mark what is still in the world
+    for (int i = 0; i < objects.size(); i++) {
+        int* index = indices.find(btHashPtr(objects[i]));
+        if (index != NULL && !states[*index].joint) {
+            states[*index].generation = generation;
+        }
+    }
+    for (int i = 0; i < numJoints; i++) {
+        int* index = indices.find(btHashPtr(dynamicsWorld->getConstraint(i)));
+        if (index != NULL && states[*index].joint) {
+            states[*index].generation = generation;
+        }
+    }
+    // removed joints first, their bodies may be removed too
+    for (int i = states.size() - 1; i >= 0; i--) {
+        if (states[i].joint && states[i].generation != generation) {
+            writeInt(JME_RECORD_REMOVE_JOINT);
+            writeId(states[i].object);
+            removeState(i);
+        }
+    }
+    for (int i = states.size() - 1; i >= 0; i--) {
+        if (!states[i].joint && states[i].generation != generation) {
+            writeInt(JME_RECORD_REMOVE);
+            writeId(states[i].object);
+            removeState(i);
+        }
+    }
+    // added and changed objects, in the world order
+    for (int i = 0; i < objects.size(); i++) {
+        btCollisionObject* object = objects[i];
+        jmeRecordObject properties;
+        getProperties(object, properties);
+        int* index = indices.find(btHashPtr(object));
+        if (index != NULL && states[*index].properties.type != properties.type) {
+            // an address reused by an other kind of object
+            writeInt(JME_RECORD_REMOVE);
+            writeId(object);
+            removeState(*index);
+            index = NULL;
+        }
+        if (index == NULL) {
+            jmeRecordedState& state = addState(object, false);
+            state.properties = properties;
+            writeInt(JME_RECORD_ADD);
+            writeId(object);
+            write(&properties, sizeof (jmeRecordObject));
+            writeState(object, state, JME_STATE_TRANSFORM | JME_STATE_VELOCITY | JME_STATE_FORCE | JME_STATE_ACTIVATION);
+        } else {
+            jmeRecordedState& state = states[*index];
+            if (memcmp(&properties, &state.properties, sizeof (jmeRecordObject)) != 0) {
+                state.properties = properties;
+                writeInt(JME_RECORD_PROPERTIES);
+                writeId(object);
+                write(&properties, sizeof (jmeRecordObject));
+            }
+            writeState(object, state, 0);
+        }
+    }
+    for (int i = 0; i < numJoints; i++) {
+        btTypedConstraint* joint = dynamicsWorld->getConstraint(i);
+        jmeRecordJoint properties;
+        getJoint(joint, properties);
+        int* index = indices.find(btHashPtr(joint));
+        jmeRecordedState* state;
+        if (index == NULL) {
+            state = &addState(joint, true);
+        } else if (memcmp(&properties, &states[*index].jointProperties, sizeof (jmeRecordJoint)) != 0) {
+            state = &states[*index];
+        } else {
+            continue;
+        }
+        state->jointProperties = properties;
+        writeInt(JME_RECORD_JOINT);
+        writeId(joint);
+        write(&properties, sizeof (jmeRecordJoint));
+    }
+    writeInt(JME_RECORD_TICK);
+    writeScalar(timeStep);
+}
+
+void jmeRecorder::postTick(btDynamicsWorld* dynamicsWorld) {
+    // the reference for the changes made before the next tick
+    for (int i = 0; i < states.size(); i++) {
+        if (!states[i].joint) {
+            saveState((btCollisionObject*) states[i].object, states[i]);
+        }
+    }
+}
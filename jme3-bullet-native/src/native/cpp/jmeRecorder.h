@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeRecorder
+#define _Included_jmeRecorder
+#include <stdio.h>
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+#include "LinearMath/btHashMap.h"
+
+/**
+ * The physics recording stream, shared by the recorder and the replay tool.
+ * The stream starts with the magic, the version and sizeof(btScalar), then
+ * each record is its type followed by its data. The ids are the native
+ * addresses of the recorded objects, shapes and joints.
+ */
+#define JME_RECORD_MAGIC 0x4a4d4552
+#define JME_RECORD_VERSION 1
+
+enum jmeRecordType {
+    JME_RECORD_END = 0,
+    // jmeRecordWorld
+    JME_RECORD_WORLD,
+    // id, jmeRecordShapeType, shape data
+    JME_RECORD_SHAPE,
+    // id, jmeRecordObject
+    JME_RECORD_ADD,
+    // id, jmeRecordObject
+    JME_RECORD_PROPERTIES,
+    // id
+    JME_RECORD_REMOVE,
+    // id, JME_STATE_ flags, the flagged values in the flags order
+    JME_RECORD_STATE,
+    // id, jmeRecordJoint, added or replaced
+    JME_RECORD_JOINT,
+    // id
+    JME_RECORD_REMOVE_JOINT,
+    // time, maxSteps, fixedTimeStep of a stepSimulation call
+    JME_RECORD_STEP,
+    // timeStep of an internal tick, the changes are recorded before it
+    JME_RECORD_TICK
+};
+
+enum jmeRecordShapeType {
+    // margin
+    JME_SHAPE_EMPTY = 0,
+    // half extents with margin, margin
+    JME_SHAPE_BOX,
+    // radius
+    JME_SHAPE_SPHERE,
+    // up axis, radius, half height
+    JME_SHAPE_CAPSULE,
+    // up axis, half extents with margin, margin
+    JME_SHAPE_CYLINDER,
+    // up axis, radius, height, margin
+    JME_SHAPE_CONE,
+    // point count, unscaled points, scaling, margin
+    JME_SHAPE_HULL,
+    // vertex count, vertexes, triangle count, indexes, scaling, margin
+    JME_SHAPE_MESH,
+    JME_SHAPE_GIMPACT,
+    // normal, constant, scaling
+    JME_SHAPE_PLANE,
+    // child count, child transforms and shape ids, margin
+    JME_SHAPE_COMPOUND,
+    // width, length, up axis, flip, height scale, min, max, heights, scaling
+    JME_SHAPE_HEIGHTFIELD
+};
+
+enum jmeRecordObjectType {
+    JME_OBJECT_RIGID_BODY = 0,
+    JME_OBJECT_GHOST,
+    JME_OBJECT_COLLISION_OBJECT
+};
+
+#define JME_STATE_TRANSFORM 1
+#define JME_STATE_VELOCITY 2
+#define JME_STATE_FORCE 4
+#define JME_STATE_ACTIVATION 8
+
+// a transform as its basis rows and its origin
+#define JME_TRANSFORM_SIZE 12
+
+struct jmeRecordWorld {
+    btScalar gravity[3];
+    int numIterations;
+    int solverMode;
+    int splitImpulse;
+    btScalar erp;
+    btScalar erp2;
+    btScalar globalCfm;
+    btScalar splitImpulsePenetrationThreshold;
+    btScalar linearSlop;
+    btScalar warmstartingFactor;
+};
+
+struct jmeRecordObject {
+    long long shape;
+    int type;
+    int collisionFlags;
+    int filterGroup;
+    int filterMask;
+    int group;
+    int groups;
+    int rigidBodyFlags;
+    btScalar friction;
+    btScalar rollingFriction;
+    btScalar restitution;
+    btScalar contactProcessingThreshold;
+    btScalar ccdMotionThreshold;
+    btScalar ccdSweptSphereRadius;
+    btScalar mass;
+    btScalar inertia[3];
+    btScalar linearDamping;
+    btScalar angularDamping;
+    btScalar linearSleepingThreshold;
+    btScalar angularSleepingThreshold;
+    btScalar linearFactor[3];
+    btScalar angularFactor[3];
+    btScalar gravity[3];
+};
+
+#define JME_JOINT_ANGULAR_ONLY 1
+#define JME_JOINT_MOTOR 2
+#define JME_JOINT_LINEAR_REFERENCE_FRAME_A 4
+#define JME_JOINT_DISABLE_COLLISIONS 8
+#define JME_JOINT_ENABLED 16
+
+struct jmeRecordJoint {
+    // 0 for the fixed body of the single body joints
+    long long bodyA;
+    long long bodyB;
+    // the btTypedConstraintType
+    int type;
+    int flags;
+    btScalar frameA[JME_TRANSFORM_SIZE];
+    btScalar frameB[JME_TRANSFORM_SIZE];
+    // point : tau, damping, impulse clamp
+    // hinge : low, high, softness, bias, relaxation, motor velocity, motor impulse
+    // cone twist : swing span 1, swing span 2, twist span
+    // slider : lower and upper linear limits, lower and upper angular limits
+    // 6dof : linear lower, linear upper, angular lower, angular upper
+    btScalar limits[12];
+    btScalar breakingImpulseThreshold;
+};
+
+inline void jmePackTransform(const btTransform& transform, btScalar* out) {
+    for (int i = 0; i < 3; i++) {
+        out[i * 3] = transform.getBasis()[i].x();
+        out[i * 3 + 1] = transform.getBasis()[i].y();
+        out[i * 3 + 2] = transform.getBasis()[i].z();
+        out[9 + i] = transform.getOrigin()[i];
+    }
+}
+
+inline void jmeUnpackTransform(const btScalar* in, btTransform& transform) {
+    transform.getBasis().setValue(in[0], in[1], in[2], in[3], in[4], in[5], in[6], in[7], in[8]);
+    transform.setOrigin(btVector3(in[9], in[10], in[11]));
+}
+
+/**
+ * Physics recorder : writes the initial world then every change made between
+ * the internal ticks (objects and joints added, removed or modified, forces,
+ * velocities, moves and activation changes) into a compact binary stream
+ * that the replay tool can step again without the application.
+ * The changes are found by comparing the objects with their state after the
+ * previous tick, so the changes made through any API are recorded, the tick
+ * callbacks included.
+ *
+ * Author: dokthar
+ */
+class jmeRecorder {
+public:
+    // null if the file can not be opened
+    static jmeRecorder* open(const char* path);
+    ~jmeRecorder();
+
+    void step(btScalar time, int maxSteps, btScalar fixedTimeStep);
+    void preTick(btDynamicsWorld* world, btScalar timeStep);
+    void postTick(btDynamicsWorld* world);
+
+private:
+    struct jmeRecordedState {
+        const void* object;
+        bool joint;
+        int generation;
+        btTransform transform;
+        btVector3 linearVelocity;
+        btVector3 angularVelocity;
+        btVector3 force;
+        btVector3 torque;
+        int activationState;
+        btScalar deactivationTime;
+        jmeRecordObject properties;
+        jmeRecordJoint jointProperties;
+    };
+
+    // a freed shape address can be reused by a new shape, so the type, the
+    // bounds and the geometry data are compared too
+    struct jmeRecordedShape {
+        int type;
+        btVector3 aabbMin;
+        btVector3 aabbMax;
+        const void* data;
+        int count;
+        btVector3 scaling;
+        btScalar margin;
+        int revision;
+
+        bool equals(const jmeRecordedShape& other) const {
+            return type == other.type && aabbMin == other.aabbMin && aabbMax == other.aabbMax
+                    && data == other.data && count == other.count && scaling == other.scaling
+                    && margin == other.margin && revision == other.revision;
+        }
+    };
+    FILE* file;
+    btAlignedObjectArray<unsigned char> buffer;
+    btHashMap<btHashPtr, int> indices;
+    btAlignedObjectArray<jmeRecordedState> states;
+    btHashMap<btHashPtr, jmeRecordedShape> shapes;
+    jmeRecordWorld world;
+    bool worldWritten;
+    int generation;
+
+    jmeRecorder(FILE* file);
+    void write(const void* data, int size);
+    void writeInt(int value);
+    void writeId(const void* id);
+    void writeScalar(btScalar value);
+    void writeVector(const btVector3& vector);
+    void writeTransform(const btTransform& transform);
+    void flush();
+
+    void writeWorld(btDynamicsWorld* world);
+    void writeShape(btCollisionShape* shape);
+    void writeTriangles(const btCollisionShape* shape, btStridingMeshInterface* mesh);
+    void writeState(btCollisionObject* object, jmeRecordedState& state, int flags);
+    void getProperties(btCollisionObject* object, jmeRecordObject& properties);
+    void getJoint(btTypedConstraint* joint, jmeRecordJoint& properties);
+    void saveState(btCollisionObject* object, jmeRecordedState& state);
+    jmeRecordedState& addState(const void* object, bool joint);
+    void removeState(int index);
+};
+#endif
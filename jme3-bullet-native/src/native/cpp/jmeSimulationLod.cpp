@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeSimulationLod.h"
+#include "jmeBulletUtil.h"
+
+/**
+ * Author: dokthar
+ */
+unsigned int jmeSimulationLod::nextPhase = 0;
+
+void jmeSimulationLod::setTier(btCollisionObject* object, int tier) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) object->getUserPointer();
+    if (userPointer == NULL) {
+        return;
+    }
+    userPointer->simulationTier = btMax(0, btMin(tier, JME_SIMULATION_MAX_TIER));
+    // spread the bodies of a tier over its ticks in the order they are set,
+    // the same from one run to the other
+    userPointer->skippedTicks = (int) (nextPhase++ & ((1u << userPointer->simulationTier) - 1));
+}
+
+int jmeSimulationLod::getTier(btCollisionObject* object) {
+    jmeUserPointer *userPointer = (jmeUserPointer*) object->getUserPointer();
+    return userPointer != NULL ? userPointer->simulationTier : 0;
+}
+
+int jmeSimulationLod::getIsland(btCollisionObject* object, int index, int count) const {
+    // the island tags of the previous tick, a body not yet in an island is its
+    // own, after the range of the tags so it does not join a real island
+    int tag = object->getIslandTag();
+    return (tag >= 0 && tag < count) ? tag : count + index;
+}
+
+void jmeSimulationLod::save(jmeLodBody& saved, btRigidBody* body, btScalar scale) const {
+    saved.body = body;
+    saved.linearVelocity = body->getLinearVelocity();
+    saved.angularVelocity = body->getAngularVelocity();
+    saved.activationState = body->getActivationState();
+    saved.deactivationTime = body->getDeactivationTime();
+    saved.scale = scale;
+    saved.extraForce.setZero();
+    saved.extraTorque.setZero();
+}
+
+void jmeSimulationLod::preTick(btDynamicsWorld* world) {
+    btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    int count = objects.size();
+    // the island tags, then the bodies without island
+    islandTiers.resize(count * 2);
+    islandSkipped.resize(count * 2);
+    for (int i = 0; i < count * 2; i++) {
+        islandTiers[i] = JME_SIMULATION_MAX_TIER;
+        islandSkipped[i] = 0;
+    }
+    sleeping.resize(0);
+    scaled.resize(0);
+
+    for (int i = 0; i < count; i++) {
+        btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if (body == NULL || body->isStaticOrKinematicObject() || !body->isActive()) {
+            continue;
+        }
+        jmeUserPointer *userPointer = (jmeUserPointer*) body->getUserPointer();
+        int island = getIsland(body, i, count);
+        if (userPointer == NULL) {
+            islandTiers[island] = 0;
+            continue;
+        }
+        islandTiers[island] = btMin(islandTiers[island], userPointer->simulationTier);
+        islandSkipped[island] = btMax(islandSkipped[island], userPointer->skippedTicks);
+    }
+
+    for (int i = 0; i < count; i++) {
+        btRigidBody* body = btRigidBody::upcast(objects[i]);
+        if (body == NULL || body->isStaticOrKinematicObject() || !body->isActive()) {
+            continue;
+        }
+        jmeUserPointer *userPointer = (jmeUserPointer*) body->getUserPointer();
+        if (userPointer == NULL) {
+            continue;
+        }
+        int island = getIsland(body, i, count);
+        int period = 1 << islandTiers[island];
+        int skipped = islandSkipped[island];
+        if (skipped + 1 < period) {
+            // skipped tick, the island sleeps unless an active body wakes it up
+            jmeLodBody& saved = sleeping.expand();
+            save(saved, body, 1);
+            body->forceActivationState(ISLAND_SLEEPING);
+            userPointer->skippedTicks = skipped + 1;
+        } else {
+            userPointer->skippedTicks = 0;
+            if (skipped > 0) {
+                btScalar scale = (btScalar) (skipped + 1);
+                jmeLodBody& saved = scaled.expand();
+                save(saved, body, scale);
+                saved.extraForce = body->getTotalForce() * (scale * scale - 1);
+                saved.extraTorque = body->getTotalTorque() * (scale * scale - 1);
+                body->setLinearVelocity(saved.linearVelocity * scale);
+                body->setAngularVelocity(saved.angularVelocity * scale);
+                body->applyCentralForce(saved.extraForce);
+                body->applyTorque(saved.extraTorque);
+            }
+        }
+    }
+}
+
+void jmeSimulationLod::postTick(btDynamicsWorld* world) {
+    for (int i = 0; i < sleeping.size(); i++) {
+        jmeLodBody& saved = sleeping[i];
+        btRigidBody* body = saved.body;
+        jmeUserPointer *userPointer = (jmeUserPointer*) body->getUserPointer();
+        if (body->getActivationState() == ISLAND_SLEEPING) {
+            // not simulated, undo the damping of the motion prediction
+            body->setLinearVelocity(saved.linearVelocity);
+            body->setAngularVelocity(saved.angularVelocity);
+            body->forceActivationState(saved.activationState);
+            body->setDeactivationTime(saved.deactivationTime);
+        } else {
+            // promoted by a body of a lower tier, stepped at full rate
+            body->forceActivationState(saved.activationState);
+            userPointer->skippedTicks = 0;
+        }
+    }
+    for (int i = 0; i < scaled.size(); i++) {
+        jmeLodBody& saved = scaled[i];
+        btRigidBody* body = saved.body;
+        btVector3 force = body->getTotalForce() - saved.extraForce;
+        btVector3 torque = body->getTotalTorque() - saved.extraTorque;
+        btVector3 linearVelocity = body->getLinearVelocity() / saved.scale;
+        btVector3 angularVelocity = body->getAngularVelocity() / saved.scale;
+        body->setLinearVelocity(linearVelocity);
+        body->setAngularVelocity(angularVelocity);
+        body->setInterpolationLinearVelocity(linearVelocity);
+        body->setInterpolationAngularVelocity(angularVelocity);
+        body->clearForces();
+        body->applyCentralForce(force);
+        body->applyTorque(torque);
+    }
+    sleeping.resize(0);
+    scaled.resize(0);
+}
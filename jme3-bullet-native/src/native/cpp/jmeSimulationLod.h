@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeSimulationLod
+#define _Included_jmeSimulationLod
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+#define JME_SIMULATION_MAX_TIER 4
+
+/**
+ * Simulation level of detail : the rigid bodies of tier t are stepped every
+ * 2^t internal ticks, with a timestep scaled accordingly.
+ * The tier of a simulation island is the lowest tier of its bodies, so the
+ * bodies touching or jointed to a more important body are promoted to its
+ * rate.
+ * On the skipped ticks the island is put to sleep, on the stepped tick its
+ * velocities are scaled by the number of ticks to catch up and its forces by
+ * the square of it, which amounts to one integration step of the whole
+ * duration.
+ *
+ * Author: dokthar
+ */
+class jmeSimulationLod {
+public:
+    void preTick(btDynamicsWorld* world);
+    void postTick(btDynamicsWorld* world);
+
+    static void setTier(btCollisionObject* object, int tier);
+    static int getTier(btCollisionObject* object);
+
+private:
+    struct jmeLodBody {
+        btRigidBody* body;
+        btVector3 linearVelocity;
+        btVector3 angularVelocity;
+        btVector3 extraForce;
+        btVector3 extraTorque;
+        int activationState;
+        btScalar deactivationTime;
+        btScalar scale;
+    };
+    btAlignedObjectArray<int> islandTiers;
+    btAlignedObjectArray<int> islandSkipped;
+    btAlignedObjectArray<jmeLodBody> sleeping;
+    btAlignedObjectArray<jmeLodBody> scaled;
+    // the tick phase given to the next body, see setTier()
+    static unsigned int nextPhase;
+
+    int getIsland(btCollisionObject* object, int index, int count) const;
+    void save(jmeLodBody& saved, btRigidBody* body, btScalar scale) const;
+};
+#endif
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeSoftBodyClusters.h"
+#include "BulletMultiThreaded/btThreadSupportInterface.h"
+#ifdef _WIN32
+#include "BulletMultiThreaded/Win32ThreadSupport.h"
+#elif defined (USE_PTHREADS)
+#include "BulletMultiThreaded/PosixThreadSupport.h"
+#endif
+
+/**
+ * Author: dokthar
+ */
+#define JME_SOFT_CLUSTERS_THREADS 4
+// nodes * clusters under which the K-mean stays on the calling thread
+#define JME_SOFT_CLUSTERS_MIN_WORK 65536
+
+struct jmeSoftBodyClustersTask {
+    btSoftBody* body;
+    const btAlignedObjectArray<btVector3>* centers;
+    int* nodeClusters;
+    btAlignedObjectArray<unsigned char> marks;
+    int begin;
+    int end;
+
+    void run() {
+        if (centers != NULL) {
+            jmeSoftBodyClusters::assignNodes(body, *centers, nodeClusters, begin, end);
+        } else {
+            marks.resize(body->m_nodes.size(), 0);
+            jmeSoftBodyClusters::connectClusters(body, &marks[0], begin, end);
+        }
+    }
+};
+
+static void jmeSoftBodyClustersThreadFunc(void* userPtr, void* lsMemory) {
+    jmeSoftBodyClustersTask* task = (jmeSoftBodyClustersTask*) userPtr;
+    task->run();
+}
+
+static void* jmeSoftBodyClustersMemoryFunc() {
+    return NULL;
+}
+
+static btThreadSupportInterface* jmeSoftBodyClustersStartThreads() {
+#ifdef _WIN32
+    Win32ThreadSupport::Win32ThreadConstructionInfo threadConstructionInfo("softClusters", jmeSoftBodyClustersThreadFunc, jmeSoftBodyClustersMemoryFunc, JME_SOFT_CLUSTERS_THREADS);
+    btThreadSupportInterface* threads = new Win32ThreadSupport(threadConstructionInfo);
+    threads->startSPU();
+    return threads;
+#elif defined (USE_PTHREADS)
+    PosixThreadSupport::ThreadConstructionInfo constructionInfo("softClusters", jmeSoftBodyClustersThreadFunc,
+            jmeSoftBodyClustersMemoryFunc, JME_SOFT_CLUSTERS_THREADS);
+    btThreadSupportInterface* threads = new PosixThreadSupport(constructionInfo);
+    threads->startSPU();
+    return threads;
+#else
+    return NULL;
+#endif
+}
+
+static void jmeSoftBodyClustersStopThreads(btThreadSupportInterface* threads) {
+    if (threads != NULL) {
+        threads->stopSPU();
+        delete threads;
+    }
+}
+
+// split [0, count) in equal ranges, one per thread, each task writes only its own range
+static void jmeSoftBodyClustersRun(btThreadSupportInterface* threads, jmeSoftBodyClustersTask* task, int count) {
+    const int tasks = threads == NULL ? 1 : btMax(1, btMin(JME_SOFT_CLUSTERS_THREADS, count));
+    for (int i = 0; i < tasks; i++) {
+        task[i].begin = count * i / tasks;
+        task[i].end = count * (i + 1) / tasks;
+    }
+    if (tasks < 2) {
+        task[0].run();
+        return;
+    }
+    for (int i = 0; i < tasks; i++) {
+        threads->sendRequest(1, (ppu_address_t) & task[i], i);
+    }
+    for (int i = 0; i < tasks; i++) {
+        unsigned int taskId;
+        unsigned int status;
+        threads->waitForResponse(&taskId, &status);
+    }
+}
+
+// same metric as btSoftBody::generateClusters
+static inline btScalar jmeClusterMetric(const btVector3& x, const btVector3& y) {
+    const btVector3 d = x - y;
+    return btFabs(d[0]) + btFabs(d[1]) + btFabs(d[2]);
+}
+
+static inline int jmeNodeIndex(const btSoftBody* body, const btSoftBody::Node* node) {
+    return int(node - &body->m_nodes[0]);
+}
+
+static btSoftBody::Cluster* jmeNewCluster(bool collide) {
+    btSoftBody::Cluster* cluster = new(btAlignedAlloc(sizeof (btSoftBody::Cluster), 16)) btSoftBody::Cluster();
+    cluster->m_collide = collide;
+    return cluster;
+}
+
+void jmeSoftBodyClusters::assignNodes(const btSoftBody* body, const btAlignedObjectArray<btVector3>& centers, int* nodeClusters, int begin, int end) {
+    const int k = centers.size();
+    for (int i = begin; i < end; ++i) {
+        const btVector3 nx = body->m_nodes[i].m_x;
+        int kbest = 0;
+        btScalar kdist = jmeClusterMetric(centers[0], nx);
+        for (int j = 1; j < k; ++j) {
+            const btScalar d = jmeClusterMetric(centers[j], nx);
+            if (d < kdist) {
+                kbest = j;
+                kdist = d;
+            }
+        }
+        nodeClusters[i] = kbest;
+    }
+}
+
+void jmeSoftBodyClusters::connectClusters(btSoftBody* body, unsigned char* marks, int begin, int end) {
+    const int count = body->m_clusters.size();
+    for (int c0 = begin; c0 < end; ++c0) {
+        const btSoftBody::Cluster* cla = body->m_clusters[c0];
+        for (int i = 0; i < cla->m_nodes.size(); ++i) {
+            marks[jmeNodeIndex(body, cla->m_nodes[i])] = 1;
+        }
+        for (int c1 = 0; c1 < count; ++c1) {
+            const btSoftBody::Cluster* clb = body->m_clusters[c1];
+            bool connected = false;
+            for (int j = 0; !connected && j < clb->m_nodes.size(); ++j) {
+                connected = marks[jmeNodeIndex(body, clb->m_nodes[j])] != 0;
+            }
+            body->m_clusterConnectivity[c0 + c1 * count] = connected;
+        }
+        for (int i = 0; i < cla->m_nodes.size(); ++i) {
+            marks[jmeNodeIndex(body, cla->m_nodes[i])] = 0;
+        }
+    }
+}
+
+void jmeSoftBodyClusters::initialize(btSoftBody* body) {
+    if (body->m_clusters.size() == 0) {
+        return;
+    }
+    body->initializeClusters();
+    body->updateClusters();
+
+    //for self-collision
+    const int count = body->m_clusters.size();
+    body->m_clusterConnectivity.resize(count * count);
+    for (int i = 0; i < count; ++i) {
+        body->m_clusters[i]->m_clusterIndex = i;
+    }
+    btThreadSupportInterface* threads = NULL;
+    if (body->m_nodes.size() >= JME_SOFT_CLUSTERS_MIN_WORK / count) {
+        threads = jmeSoftBodyClustersStartThreads();
+    }
+    jmeSoftBodyClustersTask task[JME_SOFT_CLUSTERS_THREADS];
+    for (int i = 0; i < JME_SOFT_CLUSTERS_THREADS; i++) {
+        task[i].body = body;
+        task[i].centers = NULL;
+        task[i].nodeClusters = NULL;
+    }
+    jmeSoftBodyClustersRun(threads, task, count);
+    jmeSoftBodyClustersStopThreads(threads);
+}
+
+int jmeSoftBodyClusters::generate(btSoftBody* body, int k, int maxIterations) {
+    const int nodeCount = body->m_nodes.size();
+    k = btMin(k, nodeCount);
+    if (k <= 0) {
+        return body->generateClusters(0, maxIterations);
+    }
+    body->releaseClusters();
+
+    /* Initialize */
+    btAlignedObjectArray<int> nodeClusters;
+    nodeClusters.resize(nodeCount);
+    btAlignedObjectArray<btVector3> centers;
+    btVector3 cog(0, 0, 0);
+    for (int i = 0; i < nodeCount; ++i) {
+        cog += body->m_nodes[i].m_x;
+        nodeClusters[i] = (int) (((unsigned int) i * 29873u) % (unsigned int) k);
+    }
+    cog /= (btScalar) nodeCount;
+    centers.resize(k, cog);
+
+    btThreadSupportInterface* threads = NULL;
+    if (nodeCount >= JME_SOFT_CLUSTERS_MIN_WORK / k) {
+        threads = jmeSoftBodyClustersStartThreads();
+    }
+    jmeSoftBodyClustersTask task[JME_SOFT_CLUSTERS_THREADS];
+    for (int i = 0; i < JME_SOFT_CLUSTERS_THREADS; i++) {
+        task[i].body = body;
+        task[i].centers = &centers;
+        task[i].nodeClusters = &nodeClusters[0];
+    }
+
+    /* Iterate */
+    // the sums are made in node order, as the node lists of the clusters are
+    btAlignedObjectArray<btVector3> sums;
+    btAlignedObjectArray<int> sizes;
+    const btScalar slope = 16;
+    bool changed;
+    int iterations = 0;
+    do {
+        const btScalar w = 2 - btMin<btScalar>(1, iterations / slope);
+        changed = false;
+        iterations++;
+        sums.resize(0);
+        sums.resize(k, btVector3(0, 0, 0));
+        sizes.resize(0);
+        sizes.resize(k, 0);
+        for (int i = 0; i < nodeCount; ++i) {
+            sums[nodeClusters[i]] += body->m_nodes[i].m_x;
+            sizes[nodeClusters[i]]++;
+        }
+        for (int i = 0; i < k; ++i) {
+            if (sizes[i] > 0) {
+                btVector3 c = sums[i] / (btScalar) sizes[i];
+                c = centers[i] + (c - centers[i]) * w;
+                changed |= ((c - centers[i]).length2() > SIMD_EPSILON);
+                centers[i] = c;
+            }
+        }
+        jmeSoftBodyClustersRun(threads, task, nodeCount);
+    } while (changed && (iterations < maxIterations));
+    jmeSoftBodyClustersStopThreads(threads);
+
+    body->m_clusters.resize(k);
+    for (int i = 0; i < k; ++i) {
+        body->m_clusters[i] = jmeNewCluster(true);
+    }
+    for (int i = 0; i < nodeCount; ++i) {
+        body->m_clusters[nodeClusters[i]]->m_nodes.push_back(&body->m_nodes[i]);
+    }
+
+    /* Merge */
+    // a node of an other cluster is only searched in the nodes already merged
+    btAlignedObjectArray<btAlignedObjectArray<int> > merged;
+    merged.resize(k);
+    for (int i = 0; i < body->m_faces.size(); ++i) {
+        const int idx[] = {jmeNodeIndex(body, body->m_faces[i].m_n[0]),
+            jmeNodeIndex(body, body->m_faces[i].m_n[1]),
+            jmeNodeIndex(body, body->m_faces[i].m_n[2])};
+        for (int j = 0; j < 3; ++j) {
+            const int cid = nodeClusters[idx[j]];
+            for (int q = 1; q < 3; ++q) {
+                const int kid = idx[(j + q) % 3];
+                if (nodeClusters[kid] != cid && merged[cid].findLinearSearch(kid) == merged[cid].size()) {
+                    merged[cid].push_back(kid);
+                    body->m_clusters[cid]->m_nodes.push_back(&body->m_nodes[kid]);
+                }
+            }
+        }
+    }
+
+    /* Master */
+    if (body->m_clusters.size() > 1) {
+        btSoftBody::Cluster* pmaster = jmeNewCluster(false);
+        pmaster->m_nodes.reserve(nodeCount);
+        for (int i = 0; i < nodeCount; ++i) {
+            pmaster->m_nodes.push_back(&body->m_nodes[i]);
+        }
+        body->m_clusters.push_back(pmaster);
+        btSwap(body->m_clusters[0], body->m_clusters[body->m_clusters.size() - 1]);
+    }
+
+    /* Terminate */
+    for (int i = 0; i < body->m_clusters.size(); ++i) {
+        if (body->m_clusters[i]->m_nodes.size() == 0) {
+            body->releaseCluster(i--);
+        }
+    }
+
+    initialize(body);
+    return body->m_clusters.size();
+}
+
+int jmeSoftBodyClusters::getAssignmentSize(btSoftBody* body) {
+    int size = 2 + 2 * body->m_clusters.size();
+    for (int i = 0; i < body->m_clusters.size(); ++i) {
+        size += body->m_clusters[i]->m_nodes.size();
+    }
+    return size;
+}
+
+void jmeSoftBodyClusters::getAssignment(btSoftBody* body, jint* store) {
+    *store++ = body->m_nodes.size();
+    *store++ = body->m_clusters.size();
+    for (int i = 0; i < body->m_clusters.size(); ++i) {
+        const btSoftBody::Cluster* cluster = body->m_clusters[i];
+        *store++ = cluster->m_collide ? 1 : 0;
+        *store++ = cluster->m_nodes.size();
+        for (int j = 0; j < cluster->m_nodes.size(); ++j) {
+            *store++ = jmeNodeIndex(body, cluster->m_nodes[j]);
+        }
+    }
+}
+
+bool jmeSoftBodyClusters::setAssignment(btSoftBody* body, const jint* assignment, int size) {
+    const int nodeCount = body->m_nodes.size();
+    if (size < 2 || assignment[0] != nodeCount || assignment[1] < 0) {
+        return false;
+    }
+    // check everything before touching the current clusters
+    const int count = assignment[1];
+    int pos = 2;
+    for (int i = 0; i < count; ++i) {
+        // an empty cluster has no mass, its inverse mass would be infinite
+        if (pos + 2 > size || assignment[pos + 1] <= 0 || assignment[pos + 1] > size - pos - 2) {
+            return false;
+        }
+        const int n = assignment[pos + 1];
+        pos += 2;
+        for (int j = 0; j < n; ++j) {
+            if (assignment[pos + j] < 0 || assignment[pos + j] >= nodeCount) {
+                return false;
+            }
+        }
+        pos += n;
+    }
+
+    body->releaseClusters();
+    body->m_clusters.resize(count);
+    pos = 2;
+    for (int i = 0; i < count; ++i) {
+        btSoftBody::Cluster* cluster = jmeNewCluster(assignment[pos] != 0);
+        const int n = assignment[pos + 1];
+        pos += 2;
+        cluster->m_nodes.resize(n);
+        for (int j = 0; j < n; ++j) {
+            cluster->m_nodes[j] = &body->m_nodes[assignment[pos + j]];
+        }
+        pos += n;
+        body->m_clusters[i] = cluster;
+    }
+    initialize(body);
+    return true;
+}
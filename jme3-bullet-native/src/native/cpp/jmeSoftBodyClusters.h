@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeSoftBodyClusters
+#define _Included_jmeSoftBodyClusters
+#include <jni.h>
+#include "BulletSoftBody/btSoftBody.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+/**
+ * Cluster generation of a soft body. The K-mean is the one of
+ * btSoftBody::generateClusters : same seeding, same center updates in node
+ * order, so the clusters are the same, but the nearest center search of each
+ * iteration and the cluster connectivity are run on worker threads.
+ * The generated clusters can be saved as an assignment, and set back on a
+ * body with the same nodes without running the K-mean again. The assignment
+ * is : the node count, the cluster count, then for each cluster the collide
+ * flag, the node count and the node indexes.
+ *
+ * Author: dokthar
+ */
+class jmeSoftBodyClusters {
+public:
+    // k <= 0 uses the convex clusters of btSoftBody::generateClusters
+    static int generate(btSoftBody* body, int k, int maxIterations);
+
+    static int getAssignmentSize(btSoftBody* body);
+    static void getAssignment(btSoftBody* body, jint* store);
+    // false if the assignment doesn't match the nodes of the body
+    static bool setAssignment(btSoftBody* body, const jint* assignment, int size);
+
+    // the nearest center of the nodes in [begin, end)
+    static void assignNodes(const btSoftBody* body, const btAlignedObjectArray<btVector3>& centers, int* nodeClusters, int begin, int end);
+    // the connectivity rows of the clusters in [begin, end), marks is a node sized scratch array
+    static void connectClusters(btSoftBody* body, unsigned char* marks, int begin, int end);
+
+private:
+    static void initialize(btSoftBody* body);
+};
+#endif
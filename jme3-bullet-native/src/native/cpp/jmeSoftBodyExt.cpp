@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeSoftBodyExt.h"
+
+/**
+ * Author: dokthar
+ */
+jmeSoftBodyExt::jmeSoftBodyExt()
+: skin(NULL), selfCollision(NULL), tearing(NULL) {
+}
+
+jmeSoftBodyExt::~jmeSoftBodyExt() {
+    if (skin != NULL) {
+        delete(skin);
+    }
+    if (selfCollision != NULL) {
+        delete(selfCollision);
+    }
+    if (tearing != NULL) {
+        delete(tearing);
+    }
+}
+
+jmeSoftBodyExt* jmeSoftBodyExt::get(btSoftBody* body) {
+    jmeSoftBodyExt* ext = find(body);
+    if (ext == NULL) {
+        ext = new jmeSoftBodyExt();
+        body->m_tag = ext;
+    }
+    return ext;
+}
+
+jmeSoftBodyExt* jmeSoftBodyExt::find(btSoftBody* body) {
+    return (jmeSoftBodyExt*) body->m_tag;
+}
+
+void jmeSoftBodyExt::release(btSoftBody* body) {
+    jmeSoftBodyExt* ext = find(body);
+    if (ext != NULL) {
+        delete(ext);
+        body->m_tag = NULL;
+    }
+}
+
+void jmeSoftBodyExt::preTick(btSoftBody* body, btScalar timeStep) {
+    jmeSoftBodyExt* ext = find(body);
+    if (ext == NULL) {
+        return;
+    }
+    if (ext->skin != NULL) {
+        ext->skin->preTick(timeStep);
+    }
+}
+
+void jmeSoftBodyExt::postTick(btSoftBody* body, btScalar timeStep) {
+    jmeSoftBodyExt* ext = find(body);
+    if (ext != NULL && ext->tearing != NULL) {
+        ext->tearing->postTick(timeStep);
+    }
+    if ((body->m_cfg.collisions & JME_VF_SELF) == 0) {
+        return;
+    }
+    if (ext == NULL) {
+        ext = get(body);
+    }
+    if (ext->selfCollision == NULL) {
+        ext->selfCollision = new jmeSoftBodySelfCollision(body);
+    }
+    ext->selfCollision->postTick(timeStep);
+}
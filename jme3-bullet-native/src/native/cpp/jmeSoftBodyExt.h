@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeSoftBodyExt
+#define _Included_jmeSoftBodyExt
+#include "BulletSoftBody/btSoftBody.h"
+#include "jmeSoftBodySkin.h"
+#include "jmeSoftBodySelfCollision.h"
+#include "jmeSoftBodyTearing.h"
+
+/**
+ * Native only data attached to a soft body (through btSoftBody::m_tag), used
+ * by the jme features which have to run inside the internal tick.
+ *
+ * Author: dokthar
+ */
+class jmeSoftBodyExt {
+public:
+    jmeSoftBodySkin* skin;
+    jmeSoftBodySelfCollision* selfCollision;
+    jmeSoftBodyTearing* tearing;
+
+    // return the extension of the body, create it if needed
+    static jmeSoftBodyExt* get(btSoftBody* body);
+    // return the extension of the body, or NULL
+    static jmeSoftBodyExt* find(btSoftBody* body);
+    static void release(btSoftBody* body);
+
+    static void preTick(btSoftBody* body, btScalar timeStep);
+    static void postTick(btSoftBody* body, btScalar timeStep);
+
+private:
+    jmeSoftBodyExt();
+    ~jmeSoftBodyExt();
+};
+#endif
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeSoftBodyMeshTopology.h"
+
+/**
+ * Author: dokthar
+ */
+jmeSoftBodyMeshTopology::jmeSoftBodyMeshTopology(const jint* indexes, int indexCount, const jint* jme2bulletMap, const jfloat* texCoords, int vertexCount)
+: vertexCount(vertexCount), hasTexCoords(texCoords != NULL), maxNodeIndex(-1) {
+    const int triangleCount = indexCount / 3;
+
+    triangles.resize(triangleCount * 3);
+    for (int i = 0; i < triangleCount * 3; ++i) {
+        triangles[i] = indexes[i];
+    }
+
+    nodeIndexes.resize(vertexCount);
+    for (int i = 0; i < vertexCount; ++i) {
+        nodeIndexes[i] = jme2bulletMap != NULL ? jme2bulletMap[i] : i;
+        maxNodeIndex = btMax(maxNodeIndex, nodeIndexes[i]);
+    }
+
+    buildAdjacency();
+
+    if (hasTexCoords) {
+        uvTerms.resize(triangleCount * 2);
+        for (int t = 0; t < triangleCount; ++t) {
+            const int i0 = triangles[t * 3 + 0];
+            const int i1 = triangles[t * 3 + 1];
+            const int i2 = triangles[t * 3 + 2];
+            const btScalar du1 = texCoords[i1 * 2 + 0] - texCoords[i0 * 2 + 0];
+            const btScalar dv1 = texCoords[i1 * 2 + 1] - texCoords[i0 * 2 + 1];
+            const btScalar du2 = texCoords[i2 * 2 + 0] - texCoords[i0 * 2 + 0];
+            const btScalar dv2 = texCoords[i2 * 2 + 1] - texCoords[i0 * 2 + 1];
+            const btScalar det = du1 * dv2 - du2 * dv1;
+            const btScalar r = btFabs(det) > SIMD_EPSILON ? 1 / det : 0;
+            // tangent = e1 * dv2 - e2 * dv1, bitangent = e2 * du1 - e1 * du2
+            uvTerms[t * 2 + 0].setValue(dv2 * r, -dv1 * r, 0);
+            uvTerms[t * 2 + 1].setValue(-du2 * r, du1 * r, 0);
+        }
+    }
+    faceNormals.resize(triangleCount);
+    faceTangents.resize(hasTexCoords ? triangleCount : 0);
+    faceBitangents.resize(hasTexCoords ? triangleCount : 0);
+}
+
+void jmeSoftBodyMeshTopology::buildAdjacency() {
+    const int triangleCount = triangles.size() / 3;
+    // count the triangles of each vertex, then fill the rows
+    adjacencyStart.resize(0);
+    adjacencyStart.resize(vertexCount + 1, 0);
+    for (int i = 0; i < triangleCount * 3; ++i) {
+        adjacencyStart[triangles[i] + 1]++;
+    }
+    for (int v = 0; v < vertexCount; ++v) {
+        adjacencyStart[v + 1] += adjacencyStart[v];
+    }
+    btAlignedObjectArray<int> fill;
+    fill.resize(vertexCount, 0);
+    adjacency.resize(triangleCount * 3);
+    for (int t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const int v = triangles[t * 3 + k];
+            adjacency[adjacencyStart[v] + fill[v]++] = t;
+        }
+    }
+}
+
+void jmeSoftBodyMeshTopology::applyTearing(const jint* vertexDeltas, int vertexDeltaCount, const jint* triangleDeltas, int triangleDeltaCount) {
+    for (int i = 0; i < vertexDeltaCount; ++i) {
+        const int v = vertexDeltas[i * 3];
+        if (v < vertexCount) {
+            nodeIndexes[v] = vertexDeltas[i * 3 + 2];
+            maxNodeIndex = btMax(maxNodeIndex, nodeIndexes[v]);
+        }
+    }
+    if (triangleDeltaCount == 0) {
+        return;
+    }
+    for (int i = 0; i < triangleDeltaCount; ++i) {
+        const int t = triangleDeltas[i * 4];
+        for (int k = 0; k < 3; ++k) {
+            triangles[t * 3 + k] = triangleDeltas[i * 4 + 1 + k];
+        }
+    }
+    // the texture coordinates of a new vertex are the ones of its source, so
+    // the tangent terms are still valid
+    buildAdjacency();
+}
+
+int jmeSoftBodyMeshTopology::getVertexCount() {
+    return vertexCount;
+}
+
+int jmeSoftBodyMeshTopology::getMaxNodeIndex() {
+    return maxNodeIndex;
+}
+
+void jmeSoftBodyMeshTopology::update(const btSoftBody* body, const btVector3& center, jfloat* positions, jfloat* normals, jfloat* tangents) {
+    const int triangleCount = faceNormals.size();
+    const bool doTangents = tangents != NULL && hasTexCoords;
+
+    // per triangle terms, area weighted (not normalized)
+    if (normals != NULL || doTangents) {
+        for (int t = 0; t < triangleCount; ++t) {
+            const btVector3& p0 = body->m_nodes[nodeIndexes[triangles[t * 3 + 0]]].m_x;
+            const btVector3 e1 = body->m_nodes[nodeIndexes[triangles[t * 3 + 1]]].m_x - p0;
+            const btVector3 e2 = body->m_nodes[nodeIndexes[triangles[t * 3 + 2]]].m_x - p0;
+            faceNormals[t] = e1.cross(e2);
+            if (doTangents) {
+                const btVector3& tu = uvTerms[t * 2 + 0];
+                const btVector3& bu = uvTerms[t * 2 + 1];
+                faceTangents[t] = e1 * tu.getX() + e2 * tu.getY();
+                faceBitangents[t] = e1 * bu.getX() + e2 * bu.getY();
+            }
+        }
+    }
+
+    // per vertex gather, no scatter so each vertex is written once
+    for (int v = 0; v < vertexCount; ++v) {
+        const btSoftBody::Node& n = body->m_nodes[nodeIndexes[v]];
+        positions[v * 3 + 0] = n.m_x.getX() - center.getX();
+        positions[v * 3 + 1] = n.m_x.getY() - center.getY();
+        positions[v * 3 + 2] = n.m_x.getZ() - center.getZ();
+
+        if (normals == NULL && !doTangents) {
+            continue;
+        }
+        const int start = adjacencyStart[v];
+        const int end = adjacencyStart[v + 1];
+
+        btVector3 normal(0, 0, 0);
+        for (int a = start; a < end; ++a) {
+            normal += faceNormals[adjacency[a]];
+        }
+        if (normal.length2() > SIMD_EPSILON) {
+            normal.normalize();
+        } else {
+            normal = n.m_n;
+        }
+        if (normals != NULL) {
+            normals[v * 3 + 0] = normal.getX();
+            normals[v * 3 + 1] = normal.getY();
+            normals[v * 3 + 2] = normal.getZ();
+        }
+
+        if (doTangents) {
+            btVector3 tangent(0, 0, 0);
+            btVector3 bitangent(0, 0, 0);
+            for (int a = start; a < end; ++a) {
+                tangent += faceTangents[adjacency[a]];
+                bitangent += faceBitangents[adjacency[a]];
+            }
+            // Gram-Schmidt orthogonalize
+            tangent -= normal * normal.dot(tangent);
+            if (tangent.length2() > SIMD_EPSILON) {
+                tangent.normalize();
+            } else {
+                btVector3 unused;
+                btPlaneSpace1(normal, tangent, unused);
+            }
+            tangents[v * 4 + 0] = tangent.getX();
+            tangents[v * 4 + 1] = tangent.getY();
+            tangents[v * 4 + 2] = tangent.getZ();
+            tangents[v * 4 + 3] = normal.cross(tangent).dot(bitangent) < 0 ? -1.0f : 1.0f;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeSoftBodyMeshTopology
+#define _Included_jmeSoftBodyMeshTopology
+#include <jni.h>
+#include "BulletSoftBody/btSoftBody.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+/**
+ * Topology of a jme render mesh bound to a soft body : the jme to bullet
+ * index map, the vertex to triangles adjacency and the constant texture
+ * coordinates terms of the tangents. Used to update positions, normals and
+ * tangents of the render mesh in a single pass.
+ *
+ * Author: dokthar
+ */
+class jmeSoftBodyMeshTopology {
+public:
+    jmeSoftBodyMeshTopology(const jint* triangles, int indexCount, const jint* jme2bulletMap, const jfloat* texCoords, int vertexCount);
+
+    int getVertexCount();
+
+    // the highest node index of the vertexes, -1 without vertexes
+    int getMaxNodeIndex();
+
+    /**
+     * Write the positions and optionally the normals (3 floats) and tangents
+     * (4 floats, w is the handedness) of the render mesh.
+     */
+    void update(const btSoftBody* body, const btVector3& center, jfloat* positions, jfloat* normals, jfloat* tangents);
+
+    /**
+     * Apply the render mesh changes of a jmeSoftBodyTearing, the new vertexes
+     * must be in the vertex range of the topology.
+     */
+    void applyTearing(const jint* vertexDeltas, int vertexDeltaCount, const jint* triangleDeltas, int triangleDeltaCount);
+
+private:
+    int vertexCount;
+    bool hasTexCoords;
+    btAlignedObjectArray<int> triangles;
+    btAlignedObjectArray<int> nodeIndexes;
+    int maxNodeIndex;
+    // vertex to triangles adjacency (compressed rows)
+    btAlignedObjectArray<int> adjacencyStart;
+    btAlignedObjectArray<int> adjacency;
+    // per triangle texture coordinates deltas : du1, dv1, du2, dv2 scaled by 1/det
+    btAlignedObjectArray<btVector3> uvTerms;
+    // per frame scratch buffers
+    btAlignedObjectArray<btVector3> faceNormals;
+    btAlignedObjectArray<btVector3> faceTangents;
+    btAlignedObjectArray<btVector3> faceBitangents;
+
+    void buildAdjacency();
+};
+#endif
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeSoftBodySelfCollision.h"
+#include "LinearMath/btQuickprof.h"
+
+/**
+ * Author: dokthar
+ */
+jmeSoftBodySelfCollision::jmeSoftBodySelfCollision(btSoftBody* body)
+: thickness(JME_VF_SELF_THICKNESS), budget(JME_VF_SELF_BUDGET), lastTime(0), lastTests(0), lastContacts(0),
+body(body), cellSize(1), firstNode(0), bucketMask(0) {
+}
+
+void jmeSoftBodySelfCollision::postTick(btScalar timeStep) {
+    lastTests = 0;
+    lastContacts = 0;
+    if (body->m_faces.size() == 0 || !body->isActive()) {
+        lastTime = 0;
+        return;
+    }
+    btClock clock;
+    buildHash();
+    lastContacts = collide();
+    lastTime = clock.getTimeMicroseconds() / btScalar(1000);
+}
+
+// rebuilt from scratch at each step, the cloth moves everywhere so most faces
+// change cells anyway and the counting sort is linear
+void jmeSoftBodySelfCollision::buildHash() {
+    const int faceCount = body->m_faces.size();
+
+    // the cell size follow the size of the faces, so a face cover few cells
+    btScalar extent = 0;
+    for (int i = 0; i < faceCount; ++i) {
+        const btSoftBody::Face& f = body->m_faces[i];
+        btVector3 min = f.m_n[0]->m_x;
+        btVector3 max = min;
+        for (int j = 1; j < 3; ++j) {
+            min.setMin(f.m_n[j]->m_x);
+            max.setMax(f.m_n[j]->m_x);
+        }
+        const btVector3 size = max - min;
+        extent += size[size.maxAxis()];
+    }
+    cellSize = btMax(extent / faceCount, thickness * 2);
+    if (cellSize <= SIMD_EPSILON) {
+        cellSize = 1;
+    }
+
+    int bucketCount = 1;
+    while (bucketCount < faceCount * 2) {
+        bucketCount <<= 1;
+    }
+    bucketMask = bucketCount - 1;
+    bucketStart.resize(bucketCount + 1);
+    faceCells.resize(faceCount * 6);
+    for (int i = 0; i <= bucketCount; ++i) {
+        bucketStart[i] = 0;
+    }
+
+    // first pass : cells of each face (swept bounding box) and buckets sizes
+    for (int i = 0; i < faceCount; ++i) {
+        const btSoftBody::Face& f = body->m_faces[i];
+        btVector3 min = f.m_n[0]->m_x;
+        btVector3 max = min;
+        for (int j = 0; j < 3; ++j) {
+            min.setMin(f.m_n[j]->m_x);
+            max.setMax(f.m_n[j]->m_x);
+            min.setMin(f.m_n[j]->m_q);
+            max.setMax(f.m_n[j]->m_q);
+        }
+        btVector3 margin(thickness, thickness, thickness);
+        min -= margin;
+        max += margin;
+        int* cells = &faceCells[i * 6];
+        for (int k = 0; k < 3; ++k) {
+            cells[k] = cell(min[k]);
+            cells[k + 3] = cell(max[k]);
+        }
+        for (int x = cells[0]; x <= cells[3]; ++x) {
+            for (int y = cells[1]; y <= cells[4]; ++y) {
+                for (int z = cells[2]; z <= cells[5]; ++z) {
+                    bucketStart[bucket(x, y, z) + 1]++;
+                }
+            }
+        }
+    }
+    for (int i = 0; i < bucketCount; ++i) {
+        bucketStart[i + 1] += bucketStart[i];
+    }
+
+    // second pass : fill the buckets
+    entries.resize(bucketStart[bucketCount]);
+    fill.resize(bucketCount);
+    for (int i = 0; i < bucketCount; ++i) {
+        fill[i] = bucketStart[i];
+    }
+    for (int i = 0; i < faceCount; ++i) {
+        const int* cells = &faceCells[i * 6];
+        for (int x = cells[0]; x <= cells[3]; ++x) {
+            for (int y = cells[1]; y <= cells[4]; ++y) {
+                for (int z = cells[2]; z <= cells[5]; ++z) {
+                    const int b = bucket(x, y, z);
+                    // a face can fall many times in the same bucket
+                    if (fill[b] == bucketStart[b] || entries[fill[b] - 1] != i) {
+                        entries[fill[b]++] = i;
+                    }
+                }
+            }
+        }
+    }
+    // close the gaps left by the skipped duplicates
+    int write = 0;
+    for (int i = 0; i < bucketCount; ++i) {
+        const int begin = bucketStart[i];
+        bucketStart[i] = write;
+        for (int j = begin; j < fill[i]; ++j) {
+            entries[write++] = entries[j];
+        }
+    }
+    bucketStart[bucketCount] = write;
+}
+
+int jmeSoftBodySelfCollision::collide() {
+    int contacts = 0;
+    const int nodeCount = body->m_nodes.size();
+    if (firstNode >= nodeCount) {
+        firstNode = 0;
+    }
+    for (int k = 0; k < nodeCount; ++k) {
+        const int i = (firstNode + k) % nodeCount;
+        btSoftBody::Node& node = body->m_nodes[i];
+        const int b = bucket(cell(node.m_x.x()), cell(node.m_x.y()), cell(node.m_x.z()));
+        for (int j = bucketStart[b]; j < bucketStart[b + 1]; ++j) {
+            if (budget > 0 && lastTests >= budget) {
+                // start from this node at the next step
+                firstNode = i;
+                return contacts;
+            }
+            const btSoftBody::Face& face = body->m_faces[entries[j]];
+            if (face.m_n[0] == &node || face.m_n[1] == &node || face.m_n[2] == &node) {
+                continue;
+            }
+            lastTests++;
+            if (collide(node, face)) {
+                contacts++;
+            }
+        }
+    }
+    return contacts;
+}
+
+bool jmeSoftBodySelfCollision::collide(btSoftBody::Node& node, const btSoftBody::Face& face) {
+    btSoftBody::Node* n0 = face.m_n[0];
+    btSoftBody::Node* n1 = face.m_n[1];
+    btSoftBody::Node* n2 = face.m_n[2];
+    if (node.m_im + n0->m_im + n1->m_im + n2->m_im <= 0) {
+        return false;
+    }
+
+    // current plane
+    const btVector3 e1 = n1->m_x - n0->m_x;
+    const btVector3 e2 = n2->m_x - n0->m_x;
+    btVector3 normal = btCross(e1, e2);
+    const btScalar area = normal.length();
+    if (area <= SIMD_EPSILON) {
+        return false;
+    }
+    normal /= area;
+    const btVector3 d = node.m_x - n0->m_x;
+    const btScalar distance = btDot(d, normal);
+    // previous plane (not normalized)
+    const btVector3 previous = btCross(n1->m_q - n0->m_q, n2->m_q - n0->m_q);
+    if (distance > thickness * 2 || distance < -thickness * 2) {
+        // too far, unless the node went through the face during this step
+        if (btDot(node.m_q - n0->m_q, previous) * distance >= 0) {
+            return false;
+        }
+    }
+
+    // barycentric coordinates of the projection on the plane
+    const btScalar d11 = btDot(e1, e1);
+    const btScalar d12 = btDot(e1, e2);
+    const btScalar d22 = btDot(e2, e2);
+    const btScalar d1 = btDot(d, e1);
+    const btScalar d2 = btDot(d, e2);
+    const btScalar denom = d11 * d22 - d12 * d12;
+    if (denom <= SIMD_EPSILON) {
+        return false;
+    }
+    const btScalar v = (d22 * d1 - d12 * d2) / denom;
+    const btScalar w = (d11 * d2 - d12 * d1) / denom;
+    const btScalar u = 1 - v - w;
+    if (u < 0 || v < 0 || w < 0) {
+        return false;
+    }
+
+    // side of the face at the previous step
+    btScalar side = btDot(node.m_q - (n0->m_q * u + n1->m_q * v + n2->m_q * w), previous);
+    if (side == 0) {
+        side = distance;
+    }
+    const btScalar sign = side < 0 ? btScalar(-1) : btScalar(1);
+    const btScalar depth = thickness - distance * sign;
+    if (depth <= 0) {
+        return false;
+    }
+
+    // move the node and the face apart, weighted by the inverse masses
+    const btScalar weight = node.m_im + n0->m_im * u * u + n1->m_im * v * v + n2->m_im * w * w;
+    if (weight <= SIMD_EPSILON) {
+        return false;
+    }
+    const btVector3 impulse = normal * (sign * depth / weight);
+    node.m_x += impulse * node.m_im;
+    n0->m_x -= impulse * (n0->m_im * u);
+    n1->m_x -= impulse * (n1->m_im * v);
+    n2->m_x -= impulse * (n2->m_im * w);
+    return true;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeSoftBodySelfCollision
+#define _Included_jmeSoftBodySelfCollision
+#include "BulletSoftBody/btSoftBody.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+// collision flag (in btSoftBody::Config::collisions) enabling the jme vertex
+// versus face self collision, unused by bullet (see btSoftBody::fCollision)
+#define JME_VF_SELF 0x0080
+
+// defaults of a body without self collision state
+#define JME_VF_SELF_THICKNESS 0.02f
+#define JME_VF_SELF_BUDGET 0
+
+/**
+ * Vertex versus face self collision of a soft body (cloth), run after the
+ * motion prediction and before bullet solve the soft body constraints.
+ * Faces are stored in a spatial hash (swept bounding box inflated by the
+ * thickness), each node is tested against the faces of its cell only, and
+ * pushed back on the side of the face it was on at the previous step.
+ * The number of node-face tests per step can be bounded by a budget.
+ *
+ * Author: dokthar
+ */
+class jmeSoftBodySelfCollision {
+public:
+    jmeSoftBodySelfCollision(btSoftBody* body);
+
+    btScalar thickness;
+    // maximum number of node-face tests per step, 0 for no limit
+    int budget;
+
+    // stats of the last step
+    btScalar lastTime; // in milliseconds
+    int lastTests;
+    int lastContacts;
+
+    void postTick(btScalar timeStep);
+
+private:
+    btSoftBody* body;
+    btScalar cellSize;
+    // first node tested, the nodes left untested when the budget is reached
+    // are tested first at the next step
+    int firstNode;
+    int bucketMask;
+    // buckets of the spatial hash, faces indexes of a bucket are stored in
+    // entries[bucketStart[i], bucketStart[i+1]), storage is kept between steps
+    btAlignedObjectArray<int> bucketStart;
+    btAlignedObjectArray<int> entries;
+    btAlignedObjectArray<int> fill;
+    // min and max cell of each face
+    btAlignedObjectArray<int> faceCells;
+
+    void buildHash();
+    int collide();
+    bool collide(btSoftBody::Node& node, const btSoftBody::Face& face);
+
+    inline int cell(btScalar value) const {
+        return (int) floor(value / cellSize);
+    }
+
+    // unsigned, the products overflow for most cells
+    inline int bucket(int x, int y, int z) const {
+        return (int) (((unsigned int) x * 73856093u) ^ ((unsigned int) y * 19349663u) ^ ((unsigned int) z * 83492791u)) & bucketMask;
+    }
+};
+#endif
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeSoftBodySkin.h"
+
+/**
+ * Author: dokthar
+ */
+jmeSoftBodySkin::jmeSoftBodySkin(btSoftBody* body)
+: body(body), hasPose(false) {
+}
+
+jmeSoftBodySkin::~jmeSoftBodySkin() {
+    clearPins();
+}
+
+void jmeSoftBodySkin::setPins(const jint* nodes, const jint* boneIndexes, const jfloat* weights, const jfloat* bindPositions, int count) {
+    clearPins();
+    const int nodeCount = body->m_nodes.size();
+    pins.reserve(count);
+    // a node pinned twice keeps its first pin, the second one would save the
+    // zero inverse mass set by the first one
+    btAlignedObjectArray<unsigned char> pinned;
+    pinned.resize(nodeCount, 0);
+    for (int i = 0; i < count; ++i) {
+        if (nodes[i] < 0 || nodes[i] >= nodeCount || pinned[nodes[i]]) {
+            continue;
+        }
+        pinned[nodes[i]] = 1;
+        Pin pin;
+        pin.node = nodes[i];
+        for (int j = 0; j < 4; ++j) {
+            pin.bones[j] = boneIndexes[i * 4 + j];
+            pin.weights[j] = weights[i * 4 + j];
+        }
+        pin.bindPosition.setValue(bindPositions[i * 3 + 0], bindPositions[i * 3 + 1], bindPositions[i * 3 + 2]);
+
+        // the node is driven by the skeleton : no inverse mass, the solver will not move it
+        btSoftBody::Node& n = body->m_nodes[pin.node];
+        pin.mass = n.m_im > 0 ? 1 / n.m_im : 0;
+        n.m_im = 0;
+        pins.push_back(pin);
+    }
+    body->m_bUpdateRtCst = true;
+}
+
+void jmeSoftBodySkin::clearPins() {
+    const int nodeCount = body->m_nodes.size();
+    for (int i = 0; i < pins.size(); ++i) {
+        const Pin& pin = pins[i];
+        if (pin.node < nodeCount) {
+            body->m_nodes[pin.node].m_im = pin.mass > 0 ? 1 / pin.mass : 0;
+        }
+    }
+    if (pins.size() > 0) {
+        body->m_bUpdateRtCst = true;
+    }
+    pins.clear();
+}
+
+int jmeSoftBodySkin::getPinCount() {
+    return pins.size();
+}
+
+void jmeSoftBodySkin::setBoneMatrices(const jfloat* matrices, int boneCount, const btTransform& modelToWorld, const btVector3& scale) {
+    // the model scale is not supported by btTransform, put it into the basis
+    btTransform world = modelToWorld;
+    world.getBasis() = world.getBasis().scaled(scale);
+
+    bones.resize(boneCount);
+    for (int i = 0; i < boneCount; ++i) {
+        const jfloat* m = &matrices[i * 12];
+        btTransform bone;
+        bone.getBasis().setValue(m[0], m[1], m[2],
+                m[4], m[5], m[6],
+                m[8], m[9], m[10]);
+        bone.setOrigin(btVector3(m[3], m[7], m[11]));
+        bones[i] = world * bone;
+    }
+    hasPose = boneCount > 0;
+    if (hasPose && pins.size() > 0) {
+        body->activate();
+    }
+}
+
+void jmeSoftBodySkin::preTick(btScalar timeStep) {
+    const btScalar sdt = timeStep * body->m_cfg.timescale;
+    if (!hasPose || sdt <= 0) {
+        return;
+    }
+    const btScalar isdt = 1 / sdt;
+    const int boneCount = bones.size();
+    const int nodeCount = body->m_nodes.size();
+
+    for (int i = 0; i < pins.size(); ++i) {
+        const Pin& pin = pins[i];
+        if (pin.node >= nodeCount) {
+            continue;
+        }
+        // linear blend skinning, btVector3 / btMatrix3x3 math use SSE when available
+        btVector3 target(0, 0, 0);
+        btScalar totalWeight = 0;
+        for (int j = 0; j < 4; ++j) {
+            const btScalar w = pin.weights[j];
+            const int bone = pin.bones[j];
+            if (w != 0 && bone >= 0 && bone < boneCount) {
+                target += bones[bone](pin.bindPosition) * w;
+                totalWeight += w;
+            }
+        }
+        if (totalWeight <= 0) {
+            continue;
+        }
+        target /= totalWeight;
+
+        // predictMotion will integrate this velocity : the node reach its target at the end of the tick
+        btSoftBody::Node& n = body->m_nodes[pin.node];
+        n.m_v = (target - n.m_x) * isdt;
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeSoftBodySkin
+#define _Included_jmeSoftBodySkin
+#include <jni.h>
+#include "BulletSoftBody/btSoftBody.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+/**
+ * Skinned pins of a soft body : a set of nodes driven by the skeleton
+ * (linear blend skinning with 4 bones per node). Pinned nodes are made
+ * kinematic (no inverse mass) and their velocity is set at each internal tick
+ * so they reach the skinned position at the end of the step.
+ *
+ * Author: dokthar
+ */
+class jmeSoftBodySkin {
+public:
+
+    struct Pin {
+        int node;
+        int bones[4];
+        btScalar weights[4];
+        btVector3 bindPosition;
+        btScalar mass;
+    };
+
+    jmeSoftBodySkin(btSoftBody* body);
+    ~jmeSoftBodySkin();
+
+    void setPins(const jint* nodes, const jint* bones, const jfloat* weights, const jfloat* bindPositions, int count);
+    void clearPins();
+    int getPinCount();
+
+    // 12 floats per bone (3x4 row major), the modelToWorld transform is applied to each bone
+    void setBoneMatrices(const jfloat* matrices, int boneCount, const btTransform& modelToWorld, const btVector3& scale);
+
+    void preTick(btScalar timeStep);
+
+private:
+    btSoftBody* body;
+    btAlignedObjectArray<Pin> pins;
+    btAlignedObjectArray<btTransform> bones;
+    bool hasPose;
+};
+#endif
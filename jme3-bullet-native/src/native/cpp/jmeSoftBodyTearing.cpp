@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeSoftBodyTearing.h"
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/**
+ * Author: dokthar
+ */
+
+// the lock of the deltas and render primitives, read by the render thread
+// while the physics may be stepped on its own thread
+#ifdef _WIN32
+static SRWLOCK deltasLock = SRWLOCK_INIT;
+
+static void lockDeltas() {
+    AcquireSRWLockExclusive(&deltasLock);
+}
+
+static void unlockDeltas() {
+    ReleaseSRWLockExclusive(&deltasLock);
+}
+#else
+static pthread_mutex_t deltasLock = PTHREAD_MUTEX_INITIALIZER;
+
+static void lockDeltas() {
+    pthread_mutex_lock(&deltasLock);
+}
+
+static void unlockDeltas() {
+    pthread_mutex_unlock(&deltasLock);
+}
+#endif
+
+// the most stretched links first, then by index
+struct jmeTearCandidateGreater {
+
+    bool operator()(const jmeTearCandidate& a, const jmeTearCandidate& b) const {
+        return a.strain > b.strain || (a.strain == b.strain && a.link < b.link);
+    }
+};
+
+struct jmeIntLess {
+
+    bool operator()(int a, int b) const {
+        return a < b;
+    }
+};
+
+// 1 on the side of the other node of the torn link, 0 otherwise
+static inline int jmeTearSide(const btVector3& point, const btVector3& origin, const btVector3& direction) {
+    return (point - origin).dot(direction) > 0 ? 1 : 0;
+}
+
+static inline bool jmeFaceHasNode(const btSoftBody::Face& face, const btSoftBody::Node* node) {
+    return face.m_n[0] == node || face.m_n[1] == node || face.m_n[2] == node;
+}
+
+jmeSoftBodyTearing::jmeSoftBodyTearing(btSoftBody* body, const jint* triangles, int indexCount, int primitiveSize, const jint* jme2bulletMap, int vertexCount, int maxVertexCount)
+: strainThreshold(2), maxTears(16), body(body), primitiveSize(primitiveSize), vertexCount(vertexCount), maxVertexCount(maxVertexCount), vertexDeltasRead(0) {
+    const int triangleCount = indexCount / primitiveSize;
+    this->triangles.resize(triangleCount * primitiveSize);
+    for (int i = 0; i < triangleCount * primitiveSize; ++i) {
+        this->triangles[i] = triangles[i];
+    }
+    nodeIndexes.resize(maxVertexCount, 0);
+    for (int i = 0; i < vertexCount; ++i) {
+        nodeIndexes[i] = jme2bulletMap != NULL ? jme2bulletMap[i] : i;
+    }
+    triangleChanged.resize(triangleCount, false);
+    vertexSides.resize(maxVertexCount, 0);
+    // each split adds a node, and at most as many vertexes
+    maxNodeCount = body->m_nodes.size() + maxVertexCount - vertexCount;
+    reserveNodes(maxNodeCount);
+}
+
+void jmeSoftBodyTearing::reserveNodes(int count) {
+    if (body->m_nodes.capacity() >= count || body->m_nodes.size() == 0) {
+        return;
+    }
+    // pointersToIndices don't handle the tetras and the clusters
+    btSoftBody::Node* base = &body->m_nodes[0];
+    btAlignedObjectArray<int> tetraNodes;
+    tetraNodes.resize(body->m_tetras.size() * 4);
+    for (int i = 0; i < body->m_tetras.size(); ++i) {
+        for (int k = 0; k < 4; ++k) {
+            tetraNodes[i * 4 + k] = int(body->m_tetras[i].m_n[k] - base);
+        }
+    }
+    btAlignedObjectArray<int> clusterNodes;
+    for (int i = 0; i < body->m_clusters.size(); ++i) {
+        btSoftBody::Cluster* cluster = body->m_clusters[i];
+        for (int j = 0; j < cluster->m_nodes.size(); ++j) {
+            clusterNodes.push_back(int(cluster->m_nodes[j] - base));
+        }
+    }
+    body->pointersToIndices();
+    body->m_nodes.reserve(count);
+    body->indicesToPointers();
+    base = &body->m_nodes[0];
+    for (int i = 0; i < body->m_tetras.size(); ++i) {
+        for (int k = 0; k < 4; ++k) {
+            body->m_tetras[i].m_n[k] = base + tetraNodes[i * 4 + k];
+        }
+    }
+    int index = 0;
+    for (int i = 0; i < body->m_clusters.size(); ++i) {
+        btSoftBody::Cluster* cluster = body->m_clusters[i];
+        for (int j = 0; j < cluster->m_nodes.size(); ++j) {
+            cluster->m_nodes[j] = base + clusterNodes[index++];
+        }
+    }
+    // the contacts of the last step point to the old nodes
+    body->m_rcontacts.resize(0);
+    body->m_scontacts.resize(0);
+}
+
+void jmeSoftBodyTearing::postTick(btScalar timeStep) {
+    candidates.resize(0);
+    for (int i = 0; i < body->m_links.size(); ++i) {
+        const btSoftBody::Link& link = body->m_links[i];
+        if (link.m_rl <= SIMD_EPSILON) {
+            continue;
+        }
+        const btScalar strain = (link.m_n[1]->m_x - link.m_n[0]->m_x).length() / link.m_rl;
+        if (strain > strainThreshold) {
+            jmeTearCandidate& candidate = candidates.expand();
+            candidate.link = i;
+            candidate.strain = strain;
+        }
+    }
+    if (candidates.size() == 0) {
+        return;
+    }
+    candidates.quickSort(jmeTearCandidateGreater());
+
+    lockDeltas();
+    // the nodes of a torn link are not torn again in the same step
+    nodeTorn.resize(0);
+    nodeTorn.resize(maxNodeCount, false);
+    removedLinks.resize(0);
+    int tears = 0;
+    for (int i = 0; i < candidates.size() && tears < maxTears; ++i) {
+        const btSoftBody::Link& link = body->m_links[candidates[i].link];
+        const int node0 = int(link.m_n[0] - &body->m_nodes[0]);
+        const int node1 = int(link.m_n[1] - &body->m_nodes[0]);
+        if (nodeTorn[node0] || nodeTorn[node1]) {
+            continue;
+        }
+        int result = split(node0, node1, candidates[i].link);
+        if (result == 0) {
+            result = split(node1, node0, candidates[i].link);
+        }
+        if (result < 0) {
+            break;
+        }
+        if (result == 0) {
+            removedLinks.push_back(candidates[i].link);
+        } else {
+            // the new node holds one end of the link
+            nodeTorn[body->m_nodes.size() - 1] = true;
+        }
+        nodeTorn[node0] = true;
+        nodeTorn[node1] = true;
+        tears++;
+    }
+    unlockDeltas();
+    if (tears == 0) {
+        return;
+    }
+    // from the last link, so the indexes to remove stay valid
+    removedLinks.quickSort(jmeIntLess());
+    for (int i = removedLinks.size() - 1; i >= 0; --i) {
+        body->m_links.swap(removedLinks[i], body->m_links.size() - 1);
+        body->m_links.pop_back();
+    }
+    // masses and areas have changed
+    body->updateLinkConstants();
+    body->updateArea();
+}
+
+int jmeSoftBodyTearing::split(int node, int other, int link) {
+    if (body->m_nodes.size() >= maxNodeCount) {
+        return -1;
+    }
+    btSoftBody::Node* a = &body->m_nodes[node];
+    const btVector3 origin = a->m_x;
+    const btVector3 direction = body->m_nodes[other].m_x - origin;
+
+    // faces of the node, an index and a side each
+    nodeFaces.resize(0);
+    int farFaces = 0;
+    for (int i = 0; i < body->m_faces.size(); ++i) {
+        const btSoftBody::Face& face = body->m_faces[i];
+        if (jmeFaceHasNode(face, a)) {
+            const btVector3 center = (face.m_n[0]->m_x + face.m_n[1]->m_x + face.m_n[2]->m_x) / btScalar(3);
+            const int side = jmeTearSide(center, origin, direction);
+            nodeFaces.push_back(i * 2 + side);
+            farFaces += side;
+        }
+    }
+    if (nodeFaces.size() > 0 && (farFaces == 0 || farFaces == nodeFaces.size())) {
+        return 0;
+    }
+    if (nodeFaces.size() == 0) {
+        // a rope node, split if an other link stay on the node
+        bool nearLink = false;
+        for (int i = 0; i < body->m_links.size() && !nearLink; ++i) {
+            const btSoftBody::Link& l = body->m_links[i];
+            if (i != link && (l.m_n[0] == a || l.m_n[1] == a)) {
+                const btSoftBody::Node* o = l.m_n[0] == a ? l.m_n[1] : l.m_n[0];
+                nearLink = jmeTearSide(o->m_x, origin, direction) == 0;
+            }
+        }
+        if (!nearLink) {
+            return 0;
+        }
+    }
+
+    // render triangles (or lines) and vertexes of the node, vertexSides :
+    // 1 near, 2 far
+    nodeTriangles.resize(0);
+    nodeVertexes.resize(0);
+    const int triangleCount = triangles.size() / primitiveSize;
+    for (int t = 0; t < triangleCount; ++t) {
+        const int* tri = &triangles[t * primitiveSize];
+        bool hasNode = false;
+        btVector3 center(0, 0, 0);
+        for (int k = 0; k < primitiveSize; ++k) {
+            hasNode |= nodeIndexes[tri[k]] == node;
+            center += body->m_nodes[nodeIndexes[tri[k]]].m_x;
+        }
+        if (!hasNode) {
+            continue;
+        }
+        center /= btScalar(primitiveSize);
+        const int side = jmeTearSide(center, origin, direction);
+        nodeTriangles.push_back(t * 2 + side);
+        for (int k = 0; k < primitiveSize; ++k) {
+            const int v = tri[k];
+            if (nodeIndexes[v] == node) {
+                if (vertexSides[v] == 0) {
+                    nodeVertexes.push_back(v);
+                }
+                vertexSides[v] |= side + 1;
+            }
+        }
+    }
+    int newVertexes = 0;
+    for (int i = 0; i < nodeVertexes.size(); ++i) {
+        if (vertexSides[nodeVertexes[i]] == 3) {
+            newVertexes++;
+        }
+    }
+    if (vertexCount + newVertexes > maxVertexCount) {
+        for (int i = 0; i < nodeVertexes.size(); ++i) {
+            vertexSides[nodeVertexes[i]] = 0;
+        }
+        return -1;
+    }
+
+    // the new node, with half of the mass
+    const btScalar mass = a->m_im > 0 ? 1 / a->m_im : 0;
+    body->appendNode(origin, mass / 2);
+    const int newNode = body->m_nodes.size() - 1;
+    a = &body->m_nodes[node];
+    btSoftBody::Node* c = &body->m_nodes[newNode];
+    if (a->m_im > 0) {
+        a->m_im *= 2;
+    }
+    c->m_q = a->m_q;
+    c->m_v = a->m_v;
+    c->m_n = a->m_n;
+    c->m_material = a->m_material;
+    // the pose matching is indexed by node
+    if (body->m_pose.m_pos.size() > node) {
+        const btVector3 pos = body->m_pose.m_pos[node];
+        const btScalar weight = body->m_pose.m_wgh[node] / 2;
+        body->m_pose.m_pos.push_back(pos);
+        body->m_pose.m_wgh[node] = weight;
+        body->m_pose.m_wgh.push_back(weight);
+    }
+
+    for (int i = 0; i < nodeFaces.size(); ++i) {
+        if (nodeFaces[i] & 1) {
+            btSoftBody::Face& face = body->m_faces[nodeFaces[i] / 2];
+            for (int k = 0; k < 3; ++k) {
+                if (face.m_n[k] == a) {
+                    face.m_n[k] = c;
+                }
+            }
+        }
+    }
+    // links follow the faces of their edge, on both sides they are doubled
+    sharedLinks.resize(0);
+    for (int i = 0; i < body->m_links.size(); ++i) {
+        btSoftBody::Link& l = body->m_links[i];
+        const int k = l.m_n[0] == a ? 0 : (l.m_n[1] == a ? 1 : -1);
+        if (k < 0) {
+            continue;
+        }
+        if (i == link) {
+            l.m_n[k] = c;
+            continue;
+        }
+        const btSoftBody::Node* o = l.m_n[1 - k];
+        bool nearFace = false;
+        bool farFace = false;
+        for (int j = 0; j < nodeFaces.size(); ++j) {
+            const btSoftBody::Face& face = body->m_faces[nodeFaces[j] / 2];
+            if (jmeFaceHasNode(face, o)) {
+                nearFace |= (nodeFaces[j] & 1) == 0;
+                farFace |= (nodeFaces[j] & 1) == 1;
+            }
+        }
+        if (nearFace && farFace) {
+            sharedLinks.push_back(i * 2 + k);
+        } else if (farFace || (!nearFace && jmeTearSide(o->m_x, origin, direction) == 1)) {
+            l.m_n[k] = c;
+        }
+    }
+    for (int i = 0; i < sharedLinks.size(); ++i) {
+        btSoftBody::Link copy = body->m_links[sharedLinks[i] / 2];
+        copy.m_n[sharedLinks[i] & 1] = c;
+        body->m_links.push_back(copy);
+    }
+
+    // render vertexes only on the far side move to the new node, the ones on
+    // both sides are duplicated for the far side triangles
+    for (int i = 0; i < nodeVertexes.size(); ++i) {
+        const int v = nodeVertexes[i];
+        int target = v;
+        if (vertexSides[v] == 3) {
+            target = vertexCount++;
+        }
+        if (vertexSides[v] != 1) {
+            nodeIndexes[target] = newNode;
+            vertexDeltas.push_back(target);
+            vertexDeltas.push_back(v);
+            vertexDeltas.push_back(newNode);
+        }
+        // keep the duplicate, as a negative value, for the triangles
+        vertexSides[v] = target != v ? -1 - target : 0;
+    }
+    for (int i = 0; i < nodeTriangles.size(); ++i) {
+        if ((nodeTriangles[i] & 1) == 0) {
+            continue;
+        }
+        const int t = nodeTriangles[i] / 2;
+        for (int k = 0; k < primitiveSize; ++k) {
+            const int v = triangles[t * primitiveSize + k];
+            if (vertexSides[v] < 0) {
+                triangles[t * primitiveSize + k] = -1 - vertexSides[v];
+                changeTriangle(t);
+            }
+        }
+    }
+    for (int i = 0; i < nodeVertexes.size(); ++i) {
+        vertexSides[nodeVertexes[i]] = 0;
+    }
+    return 1;
+}
+
+void jmeSoftBodyTearing::changeTriangle(int triangle) {
+    if (!triangleChanged[triangle]) {
+        triangleChanged[triangle] = true;
+        triangleDeltas.push_back(triangle);
+    }
+}
+
+int jmeSoftBodyTearing::getVertexDeltas(jint* store, int max) {
+    lockDeltas();
+    const int count = btMin(max, (vertexDeltas.size() - vertexDeltasRead) / 3);
+    for (int i = 0; i < count * 3; ++i) {
+        store[i] = vertexDeltas[vertexDeltasRead + i];
+    }
+    vertexDeltasRead += count * 3;
+    if (vertexDeltasRead == vertexDeltas.size()) {
+        vertexDeltas.resize(0);
+        vertexDeltasRead = 0;
+    }
+    unlockDeltas();
+    return count;
+}
+
+int jmeSoftBodyTearing::getTriangleDeltas(jint* store, int max) {
+    lockDeltas();
+    if (vertexDeltas.size() > 0) {
+        unlockDeltas();
+        return 0;
+    }
+    const int count = btMin(max, triangleDeltas.size());
+    for (int i = 0; i < count; ++i) {
+        const int t = triangleDeltas[triangleDeltas.size() - 1];
+        triangleDeltas.pop_back();
+        triangleChanged[t] = false;
+        store[i * 4 + 0] = t;
+        for (int k = 0; k < 3; ++k) {
+            store[i * 4 + 1 + k] = k < primitiveSize ? triangles[t * primitiveSize + k] : -1;
+        }
+    }
+    unlockDeltas();
+    return count;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeSoftBodyTearing
+#define _Included_jmeSoftBodyTearing
+#include <jni.h>
+#include "BulletSoftBody/btSoftBody.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+struct jmeTearCandidate {
+    int link;
+    btScalar strain;
+};
+
+/**
+ * Tearing of a soft body (cloth or rope), run after the motion prediction.
+ * A link stretched over the strain threshold (length / rest length) is torn
+ * by splitting one of its nodes along the plane orthogonal to the link : a
+ * new node takes half of the mass, the faces and links on the far side of
+ * the plane. A node which can't be split (all its faces on one side) only
+ * loses the link.
+ * The render mesh (jme triangles, or lines for a rope, and jme to bullet map)
+ * is split the same way, the changes are queued as deltas : new vertexes
+ * (vertex, source vertex, node) and updated triangles (triangle, 3 indexes,
+ * the last one is -1 for a line), the new vertexes are always read before the
+ * triangles using them. The deltas are guarded by a lock, so they can be read
+ * while the physics is stepped on another thread.
+ * Nodes are reserved up front so the node pointers never move while tearing.
+ *
+ * Author: dokthar
+ */
+class jmeSoftBodyTearing {
+public:
+    // primitiveSize : 3 for triangles, 2 for lines
+    jmeSoftBodyTearing(btSoftBody* body, const jint* triangles, int indexCount, int primitiveSize, const jint* jme2bulletMap, int vertexCount, int maxVertexCount);
+
+    btScalar strainThreshold;
+    // maximum number of links torn per step
+    int maxTears;
+
+    void postTick(btScalar timeStep);
+
+    // store at most max deltas, return the number of deltas stored
+    int getVertexDeltas(jint* store, int max);
+    // nothing is stored while there are new vertexes to read
+    int getTriangleDeltas(jint* store, int max);
+
+private:
+    btSoftBody* body;
+    btAlignedObjectArray<int> triangles;
+    int primitiveSize;
+    btAlignedObjectArray<int> nodeIndexes;
+    int vertexCount;
+    int maxVertexCount;
+    int maxNodeCount;
+
+    btAlignedObjectArray<int> vertexDeltas;
+    int vertexDeltasRead;
+    btAlignedObjectArray<int> triangleDeltas;
+    btAlignedObjectArray<bool> triangleChanged;
+
+    // per step scratch buffers
+    btAlignedObjectArray<jmeTearCandidate> candidates;
+    btAlignedObjectArray<bool> nodeTorn;
+    btAlignedObjectArray<int> removedLinks;
+    // per split scratch buffers, vertexSides is kept cleared
+    btAlignedObjectArray<int> nodeFaces;
+    btAlignedObjectArray<int> nodeTriangles;
+    btAlignedObjectArray<int> nodeVertexes;
+    btAlignedObjectArray<int> vertexSides;
+    btAlignedObjectArray<int> sharedLinks;
+
+    void reserveNodes(int count);
+    // 1 if split, 0 if the node can't be split, -1 if there is no room left
+    int split(int node, int other, int link);
+    void changeTriangle(int triangle);
+};
+#endif
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeTickPlugins.h"
+
+/**
+ * Author: dokthar
+ */
+jmeTickPlugins::jmeTickPlugins() : nextId(1) {
+}
+
+int jmeTickPlugins::add(jmeTickFunction function, void* userData, bool preTick) {
+    jmeTickPlugin plugin;
+    plugin.id = nextId++;
+    plugin.function = function;
+    plugin.userData = userData;
+    if (preTick) {
+        prePlugins.push_back(plugin);
+    } else {
+        postPlugins.push_back(plugin);
+    }
+    return plugin.id;
+}
+
+bool jmeTickPlugins::remove(int id) {
+    return remove(prePlugins, id) || remove(postPlugins, id);
+}
+
+bool jmeTickPlugins::remove(btAlignedObjectArray<jmeTickPlugin>& plugins, int id) {
+    for (int i = 0; i < plugins.size(); i++) {
+        if (plugins[i].id == id) {
+            // keep the registration order
+            for (int j = i + 1; j < plugins.size(); j++) {
+                plugins[j - 1] = plugins[j];
+            }
+            plugins.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void jmeTickPlugins::preTick(btDynamicsWorld* world, btScalar timeStep) {
+    for (int i = 0; i < prePlugins.size(); i++) {
+        prePlugins[i].function(world, timeStep, prePlugins[i].userData);
+    }
+}
+
+void jmeTickPlugins::postTick(btDynamicsWorld* world, btScalar timeStep) {
+    for (int i = 0; i < postPlugins.size(); i++) {
+        postPlugins[i].function(world, timeStep, postPlugins[i].userData);
+    }
+}
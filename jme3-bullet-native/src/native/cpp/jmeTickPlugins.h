@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeTickPlugins
+#define _Included_jmeTickPlugins
+#include "btBulletDynamicsCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+/**
+ * Tick plugin ABI : a native function called on each internal tick of a
+ * physics space, before or after the simulation step, with direct access to
+ * the dynamics world and without any JNI call.
+ * A plugin library gives the address of its function to java (for example
+ * from a JNI method returning it as a long) which registers it with
+ * PhysicsSpace.addNativeTickCallback(). The plugin must be compiled against
+ * the same bullet version as the natives.
+ */
+extern "C" {
+    typedef void (*jmeTickFunction)(btDynamicsWorld* world, btScalar timeStep, void* userData);
+}
+
+/**
+ * The tick plugins of a physics space, called in registration order.
+ *
+ * Author: dokthar
+ */
+class jmeTickPlugins {
+public:
+    jmeTickPlugins();
+
+    // returns the id of the plugin
+    int add(jmeTickFunction function, void* userData, bool preTick);
+    bool remove(int id);
+    void preTick(btDynamicsWorld* world, btScalar timeStep);
+    void postTick(btDynamicsWorld* world, btScalar timeStep);
+
+private:
+    struct jmeTickPlugin {
+        int id;
+        jmeTickFunction function;
+        void* userData;
+    };
+    btAlignedObjectArray<jmeTickPlugin> prePlugins;
+    btAlignedObjectArray<jmeTickPlugin> postPlugins;
+    int nextId;
+
+    bool remove(btAlignedObjectArray<jmeTickPlugin>& plugins, int id);
+};
+#endif
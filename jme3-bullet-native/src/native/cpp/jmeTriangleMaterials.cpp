@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "jmeTriangleMaterials.h"
+#include "jmeHeightfieldTerrainShape.h"
+
+/**
+ * Author: dokthar
+ */
+void jmeTriangleMaterials::set(btCollisionShape* shape, const unsigned char* materials, int count) {
+    const int type = shape->getShapeType();
+    if (type != TRIANGLE_MESH_SHAPE_PROXYTYPE && type != TERRAIN_SHAPE_PROXYTYPE) {
+        return;
+    }
+    jmeTriangleMaterials* triangleMaterials = (jmeTriangleMaterials*) shape->getUserPointer();
+    if (triangleMaterials == NULL) {
+        triangleMaterials = new jmeTriangleMaterials();
+        shape->setUserPointer(triangleMaterials);
+    }
+    triangleMaterials->materials.resize(count);
+    for (int i = 0; i < count; ++i) {
+        triangleMaterials->materials[i] = materials[i];
+    }
+    triangleMaterials->partOffsets.clear();
+    triangleMaterials->rowSize = 0;
+    if (type == TERRAIN_SHAPE_PROXYTYPE) {
+        triangleMaterials->rowSize = static_cast<jmeHeightfieldTerrainShape*> (shape)->getCellsPerRow();
+        return;
+    }
+    btStridingMeshInterface* mesh = static_cast<btTriangleMeshShape*> (shape)->getMeshInterface();
+    int offset = 0;
+    for (int part = 0; part < mesh->getNumSubParts(); ++part) {
+        const unsigned char* vertexBase;
+        const unsigned char* indexBase;
+        int numVerts, vertexStride, indexStride, numFaces;
+        PHY_ScalarType vertexType, indicesType;
+        mesh->getLockedReadOnlyVertexIndexBase(&vertexBase, numVerts, vertexType, vertexStride, &indexBase, indexStride, numFaces, indicesType, part);
+        mesh->unLockReadOnlyVertexBase(part);
+        triangleMaterials->partOffsets.push_back(offset);
+        offset += numFaces;
+    }
+}
+
+void jmeTriangleMaterials::release(btCollisionShape* shape) {
+    const int type = shape->getShapeType();
+    if (type != TRIANGLE_MESH_SHAPE_PROXYTYPE && type != TERRAIN_SHAPE_PROXYTYPE) {
+        return;
+    }
+    jmeTriangleMaterials* triangleMaterials = (jmeTriangleMaterials*) shape->getUserPointer();
+    if (triangleMaterials != NULL) {
+        delete triangleMaterials;
+        shape->setUserPointer(NULL);
+    }
+}
+
+int jmeTriangleMaterials::get(const btCollisionShape* shape, int partId, int triangleIndex) {
+    const int type = shape->getShapeType();
+    if (type != TRIANGLE_MESH_SHAPE_PROXYTYPE && type != TERRAIN_SHAPE_PROXYTYPE) {
+        return -1;
+    }
+    const jmeTriangleMaterials* triangleMaterials = (const jmeTriangleMaterials*) shape->getUserPointer();
+    if (triangleMaterials == NULL) {
+        return -1;
+    }
+    int index;
+    if (triangleMaterials->rowSize > 0) {
+        // heightfields give the cell x as part id and the cell y as index
+        index = triangleIndex * triangleMaterials->rowSize + partId;
+    } else {
+        if (partId < 0 || partId >= triangleMaterials->partOffsets.size()) {
+            return -1;
+        }
+        index = triangleMaterials->partOffsets[partId] + triangleIndex;
+    }
+    if (index < 0 || index >= triangleMaterials->materials.size()) {
+        return -1;
+    }
+    return triangleMaterials->materials[index];
+}
+
+int jmeTriangleMaterials::get(const btCollisionShape* shape, const btCollisionWorld::LocalShapeInfo* shapeInfo) {
+    if (shapeInfo == NULL) {
+        return -1;
+    }
+    return get(shape, shapeInfo->m_shapePart, shapeInfo->m_triangleIndex);
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _Included_jmeTriangleMaterials
+#define _Included_jmeTriangleMaterials
+#include "btBulletCollisionCommon.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+/**
+ * Material ids (one byte) of the triangles of a triangle mesh shape, or of
+ * the cells of a heightfield shape, stored in the shape user pointer. The
+ * material is resolved from the part id and triangle index given by bullet
+ * in the ray, sweep and contact results.
+ *
+ * Author: dokthar
+ */
+class jmeTriangleMaterials {
+public:
+    // copy the materials, meshes : one per triangle in the order of the
+    // parts, heightfields : one per cell, row after row
+    static void set(btCollisionShape* shape, const unsigned char* materials, int count);
+    static void release(btCollisionShape* shape);
+    // the material of the triangle, -1 if the shape has no materials
+    static int get(const btCollisionShape* shape, int partId, int triangleIndex);
+    static int get(const btCollisionShape* shape, const btCollisionWorld::LocalShapeInfo* shapeInfo);
+
+private:
+    btAlignedObjectArray<unsigned char> materials;
+    // first triangle of each part for meshes
+    btAlignedObjectArray<int> partOffsets;
+    // cells per row for heightfields, 0 for meshes
+    int rowSize;
+};
+#endif
@@ -0,0 +1,717 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "btBulletDynamicsCommon.h"
+#include "BulletCollision/CollisionDispatch/btGhostObject.h"
+#include "BulletCollision/Gimpact/btGImpactShape.h"
+#include "LinearMath/btHashMap.h"
+#include "LinearMath/btQuickprof.h"
+#include "jmeRecorder.h"
+#include "jmeCollisionAlgorithms.h"
+#include "jmeHeightfieldTerrainShape.h"
+
+/**
+ * Headless replay of a physics recording (see jmeRecorder), for the
+ * profiling of a recorded session without the application :
+ *
+ *     bulletreplay recording.bin [steps.csv]
+ *
+ * The recorded changes are applied before each tick and only the ticks are
+ * timed. The time of each recorded step is written as csv (step, ticks,
+ * collision objects, microseconds), to the standard output if no file is
+ * given, and a summary is printed on the error output.
+ *
+ * Author: dokthar
+ */
+class jmeReplayReader {
+public:
+
+    jmeReplayReader(FILE* file) : file(file), failed(false) {
+    }
+
+    bool read(void* data, int size) {
+        if (!failed && size > 0 && fread(data, 1, size, file) != (size_t) size) {
+            failed = true;
+        }
+        return !failed;
+    }
+
+    int readInt() {
+        int value = 0;
+        read(&value, sizeof (int));
+        return value;
+    }
+
+    long long readId() {
+        long long value = 0;
+        read(&value, sizeof (long long));
+        return value;
+    }
+
+    btScalar readScalar() {
+        btScalar value = 0;
+        read(&value, sizeof (btScalar));
+        return value;
+    }
+
+    btVector3 readVector() {
+        btVector3 vector(0, 0, 0);
+        read(vector.m_floats, 3 * sizeof (btScalar));
+        return vector;
+    }
+
+    btTransform readTransform() {
+        btScalar values[JME_TRANSFORM_SIZE];
+        memset(values, 0, sizeof (values));
+        read(values, sizeof (values));
+        btTransform transform;
+        jmeUnpackTransform(values, transform);
+        return transform;
+    }
+
+    bool hasFailed() const {
+        return failed;
+    }
+
+private:
+    FILE* file;
+    bool failed;
+};
+
+struct jmeReplayObject {
+    btCollisionObject* object;
+    int type;
+    int group;
+    int groups;
+};
+
+/**
+ * Steps one internal tick at a time, the kinematic velocities and the forces
+ * are the recorded ones.
+ */
+class jmeReplayWorld : public btDiscreteDynamicsWorld {
+public:
+
+    jmeReplayWorld(btDispatcher* dispatcher, btBroadphaseInterface* broadphase, btConstraintSolver* solver, btCollisionConfiguration* configuration)
+    : btDiscreteDynamicsWorld(dispatcher, broadphase, solver, configuration) {
+    }
+
+    void tick(btScalar timeStep) {
+        internalSingleStepSimulation(timeStep);
+    }
+};
+
+// the jme collision groups, as the filter callback of jmePhysicsSpace
+struct jmeReplayFilter : public btOverlapFilterCallback {
+
+    virtual bool needBroadphaseCollision(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1) const {
+        bool collides = (proxy0->m_collisionFilterGroup & proxy1->m_collisionFilterMask) != 0;
+        collides = collides && (proxy1->m_collisionFilterGroup & proxy0->m_collisionFilterMask);
+        if (!collides) {
+            return false;
+        }
+        jmeReplayObject* object0 = (jmeReplayObject*) ((btCollisionObject*) proxy0->m_clientObject)->getUserPointer();
+        jmeReplayObject* object1 = (jmeReplayObject*) ((btCollisionObject*) proxy1->m_clientObject)->getUserPointer();
+        if (object0 == NULL || object1 == NULL) {
+            return true;
+        }
+        return (object0->group & object1->groups) != 0 || (object1->group & object0->groups) != 0;
+    }
+};
+
+static btHashMap<btHashPtr, btCollisionShape*> shapes;
+static btHashMap<btHashPtr, jmeReplayObject*> objects;
+static btHashMap<btHashPtr, btTypedConstraint*> joints;
+
+static btHashPtr key(long long id) {
+    return btHashPtr((const void*) (size_t) id);
+}
+
+static btCollisionShape* findShape(long long id) {
+    btCollisionShape** shape = shapes.find(key(id));
+    return shape != NULL ? *shape : NULL;
+}
+
+static jmeReplayObject* findObject(long long id) {
+    jmeReplayObject** object = objects.find(key(id));
+    return object != NULL ? *object : NULL;
+}
+
+static btRigidBody* findBody(long long id) {
+    if (id == 0) {
+        return &btTypedConstraint::getFixedBody();
+    }
+    jmeReplayObject* object = findObject(id);
+    return object != NULL ? btRigidBody::upcast(object->object) : NULL;
+}
+
+static btCollisionShape* readTriangles(jmeReplayReader& reader, bool gimpact) {
+    // kept for the lifetime of the shape, so for the whole replay
+    int numVertices = reader.readInt();
+    btScalar* vertices = new btScalar[btMax(numVertices, 1) * 3];
+    reader.read(vertices, numVertices * 3 * sizeof (btScalar));
+    int numTriangles = reader.readInt();
+    int* indices = new int[btMax(numTriangles, 1) * 3];
+    reader.read(indices, numTriangles * 3 * sizeof (int));
+    btVector3 scaling = reader.readVector();
+    btScalar margin = reader.readScalar();
+    if (numTriangles == 0) {
+        return new btEmptyShape();
+    }
+    btTriangleIndexVertexArray* mesh = new btTriangleIndexVertexArray(numTriangles, indices, 3 * sizeof (int), numVertices, vertices, 3 * sizeof (btScalar));
+    btCollisionShape* shape;
+    if (gimpact) {
+        btGImpactMeshShape* gimpactShape = new btGImpactMeshShape(mesh);
+        gimpactShape->setLocalScaling(scaling);
+        gimpactShape->setMargin(margin);
+        gimpactShape->updateBound();
+        shape = gimpactShape;
+    } else {
+        shape = new btBvhTriangleMeshShape(mesh, true);
+        shape->setLocalScaling(scaling);
+        shape->setMargin(margin);
+    }
+    return shape;
+}
+
+static btCollisionShape* readShape(jmeReplayReader& reader) {
+    int type = reader.readInt();
+    btCollisionShape* shape = NULL;
+    switch (type) {
+        case JME_SHAPE_EMPTY:
+            shape = new btEmptyShape();
+            shape->setMargin(reader.readScalar());
+            break;
+        case JME_SHAPE_BOX:
+            shape = new btBoxShape(reader.readVector());
+            shape->setMargin(reader.readScalar());
+            break;
+        case JME_SHAPE_SPHERE:
+            shape = new btSphereShape(reader.readScalar());
+            break;
+        case JME_SHAPE_CAPSULE:
+        {
+            int upAxis = reader.readInt();
+            btScalar radius = reader.readScalar();
+            btScalar height = 2 * reader.readScalar();
+            if (upAxis == 0) {
+                shape = new btCapsuleShapeX(radius, height);
+            } else if (upAxis == 2) {
+                shape = new btCapsuleShapeZ(radius, height);
+            } else {
+                shape = new btCapsuleShape(radius, height);
+            }
+            break;
+        }
+        case JME_SHAPE_CYLINDER:
+        {
+            int upAxis = reader.readInt();
+            btVector3 halfExtents = reader.readVector();
+            if (upAxis == 0) {
+                shape = new btCylinderShapeX(halfExtents);
+            } else if (upAxis == 2) {
+                shape = new btCylinderShapeZ(halfExtents);
+            } else {
+                shape = new btCylinderShape(halfExtents);
+            }
+            shape->setMargin(reader.readScalar());
+            break;
+        }
+        case JME_SHAPE_CONE:
+        {
+            int upAxis = reader.readInt();
+            btScalar radius = reader.readScalar();
+            btScalar height = reader.readScalar();
+            if (upAxis == 0) {
+                shape = new btConeShapeX(radius, height);
+            } else if (upAxis == 2) {
+                shape = new btConeShapeZ(radius, height);
+            } else {
+                shape = new btConeShape(radius, height);
+            }
+            shape->setMargin(reader.readScalar());
+            break;
+        }
+        case JME_SHAPE_HULL:
+        {
+            int numPoints = reader.readInt();
+            btConvexHullShape* hull = new btConvexHullShape();
+            for (int i = 0; i < numPoints; i++) {
+                hull->addPoint(reader.readVector(), false);
+            }
+            hull->recalcLocalAabb();
+            hull->setLocalScaling(reader.readVector());
+            hull->setMargin(reader.readScalar());
+            shape = hull;
+            break;
+        }
+        case JME_SHAPE_MESH:
+            shape = readTriangles(reader, false);
+            break;
+        case JME_SHAPE_GIMPACT:
+            shape = readTriangles(reader, true);
+            break;
+        case JME_SHAPE_PLANE:
+        {
+            btVector3 normal = reader.readVector();
+            btScalar constant = reader.readScalar();
+            shape = new btStaticPlaneShape(normal, constant);
+            shape->setLocalScaling(reader.readVector());
+            break;
+        }
+        case JME_SHAPE_COMPOUND:
+        {
+            int numChildren = reader.readInt();
+            btCompoundShape* compound = new btCompoundShape();
+            for (int i = 0; i < numChildren; i++) {
+                btTransform transform = reader.readTransform();
+                btCollisionShape* child = findShape(reader.readId());
+                if (child != NULL) {
+                    compound->addChildShape(transform, child);
+                }
+            }
+            compound->setMargin(reader.readScalar());
+            shape = compound;
+            break;
+        }
+        case JME_SHAPE_HEIGHTFIELD:
+        {
+            int width = reader.readInt();
+            int length = reader.readInt();
+            int upAxis = reader.readInt();
+            bool flip = reader.readInt() != 0;
+            btScalar heightScale = reader.readScalar();
+            btScalar minHeight = reader.readScalar();
+            btScalar maxHeight = reader.readScalar();
+            btScalar* heights = new btScalar[width * length];
+            reader.read(heights, width * length * sizeof (btScalar));
+            shape = new jmeHeightfieldTerrainShape(width, length, heights, heightScale, minHeight, maxHeight, upAxis, PHY_FLOAT, flip);
+            shape->setLocalScaling(reader.readVector());
+            break;
+        }
+        default:
+            fprintf(stderr, "Unknown shape type %d\n", type);
+            return NULL;
+    }
+    return shape;
+}
+
+static void addObject(jmeReplayWorld* world, jmeReplayObject* object, const jmeRecordObject& properties) {
+    btRigidBody* body = btRigidBody::upcast(object->object);
+    if (body != NULL) {
+        world->addRigidBody(body, (short) properties.filterGroup, (short) properties.filterMask);
+        // the world gravity is given on add
+        body->setGravity(btVector3(properties.gravity[0], properties.gravity[1], properties.gravity[2]));
+    } else {
+        world->addCollisionObject(object->object, (short) properties.filterGroup, (short) properties.filterMask);
+    }
+}
+
+static void removeObject(jmeReplayWorld* world, jmeReplayObject* object) {
+    btRigidBody* body = btRigidBody::upcast(object->object);
+    if (body != NULL) {
+        world->removeRigidBody(body);
+    } else {
+        world->removeCollisionObject(object->object);
+    }
+}
+
+static void replaceShape(jmeReplayWorld* world, btCollisionShape* previous, btCollisionShape* shape) {
+    for (int i = 0; i < objects.size(); i++) {
+        btCollisionObject* collisionObject = (*objects.getAtIndex(i))->object;
+        if (collisionObject->getCollisionShape() != previous) {
+            continue;
+        }
+        collisionObject->setCollisionShape(shape);
+        btBroadphaseProxy* proxy = collisionObject->getBroadphaseHandle();
+        if (proxy != NULL) {
+            // the pair algorithms were made for the previous shape
+            world->getBroadphase()->getOverlappingPairCache()->cleanProxyFromPairs(proxy, world->getDispatcher());
+            world->updateSingleAabb(collisionObject);
+        }
+    }
+}
+
+static void setProperties(jmeReplayObject* object, const jmeRecordObject& properties) {
+    btCollisionObject* collisionObject = object->object;
+    btCollisionShape* shape = findShape(properties.shape);
+    collisionObject->setCollisionShape(shape != NULL ? shape : new btEmptyShape());
+    object->group = properties.group;
+    object->groups = properties.groups;
+    btRigidBody* body = btRigidBody::upcast(collisionObject);
+    if (body != NULL) {
+        body->setMassProps(properties.mass, btVector3(properties.inertia[0], properties.inertia[1], properties.inertia[2]));
+        body->setDamping(properties.linearDamping, properties.angularDamping);
+        body->setSleepingThresholds(properties.linearSleepingThreshold, properties.angularSleepingThreshold);
+        body->setLinearFactor(btVector3(properties.linearFactor[0], properties.linearFactor[1], properties.linearFactor[2]));
+        body->setAngularFactor(btVector3(properties.angularFactor[0], properties.angularFactor[1], properties.angularFactor[2]));
+        body->setFlags(properties.rigidBodyFlags);
+        body->updateInertiaTensor();
+    }
+    // after the mass, which changes the static flag
+    collisionObject->setCollisionFlags(properties.collisionFlags);
+    collisionObject->setFriction(properties.friction);
+    collisionObject->setRollingFriction(properties.rollingFriction);
+    collisionObject->setRestitution(properties.restitution);
+    collisionObject->setContactProcessingThreshold(properties.contactProcessingThreshold);
+    collisionObject->setCcdMotionThreshold(properties.ccdMotionThreshold);
+    collisionObject->setCcdSweptSphereRadius(properties.ccdSweptSphereRadius);
+}
+
+static btTypedConstraint* createJoint(const jmeRecordJoint& properties) {
+    btRigidBody* bodyA = findBody(properties.bodyA);
+    btRigidBody* bodyB = findBody(properties.bodyB);
+    if (bodyA == NULL || bodyB == NULL) {
+        return NULL;
+    }
+    btTransform frameA;
+    btTransform frameB;
+    jmeUnpackTransform(properties.frameA, frameA);
+    jmeUnpackTransform(properties.frameB, frameB);
+    const btScalar* limits = properties.limits;
+    bool frameAReference = (properties.flags & JME_JOINT_LINEAR_REFERENCE_FRAME_A) != 0;
+    switch (properties.type) {
+        case POINT2POINT_CONSTRAINT_TYPE:
+        {
+            btPoint2PointConstraint* point = new btPoint2PointConstraint(*bodyA, *bodyB, frameA.getOrigin(), frameB.getOrigin());
+            point->m_setting.m_tau = limits[0];
+            point->m_setting.m_damping = limits[1];
+            point->m_setting.m_impulseClamp = limits[2];
+            return point;
+        }
+        case HINGE_CONSTRAINT_TYPE:
+        {
+            btHingeConstraint* hinge = new btHingeConstraint(*bodyA, *bodyB, frameA, frameB);
+            hinge->setLimit(limits[0], limits[1], limits[2], limits[3], limits[4]);
+            hinge->enableAngularMotor((properties.flags & JME_JOINT_MOTOR) != 0, limits[5], limits[6]);
+            hinge->setAngularOnly((properties.flags & JME_JOINT_ANGULAR_ONLY) != 0);
+            return hinge;
+        }
+        case CONETWIST_CONSTRAINT_TYPE:
+        {
+            btConeTwistConstraint* cone = new btConeTwistConstraint(*bodyA, *bodyB, frameA, frameB);
+            cone->setLimit(limits[0], limits[1], limits[2]);
+            return cone;
+        }
+        case SLIDER_CONSTRAINT_TYPE:
+        {
+            btSliderConstraint* slider = new btSliderConstraint(*bodyA, *bodyB, frameA, frameB, frameAReference);
+            slider->setLowerLinLimit(limits[0]);
+            slider->setUpperLinLimit(limits[1]);
+            slider->setLowerAngLimit(limits[2]);
+            slider->setUpperAngLimit(limits[3]);
+            return slider;
+        }
+        case D6_CONSTRAINT_TYPE:
+        case D6_SPRING_CONSTRAINT_TYPE:
+        {
+            btGeneric6DofConstraint* sixDof = new btGeneric6DofConstraint(*bodyA, *bodyB, frameA, frameB, frameAReference);
+            sixDof->setLinearLowerLimit(btVector3(limits[0], limits[1], limits[2]));
+            sixDof->setLinearUpperLimit(btVector3(limits[3], limits[4], limits[5]));
+            sixDof->setAngularLowerLimit(btVector3(limits[6], limits[7], limits[8]));
+            sixDof->setAngularUpperLimit(btVector3(limits[9], limits[10], limits[11]));
+            return sixDof;
+        }
+        default:
+            fprintf(stderr, "Joint type %d not replayed\n", properties.type);
+            return NULL;
+    }
+}
+
+static void removeJoint(jmeReplayWorld* world, long long id) {
+    btTypedConstraint** joint = joints.find(key(id));
+    if (joint != NULL) {
+        world->removeConstraint(*joint);
+        delete(*joint);
+        joints.remove(key(id));
+    }
+}
+
+struct jmeStepTime {
+    int step;
+    int ticks;
+    int numObjects;
+    unsigned long time;
+};
+
+struct jmeStepTimeSort {
+
+    bool operator()(const jmeStepTime& a, const jmeStepTime& b) const {
+        return a.time < b.time;
+    }
+};
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s recording [steps.csv]\n", argv[0]);
+        return 1;
+    }
+    FILE* file = fopen(argv[1], "rb");
+    if (file == NULL) {
+        fprintf(stderr, "Can not read %s\n", argv[1]);
+        return 1;
+    }
+    FILE* output = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (output == NULL) {
+        fprintf(stderr, "Can not write %s\n", argv[2]);
+        return 1;
+    }
+    jmeReplayReader reader(file);
+    if (reader.readInt() != JME_RECORD_MAGIC || reader.readInt() != JME_RECORD_VERSION) {
+        fprintf(stderr, "%s is not a physics recording\n", argv[1]);
+        return 1;
+    }
+    if (reader.readInt() != sizeof (btScalar)) {
+        fprintf(stderr, "The recording and the replay have a different btScalar precision\n");
+        return 1;
+    }
+
+    // the same setup as jmePhysicsSpace, without the parallel threading
+    btDefaultCollisionConstructionInfo cci;
+    cci.m_customCollisionAlgorithmMaxElementSize = jmeSphereCapsuleConcaveAlgorithm::getMaxElementSize();
+    btDefaultCollisionConfiguration* configuration = new btDefaultCollisionConfiguration(cci);
+    btCollisionDispatcher* dispatcher = new btCollisionDispatcher(configuration);
+    jmeSphereCapsuleConcaveAlgorithm::registerAlgorithms(dispatcher);
+    btDbvtBroadphase* broadphase = new btDbvtBroadphase();
+    btSequentialImpulseConstraintSolver* solver = new btSequentialImpulseConstraintSolver();
+    jmeReplayWorld* world = new jmeReplayWorld(dispatcher, broadphase, solver, configuration);
+    broadphase->getOverlappingPairCache()->setInternalGhostPairCallback(new btGhostPairCallback());
+    world->getPairCache()->setOverlapFilterCallback(new jmeReplayFilter());
+
+    btAlignedObjectArray<jmeStepTime> steps;
+    btClock clock;
+    bool running = true;
+    fprintf(output, "step,ticks,objects,microseconds\n");
+    while (running) {
+        int record = reader.readInt();
+        if (reader.hasFailed()) {
+            // a recording not stopped properly ends without its end record
+            break;
+        }
+        switch (record) {
+            case JME_RECORD_END:
+                running = false;
+                break;
+            case JME_RECORD_WORLD:
+            {
+                jmeRecordWorld settings;
+                reader.read(&settings, sizeof (jmeRecordWorld));
+                world->setGravity(btVector3(settings.gravity[0], settings.gravity[1], settings.gravity[2]));
+                btContactSolverInfo& info = world->getSolverInfo();
+                info.m_numIterations = settings.numIterations;
+                info.m_solverMode = settings.solverMode;
+                info.m_splitImpulse = settings.splitImpulse;
+                info.m_erp = settings.erp;
+                info.m_erp2 = settings.erp2;
+                info.m_globalCfm = settings.globalCfm;
+                info.m_splitImpulsePenetrationThreshold = settings.splitImpulsePenetrationThreshold;
+                info.m_linearSlop = settings.linearSlop;
+                info.m_warmstartingFactor = settings.warmstartingFactor;
+                break;
+            }
+            case JME_RECORD_SHAPE:
+            {
+                long long id = reader.readId();
+                btCollisionShape* shape = readShape(reader);
+                if (shape == NULL) {
+                    running = false;
+                } else {
+                    // a shape recorded again replaces the previous one, also
+                    // on the objects using it (edited heightfield)
+                    btCollisionShape** previous = shapes.find(key(id));
+                    if (previous != NULL) {
+                        replaceShape(world, *previous, shape);
+                    }
+                    shapes.insert(key(id), shape);
+                }
+                break;
+            }
+            case JME_RECORD_ADD:
+            {
+                long long id = reader.readId();
+                jmeRecordObject properties;
+                reader.read(&properties, sizeof (jmeRecordObject));
+                jmeReplayObject* object = new jmeReplayObject();
+                object->type = properties.type;
+                if (properties.type == JME_OBJECT_RIGID_BODY) {
+                    btRigidBody::btRigidBodyConstructionInfo info(properties.mass, NULL, NULL);
+                    object->object = new btRigidBody(info);
+                } else if (properties.type == JME_OBJECT_GHOST) {
+                    object->object = new btPairCachingGhostObject();
+                } else {
+                    object->object = new btCollisionObject();
+                }
+                object->object->setUserPointer(object);
+                setProperties(object, properties);
+                addObject(world, object, properties);
+                objects.insert(key(id), object);
+                break;
+            }
+            case JME_RECORD_PROPERTIES:
+            {
+                jmeReplayObject* object = findObject(reader.readId());
+                jmeRecordObject properties;
+                reader.read(&properties, sizeof (jmeRecordObject));
+                if (object != NULL) {
+                    removeObject(world, object);
+                    setProperties(object, properties);
+                    addObject(world, object, properties);
+                }
+                break;
+            }
+            case JME_RECORD_REMOVE:
+            {
+                long long id = reader.readId();
+                jmeReplayObject* object = findObject(id);
+                if (object != NULL) {
+                    removeObject(world, object);
+                    delete(object->object);
+                    delete(object);
+                    objects.remove(key(id));
+                }
+                break;
+            }
+            case JME_RECORD_STATE:
+            {
+                jmeReplayObject* object = findObject(reader.readId());
+                int flags = reader.readInt();
+                btCollisionObject* collisionObject = object != NULL ? object->object : NULL;
+                btRigidBody* body = collisionObject != NULL ? btRigidBody::upcast(collisionObject) : NULL;
+                if (flags & JME_STATE_TRANSFORM) {
+                    btTransform transform = reader.readTransform();
+                    if (collisionObject != NULL) {
+                        collisionObject->setWorldTransform(transform);
+                        collisionObject->setInterpolationWorldTransform(transform);
+                    }
+                }
+                if (flags & JME_STATE_VELOCITY) {
+                    btVector3 linear = reader.readVector();
+                    btVector3 angular = reader.readVector();
+                    if (body != NULL) {
+                        body->setLinearVelocity(linear);
+                        body->setAngularVelocity(angular);
+                    }
+                }
+                if (flags & JME_STATE_FORCE) {
+                    btVector3 force = reader.readVector();
+                    btVector3 torque = reader.readVector();
+                    if (body != NULL) {
+                        // the recorded totals already have the linear and
+                        // angular factors, exact for the usual 0 or 1 factors
+                        body->clearForces();
+                        body->applyCentralForce(force);
+                        body->applyTorque(torque);
+                    }
+                }
+                if (flags & JME_STATE_ACTIVATION) {
+                    int state = reader.readInt();
+                    btScalar time = reader.readScalar();
+                    if (collisionObject != NULL) {
+                        collisionObject->forceActivationState(state);
+                        collisionObject->setDeactivationTime(time);
+                    }
+                }
+                break;
+            }
+            case JME_RECORD_JOINT:
+            {
+                long long id = reader.readId();
+                jmeRecordJoint properties;
+                reader.read(&properties, sizeof (jmeRecordJoint));
+                removeJoint(world, id);
+                btTypedConstraint* joint = createJoint(properties);
+                if (joint != NULL) {
+                    joint->setBreakingImpulseThreshold(properties.breakingImpulseThreshold);
+                    joint->setEnabled((properties.flags & JME_JOINT_ENABLED) != 0);
+                    world->addConstraint(joint, (properties.flags & JME_JOINT_DISABLE_COLLISIONS) != 0);
+                    joints.insert(key(id), joint);
+                }
+                break;
+            }
+            case JME_RECORD_REMOVE_JOINT:
+                removeJoint(world, reader.readId());
+                break;
+            case JME_RECORD_STEP:
+            {
+                reader.readScalar();
+                reader.readInt();
+                reader.readScalar();
+                jmeStepTime& step = steps.expandNonInitializing();
+                step.step = steps.size() - 1;
+                step.ticks = 0;
+                step.numObjects = world->getNumCollisionObjects();
+                step.time = 0;
+                break;
+            }
+            case JME_RECORD_TICK:
+            {
+                btScalar timeStep = reader.readScalar();
+                unsigned long start = clock.getTimeMicroseconds();
+                world->tick(timeStep);
+                unsigned long time = clock.getTimeMicroseconds() - start;
+                if (steps.size() > 0) {
+                    steps[steps.size() - 1].ticks++;
+                    steps[steps.size() - 1].time += time;
+                }
+                break;
+            }
+            default:
+                fprintf(stderr, "Unknown record %d\n", record);
+                running = false;
+                break;
+        }
+    }
+    fclose(file);
+
+    unsigned long total = 0;
+    int ticks = 0;
+    for (int i = 0; i < steps.size(); i++) {
+        fprintf(output, "%d,%d,%d,%lu\n", steps[i].step, steps[i].ticks, steps[i].numObjects, steps[i].time);
+        total += steps[i].time;
+        ticks += steps[i].ticks;
+    }
+    if (output != stdout) {
+        fclose(output);
+    }
+    if (steps.size() == 0) {
+        fprintf(stderr, "No step recorded\n");
+        return 0;
+    }
+    steps.quickSort(jmeStepTimeSort());
+    const jmeStepTime& worst = steps[steps.size() - 1];
+    fprintf(stderr, "%d steps, %d ticks, %.3f ms\n", steps.size(), ticks, total / 1000.0);
+    fprintf(stderr, "step mean %.1f us, median %lu us, 99th percentile %lu us\n", (double) total / steps.size(),
+            steps[steps.size() / 2].time, steps[(steps.size() * 99) / 100].time);
+    fprintf(stderr, "slowest step %d : %lu us, %d ticks, %d objects\n", worst.step, worst.time, worst.ticks, worst.numObjects);
+    return 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet;
+
+import com.jme3.math.Quaternion;
+import com.jme3.math.Vector3f;
+
+/**
+ * A force field volume evaluated natively on each physics tick, over the
+ * active rigid bodies overlapping it, so no java code nor JNI call runs per
+ * body and per tick.<br>
+ * The volume is a box (half extents), a sphere (radius in extents.x) or a
+ * capsule along its local y axis (radius in extents.x, half height of the
+ * cylinder in extents.y). The profiles, in the local space of the field :
+ * <ul>
+ * <li>PROFILE_LINEAR : strength along the direction, for wind zones</li>
+ * <li>PROFILE_RADIAL : strength toward the center (negative to repel), for
+ * attractors and gravity wells</li>
+ * <li>PROFILE_VORTEX : strength around the y axis</li>
+ * <li>PROFILE_NOISE : strength along the direction plus a turbulence</li>
+ * </ul>
+ * The force is applied as an impulse before each tick, sleeping bodies are
+ * not woken up.
+ *
+ * @author dokthar
+ */
+public class PhysicsForceField {
+
+    public static final int SHAPE_BOX = 0;
+    public static final int SHAPE_SPHERE = 1;
+    public static final int SHAPE_CAPSULE = 2;
+    public static final int PROFILE_LINEAR = 0;
+    public static final int PROFILE_RADIAL = 1;
+    public static final int PROFILE_VORTEX = 2;
+    public static final int PROFILE_NOISE = 3;
+    public static final int FALLOFF_NONE = 0;
+    /**
+     * from full strength at the center to zero on the border.
+     */
+    public static final int FALLOFF_LINEAR = 1;
+    public static final int FALLOFF_SMOOTH = 2;
+    /**
+     * the strength is given at one unit from the center.
+     */
+    public static final int FALLOFF_INVERSE_SQUARE = 3;
+    private int shape;
+    private final Vector3f extents = new Vector3f(1, 1, 1);
+    private final Vector3f location = new Vector3f();
+    private final Quaternion rotation = new Quaternion();
+    private int profile;
+    private int falloff = FALLOFF_NONE;
+    private final Vector3f direction = new Vector3f(Vector3f.UNIT_Y);
+    private float strength = 1;
+    private float noiseFrequency = 1;
+    private boolean massIndependent = false;
+    private int collisionGroups = 0xFFFFFFFF;
+    PhysicsSpace space;
+    int fieldId;
+
+    /**
+     * @param shape one of the SHAPE_ constants
+     * @param extents the half extents, radius and half height of the shape,
+     * the ones used by the shape must be positive (the half height of a
+     * capsule may be 0)
+     * @param profile one of the PROFILE_ constants
+     */
+    public PhysicsForceField(int shape, Vector3f extents, int profile) {
+        checkExtents(shape, extents);
+        this.shape = shape;
+        this.extents.set(extents);
+        this.profile = profile;
+    }
+
+    /**
+     * @param shape one of the SHAPE_ constants
+     * @param extents the half extents, radius and half height of the shape,
+     * see {@link #PhysicsForceField(int, com.jme3.math.Vector3f, int)}
+     */
+    public void setShape(int shape, Vector3f extents) {
+        checkExtents(shape, extents);
+        this.shape = shape;
+        this.extents.set(extents);
+        update();
+    }
+
+    private static void checkExtents(int shape, Vector3f extents) {
+        //the distance to the field is divided by the extents
+        boolean valid;
+        switch (shape) {
+            case SHAPE_SPHERE:
+                valid = extents.x > 0;
+                break;
+            case SHAPE_CAPSULE:
+                valid = extents.x > 0 && extents.y >= 0;
+                break;
+            default:
+                valid = extents.x > 0 && extents.y > 0 && extents.z > 0;
+        }
+        if (!valid) {
+            throw new IllegalArgumentException("The extents of the field must be positive : " + extents);
+        }
+    }
+
+    public int getShape() {
+        return shape;
+    }
+
+    public Vector3f getExtents() {
+        return extents;
+    }
+
+    public void setLocation(Vector3f location) {
+        this.location.set(location);
+        update();
+    }
+
+    public Vector3f getLocation() {
+        return location;
+    }
+
+    public void setRotation(Quaternion rotation) {
+        this.rotation.set(rotation);
+        update();
+    }
+
+    public Quaternion getRotation() {
+        return rotation;
+    }
+
+    public void setProfile(int profile) {
+        this.profile = profile;
+        update();
+    }
+
+    public int getProfile() {
+        return profile;
+    }
+
+    public void setFalloff(int falloff) {
+        this.falloff = falloff;
+        update();
+    }
+
+    public int getFalloff() {
+        return falloff;
+    }
+
+    /**
+     * @param direction the direction of the linear and noise profiles, in the
+     * local space of the field
+     */
+    public void setDirection(Vector3f direction) {
+        this.direction.set(direction);
+        update();
+    }
+
+    public Vector3f getDirection() {
+        return direction;
+    }
+
+    /**
+     * @param strength a force, or an acceleration if the field is mass
+     * independent
+     */
+    public void setStrength(float strength) {
+        this.strength = strength;
+        update();
+    }
+
+    public float getStrength() {
+        return strength;
+    }
+
+    public void setNoiseFrequency(float noiseFrequency) {
+        this.noiseFrequency = noiseFrequency;
+        update();
+    }
+
+    public float getNoiseFrequency() {
+        return noiseFrequency;
+    }
+
+    /**
+     * @param massIndependent true to give the same acceleration to all the
+     * bodies, like the gravity
+     */
+    public void setMassIndependent(boolean massIndependent) {
+        this.massIndependent = massIndependent;
+        update();
+    }
+
+    public boolean isMassIndependent() {
+        return massIndependent;
+    }
+
+    /**
+     * @param collisionGroups the collision groups of the affected bodies
+     */
+    public void setCollisionGroups(int collisionGroups) {
+        this.collisionGroups = collisionGroups;
+        update();
+    }
+
+    public int getCollisionGroups() {
+        return collisionGroups;
+    }
+
+    public PhysicsSpace getPhysicsSpace() {
+        return space;
+    }
+
+    void update() {
+        if (space != null) {
+            space.updateForceField(this, shape, extents, location, rotation, profile, falloff, direction, strength, noiseFrequency, massIndependent, collisionGroups);
+        }
+    }
+}
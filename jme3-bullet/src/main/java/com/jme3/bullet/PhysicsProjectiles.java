@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet;
+
+import com.jme3.bullet.collision.PhysicsCollisionObject;
+import com.jme3.math.Vector3f;
+import com.jme3.util.BufferUtils;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+
+/**
+ * Native projectiles of a PhysicsSpace. Projectiles are not collision
+ * objects, they are only points (or small spheres) integrated at each physics
+ * tick with the space gravity and a quadratic drag, and swept against the
+ * world. A projectile hitting an object (without the no contact response
+ * flag) is removed and a hit is written in the hits buffers, the hits are
+ * kept until {@link #clearHits()} is called.
+ * <p>
+ * A hit is stored as {@link #HIT_SIZE} floats in {@link #getHits()} : the
+ * point (3 floats), the normal (3 floats), the velocity of the projectile (3
+ * floats), the fraction of the physics tick where the hit occured and the
+ * material of the hit triangle (-1 if the shape has no triangle materials). The
+ * user id given to the spawn methods is stored in {@link #getHitIds()}.</p>
+ *
+ * @author dokthar
+ */
+public class PhysicsProjectiles {
+
+    /**
+     * Number of floats per hit in the hits buffer.
+     */
+    public static final int HIT_SIZE = 11;
+    /**
+     * Number of floats per projectile in the buffer given to
+     * {@link #spawn(java.nio.FloatBuffer, java.nio.IntBuffer)}.
+     */
+    public static final int SPAWN_SIZE = 9;
+    private final PhysicsSpace space;
+    private FloatBuffer hits;
+    private IntBuffer hitIds;
+    private int maxHits;
+
+    PhysicsProjectiles(PhysicsSpace space, int maxHits) {
+        this.space = space;
+        setMaxHits(maxHits);
+    }
+
+    /**
+     * Set the maximum number of hits kept between two calls of
+     * {@link #clearHits()}, other hits are lost (the projectiles are still
+     * removed).
+     *
+     * @param maxHits the max number of hits.
+     */
+    public final void setMaxHits(int maxHits) {
+        if (maxHits < 0) {
+            throw new IllegalArgumentException();
+        }
+        this.maxHits = maxHits;
+        hits = BufferUtils.createFloatBuffer(maxHits * HIT_SIZE);
+        hitIds = BufferUtils.createIntBuffer(maxHits);
+        setHitBuffers(space.getSpaceId(), hits, hitIds, maxHits);
+    }
+
+    private native void setHitBuffers(long spaceId, FloatBuffer hits, IntBuffer hitIds, int maxHits);
+
+    public int getMaxHits() {
+        return maxHits;
+    }
+
+    /**
+     * Spawn a new projectile.
+     *
+     * @param position the start position.
+     * @param velocity the start velocity.
+     * @param drag the quadratic drag coefficient (0 for none).
+     * @param radius the radius of the projectile, 0 to use a ray.
+     * @param lifetime the time before the projectile is removed if it doesn't
+     * hit anything, in seconds.
+     * @param userId the id reported in the hits.
+     */
+    public void spawn(Vector3f position, Vector3f velocity, float drag, float radius, float lifetime, int userId) {
+        spawn(space.getSpaceId(), position, velocity, drag, radius, lifetime, userId);
+    }
+
+    private native void spawn(long spaceId, Vector3f position, Vector3f velocity, float drag, float radius, float lifetime, int userId);
+
+    /**
+     * Spawn many projectiles in a single native call.
+     *
+     * @param projectiles {@link #SPAWN_SIZE} floats per projectile : position
+     * (3 floats), velocity (3 floats), drag, radius and lifetime.
+     * @param userIds the id of each projectile, reported in the hits.
+     */
+    public void spawn(FloatBuffer projectiles, IntBuffer userIds) {
+        if (projectiles.capacity() < userIds.capacity() * SPAWN_SIZE) {
+            throw new IllegalArgumentException();
+        }
+        spawnAll(space.getSpaceId(), projectiles, userIds);
+    }
+
+    private native void spawnAll(long spaceId, FloatBuffer projectiles, IntBuffer userIds);
+
+    /**
+     * Remove all the projectiles.
+     */
+    public void clear() {
+        clear(space.getSpaceId());
+    }
+
+    private native void clear(long spaceId);
+
+    /**
+     * @return the number of projectiles alive.
+     */
+    public int getCount() {
+        return getCount(space.getSpaceId());
+    }
+
+    private native int getCount(long spaceId);
+
+    /**
+     * @return the number of hits since the last call of clearHits().
+     */
+    public int getHitCount() {
+        return getHitCount(space.getSpaceId());
+    }
+
+    private native int getHitCount(long spaceId);
+
+    /**
+     * @return the hits buffer, {@link #HIT_SIZE} floats per hit.
+     */
+    public FloatBuffer getHits() {
+        return hits;
+    }
+
+    /**
+     * @return the user ids of the hits.
+     */
+    public IntBuffer getHitIds() {
+        return hitIds;
+    }
+
+    /**
+     * Get the object hit by a projectile. Only valid until the next call of
+     * clearHits().
+     *
+     * @param hit the index of the hit.
+     * @return the object hit, or null if it was removed from the space since
+     * the hit.
+     */
+    public PhysicsCollisionObject getHitObject(int hit) {
+        if (hit < 0 || hit >= getHitCount()) {
+            throw new IndexOutOfBoundsException();
+        }
+        return getHitObject(space.getSpaceId(), hit);
+    }
+
+    private native PhysicsCollisionObject getHitObject(long spaceId, int hit);
+
+    /**
+     * Forget the hits, should be called once the hits have been read.
+     */
+    public void clearHits() {
+        clearHits(space.getSpaceId());
+    }
+
+    private native void clearHits(long spaceId);
+}
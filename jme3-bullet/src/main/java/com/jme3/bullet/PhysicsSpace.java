@@ -35,6 +35,7 @@ import com.jme3.app.AppTask;
 import com.jme3.asset.AssetManager;
 import com.jme3.bullet.collision.*;
 import com.jme3.bullet.collision.shapes.CollisionShape;
+import com.jme3.bullet.collision.shapes.HeightfieldCollisionShape;
 import com.jme3.bullet.control.PhysicsControl;
 import com.jme3.bullet.control.RigidBodyControl;
 import com.jme3.bullet.joints.PhysicsJoint;
@@ -42,10 +43,16 @@ import com.jme3.bullet.objects.PhysicsCharacter;
 import com.jme3.bullet.objects.PhysicsGhostObject;
 import com.jme3.bullet.objects.PhysicsRigidBody;
 import com.jme3.bullet.objects.PhysicsVehicle;
+import com.jme3.math.Quaternion;
 import com.jme3.math.Transform;
 import com.jme3.math.Vector3f;
 import com.jme3.scene.Node;
 import com.jme3.scene.Spatial;
+import com.jme3.util.BufferUtils;
+import java.io.File;
+import java.io.IOException;
+import java.nio.FloatBuffer;
+import java.nio.LongBuffer;
 import java.util.ArrayDeque;
 import java.util.ArrayList;
 import java.util.Collection;
@@ -71,6 +78,35 @@ public class PhysicsSpace {
     public static final int AXIS_X = 0;
     public static final int AXIS_Y = 1;
     public static final int AXIS_Z = 2;
+    /**
+     * Number of floats per candidate in the results of a batched
+     * trajectoryTest.
+     */
+    public static final int TRAJECTORY_RESULT_SIZE = 8;
+    /**
+     * Native debug draw modes, see {@link #setDebugDrawMode(int)}.
+     */
+    public static final int DEBUG_DRAW_NONE = 0;
+    public static final int DEBUG_DRAW_WIREFRAME = 1;
+    public static final int DEBUG_DRAW_AABB = 2;
+    public static final int DEBUG_DRAW_CONTACT_POINTS = 8;
+    public static final int DEBUG_DRAW_CONSTRAINTS = 1 << 11;
+    public static final int DEBUG_DRAW_CONSTRAINT_LIMITS = 1 << 12;
+    /**
+     * The least important simulation tier, stepped every 16 ticks.
+     */
+    public static final int MAX_SIMULATION_TIER = 4;
+    /**
+     * Floats per object in the cost buffer of
+     * {@link #getObjectCosts(LongBuffer, FloatBuffer, int, boolean)}, at these
+     * offsets, averaged per physics tick.
+     */
+    public static final int COST_SIZE = 5;
+    public static final int COST_NARROWPHASE_TIME = 0;
+    public static final int COST_MANIFOLDS = 1;
+    public static final int COST_CONTACTS = 2;
+    public static final int COST_SOLVER_ROWS = 3;
+    public static final int COST_CCD_SWEEPS = 4;
     private long physicsSpaceId = 0;
     protected static ThreadLocal<ConcurrentLinkedQueue<AppTask<?>>> pQueueTL =
             new ThreadLocal<ConcurrentLinkedQueue<AppTask<?>>>() {
@@ -103,6 +139,26 @@ public class PhysicsSpace {
     private float accuracy = 1f / 60f;
     private int maxSubSteps = 4, rayTestFlags = 1 << 2;
     private int solverNumIterations = 10;
+    private boolean sphereCapsuleConcaveAlgorithm = true;
+    private PhysicsProjectiles projectiles;
+    private FloatBuffer trajectoryLaunch;
+    private FloatBuffer trajectoryResult;
+    private final PhysicsCollisionObject[] trajectoryObject = new PhysicsCollisionObject[1];
+    private int debugDrawMode = DEBUG_DRAW_NONE;
+    //the lines are drawn in the back buffers and swapped with the front
+    //buffers under the debug lock, the front buffers are read by the renderer
+    private FloatBuffer debugPositions;
+    private FloatBuffer debugColors;
+    private FloatBuffer frontDebugPositions;
+    private FloatBuffer frontDebugColors;
+    private int debugVertexCount = 0;
+    private final Object debugLock = new Object();
+    private boolean simulationLodEnabled = false;
+    private boolean costProfilingEnabled = false;
+    private boolean recording = false;
+    private boolean javaTickCallbacks = true;
+    private final List<PhysicsForceField> forceFields = new ArrayList<PhysicsForceField>();
+    private long[] bulkObjectIds = new long[0];
 
     static {
 //        System.loadLibrary("bulletjme");
@@ -368,12 +424,372 @@ public class PhysicsSpace {
 //        if (getDynamicsWorld() == null) {
 //            return;
 //        }
+        //the java tick methods are only called when they have something to do
+        boolean javaTick = !tickListeners.isEmpty() || !pQueue.isEmpty();
+        if (javaTick != javaTickCallbacks) {
+            javaTickCallbacks = javaTick;
+            setJavaTickCallbacks(physicsSpaceId, javaTick);
+        }
         //step simulation
         stepSimulation(physicsSpaceId, time, maxSteps, accuracy);
+        if (debugDrawMode != DEBUG_DRAW_NONE) {
+            updateDebugLines();
+        }
     }
 
     private native void stepSimulation(long space, float time, int maxSteps, float accuracy);
 
+    private native void setJavaTickCallbacks(long space, boolean enabled);
+
+    /**
+     * Registers a native tick function, called on each internal tick of the
+     * simulation without any JNI call. Its C signature is
+     * <code>void (*)(btDynamicsWorld* world, btScalar timeStep, void* userData)</code>,
+     * see jmeTickPlugins.h. The plugin library usually gives the address of
+     * its function through one of its own JNI methods.<br>
+     * Call it from the physics thread when using parallel threading.
+     *
+     * @param function the address of the native function
+     * @param userData a pointer given back to the function
+     * @param preTick true to call it before each tick, false after
+     * @return the id of the callback, see {@link #removeNativeTickCallback(int)}
+     */
+    public int addNativeTickCallback(long function, long userData, boolean preTick) {
+        return addNativeTickCallback(physicsSpaceId, function, userData, preTick);
+    }
+
+    private native int addNativeTickCallback(long space, long function, long userData, boolean preTick);
+
+    /**
+     * @param id the id returned when the callback was added
+     * @return true if the callback was registered
+     */
+    public boolean removeNativeTickCallback(int id) {
+        return removeNativeTickCallback(physicsSpaceId, id);
+    }
+
+    private native boolean removeNativeTickCallback(long space, int id);
+
+    /**
+     * Sets the native debug draw mode, when enabled the lines drawn by bullet
+     * are collected after each update into the buffers returned by
+     * {@link #getDebugPositions()} and {@link #getDebugColors()}.
+     *
+     * @param debugDrawMode a combination of the DEBUG_DRAW_ flags, or
+     * DEBUG_DRAW_NONE to disable it
+     */
+    public void setDebugDrawMode(int debugDrawMode) {
+        this.debugDrawMode = debugDrawMode;
+        setDebugDrawMode(physicsSpaceId, debugDrawMode);
+        if (debugDrawMode == DEBUG_DRAW_NONE) {
+            synchronized (debugLock) {
+                debugVertexCount = 0;
+            }
+        }
+    }
+
+    public int getDebugDrawMode() {
+        return debugDrawMode;
+    }
+
+    /**
+     * The lock to hold while reading the debug lines : with parallel
+     * threading they are drawn on the physics thread, the buffers returned by
+     * {@link #getDebugPositions()} and {@link #getDebugColors()} are only
+     * stable while holding it.
+     *
+     * @return the lock of the debug lines
+     */
+    public Object getDebugLock() {
+        return debugLock;
+    }
+
+    /**
+     * Read it while holding {@link #getDebugLock()}.
+     *
+     * @return the positions of the debug lines (3 floats per vertex, 2
+     * vertices per line), the buffer changes after each update
+     */
+    public FloatBuffer getDebugPositions() {
+        return frontDebugPositions;
+    }
+
+    /**
+     * Read it while holding {@link #getDebugLock()}.
+     *
+     * @return the colors of the debug lines (4 floats per vertex)
+     */
+    public FloatBuffer getDebugColors() {
+        return frontDebugColors;
+    }
+
+    public int getDebugVertexCount() {
+        synchronized (debugLock) {
+            return debugVertexCount;
+        }
+    }
+
+    private void updateDebugLines() {
+        int count = debugDraw(physicsSpaceId);
+        String warnings = getDebugWarnings(physicsSpaceId);
+        if (warnings != null) {
+            for (String warning : warnings.split("\n")) {
+                logger.log(Level.WARNING, "Bullet : {0}", warning);
+            }
+        }
+        if (debugPositions == null || debugPositions.capacity() < count * 3) {
+            int capacity = Math.max(count, debugPositions == null ? 1024 : debugPositions.capacity() / 3 * 2);
+            debugPositions = BufferUtils.createFloatBuffer(capacity * 3);
+            debugColors = BufferUtils.createFloatBuffer(capacity * 4);
+        }
+        getDebugLines(physicsSpaceId, debugPositions, debugColors, count);
+        debugPositions.clear().limit(count * 3);
+        debugColors.clear().limit(count * 4);
+        synchronized (debugLock) {
+            FloatBuffer positions = frontDebugPositions;
+            FloatBuffer colors = frontDebugColors;
+            frontDebugPositions = debugPositions;
+            frontDebugColors = debugColors;
+            debugPositions = positions;
+            debugColors = colors;
+            debugVertexCount = count;
+        }
+    }
+
+    /**
+     * Enables the per object cost accounting : the narrowphase time (in
+     * microseconds) of the pairs involving each collision object, its contact
+     * manifolds and points, its solver rows and its ccd sweeps.<br>
+     * The narrowphase time is only measured without parallel threading.
+     * @param enabled true to account the costs, false to stop and clear them
+     */
+    public void setCostProfilingEnabled(boolean enabled) {
+        costProfilingEnabled = enabled;
+        setCostProfilingEnabled(physicsSpaceId, enabled);
+    }
+
+    public boolean isCostProfilingEnabled() {
+        return costProfilingEnabled;
+    }
+
+    /**
+     * Stores the most expensive objects since the last reset, sorted by the
+     * given cost then by solver rows. The objects removed from the space are
+     * dropped from the accounting.
+     * @param ids a direct buffer receiving the object ids
+     * @param costs a direct buffer receiving COST_SIZE floats per object
+     * @param sortIndex the cost to sort by, one of the COST_ offsets, prefer
+     * COST_SOLVER_ROWS with parallel threading as the time is not measured
+     * @param reset true to restart the accounting
+     * @return the number of objects stored, at most the capacity of the buffers
+     */
+    public int getObjectCosts(LongBuffer ids, FloatBuffer costs, int sortIndex, boolean reset) {
+        if (sortIndex < 0 || sortIndex >= COST_SIZE) {
+            throw new IllegalArgumentException("The sort index must be one of the COST_ offsets.");
+        }
+        return getObjectCosts(physicsSpaceId, ids, costs, sortIndex, reset);
+    }
+
+    /**
+     * Records the physics into the given file : the current world, then all
+     * the changes made before each physics tick (objects and joints added,
+     * removed or modified, forces, velocities and moves) and the timesteps.
+     * The recording can be stepped again without the application by the
+     * bulletreplay tool of the native build, which reports the time of each
+     * physics step.<br>
+     * The soft bodies, the actions (characters and vehicles) and the contact
+     * callbacks are not recorded.
+     * @param file the recording file, replaced if it exists
+     * @throws IOException if the file can not be written
+     */
+    public void startRecording(File file) throws IOException {
+        if (!startRecording(physicsSpaceId, file.getAbsolutePath())) {
+            throw new IOException("Can not write the physics recording " + file);
+        }
+        recording = true;
+    }
+
+    /**
+     * Ends the recording and closes its file.
+     */
+    public void stopRecording() {
+        stopRecording(physicsSpaceId);
+        recording = false;
+    }
+
+    public boolean isRecording() {
+        return recording;
+    }
+
+    private native boolean startRecording(long physicsSpaceId, String path);
+
+    private native void stopRecording(long physicsSpaceId);
+
+    private native void setCostProfilingEnabled(long physicsSpaceId, boolean enabled);
+
+    private native int getObjectCosts(long physicsSpaceId, LongBuffer ids, FloatBuffer costs, int sortIndex, boolean reset);
+
+    private native void setDebugDrawMode(long physicsSpaceId, int mode);
+
+    private native int debugDraw(long physicsSpaceId);
+
+    private native void getDebugLines(long physicsSpaceId, FloatBuffer positions, FloatBuffer colors, int count);
+
+    private native String getDebugWarnings(long physicsSpaceId);
+
+    /**
+     * Enables the simulation level of detail : the rigid bodies of tier t
+     * are stepped every 2^t physics ticks with a timestep 2^t times larger.
+     * The tier of a simulation island is the lowest tier of its bodies, so
+     * the bodies in contact with or jointed to a more important body are
+     * stepped at its rate.<br>
+     * On their stepped ticks the velocities seen by the tick listeners are
+     * scaled by the number of ticks to catch up.
+     * @param enabled true to enable the simulation LOD
+     */
+    public void setSimulationLodEnabled(boolean enabled) {
+        simulationLodEnabled = enabled;
+        setSimulationLodEnabled(physicsSpaceId, enabled);
+    }
+
+    public boolean isSimulationLodEnabled() {
+        return simulationLodEnabled;
+    }
+
+    private native void setSimulationLodEnabled(long physicsSpaceId, boolean enabled);
+
+    /**
+     * Sets the simulation tiers of many bodies in a single native call, see
+     * {@link PhysicsRigidBody#setSimulationTier(int)}.
+     * @param bodies the bodies
+     * @param tiers the tier of each body, from 0 to MAX_SIMULATION_TIER
+     */
+    public void setSimulationTiers(PhysicsRigidBody[] bodies, int[] tiers) {
+        if (tiers.length < bodies.length) {
+            throw new IllegalArgumentException("A tier is needed for each body.");
+        }
+        if (bulkObjectIds.length < bodies.length) {
+            bulkObjectIds = new long[bodies.length];
+        }
+        for (int i = 0; i < bodies.length; i++) {
+            if (tiers[i] < 0 || tiers[i] > MAX_SIMULATION_TIER) {
+                throw new IllegalArgumentException("The simulation tier must be between 0 and " + MAX_SIMULATION_TIER);
+            }
+            bulkObjectIds[i] = bodies[i].getObjectId();
+        }
+        setSimulationTiers(physicsSpaceId, bulkObjectIds, tiers, bodies.length);
+    }
+
+    private native void setSimulationTiers(long physicsSpaceId, long[] objectIds, int[] tiers, int count);
+
+    /**
+     * Freezes all the objects overlapping the given box, without removing
+     * them from the space. The frozen objects are not simulated and their
+     * collision pairs are removed, so they do not collide anymore until they
+     * are unfrozen. They are still hit by the ray, sweep and projectile tests
+     * and seen by the ghost objects. An object removed from the space is
+     * unfrozen. Static, kinematic, soft and ghost objects (the character ghosts
+     * too) are not frozen.<br>
+     * Call it from the physics thread when using parallel threading.
+     * @param min the minimum corner of the region
+     * @param max the maximum corner of the region
+     * @return the id of the frozen region, see {@link #unfreezeRegion(int)}
+     */
+    public int freezeRegion(Vector3f min, Vector3f max) {
+        return freezeRegion(physicsSpaceId, min, max);
+    }
+
+    private native int freezeRegion(long physicsSpaceId, Vector3f min, Vector3f max);
+
+    /**
+     * Freezes the given objects as a single region, see
+     * {@link #freezeRegion(Vector3f, Vector3f)}. An object already frozen
+     * stays in its region.
+     * @param objects the objects to freeze
+     * @return the id of the frozen region
+     */
+    public int freezeObjects(PhysicsCollisionObject[] objects) {
+        if (bulkObjectIds.length < objects.length) {
+            bulkObjectIds = new long[objects.length];
+        }
+        for (int i = 0; i < objects.length; i++) {
+            bulkObjectIds[i] = objects[i].getObjectId();
+        }
+        return freezeObjects(physicsSpaceId, bulkObjectIds, objects.length);
+    }
+
+    private native int freezeObjects(long physicsSpaceId, long[] objectIds, int count);
+
+    /**
+     * Restores the objects of a frozen region with the activation state and
+     * velocities they had when frozen.
+     * @param region the id returned when freezing the region
+     * @return the number of objects restored
+     */
+    public int unfreezeRegion(int region) {
+        return unfreezeRegion(physicsSpaceId, region);
+    }
+
+    private native int unfreezeRegion(long physicsSpaceId, int region);
+
+    /**
+     * Wakes the bodies over the given vertexes of a terrain after their
+     * heights were changed with
+     * {@link HeightfieldCollisionShape#setHeights(float[], int, int, int, int)},
+     * and frees their contacts with the terrain made on the previous heights.
+     * The terrain stays in the broadphase, only its bounding box is updated.
+     * Call it from the physics thread when using parallel threading.
+     * @param terrain the object using the edited heightfield shape
+     * @param minX the first column of the edited vertexes
+     * @param minZ the first row of the edited vertexes
+     * @param maxX the last column of the edited vertexes (inclusive)
+     * @param maxZ the last row of the edited vertexes (inclusive)
+     * @return the number of bodies woken
+     */
+    public int heightfieldChanged(PhysicsCollisionObject terrain, int minX, int minZ, int maxX, int maxZ) {
+        return heightfieldChanged(physicsSpaceId, terrain.getObjectId(), minX, minZ, maxX, maxZ);
+    }
+
+    private native int heightfieldChanged(long physicsSpaceId, long objectId, int minX, int minZ, int maxX, int maxZ);
+
+    /**
+     * Adds a force field to this space, a field can only be in one space.
+     * Call it from the physics thread when using parallel threading.
+     * @param field the force field
+     */
+    public void addForceField(PhysicsForceField field) {
+        if (field.space != null) {
+            throw new IllegalStateException("The force field is already in a physics space.");
+        }
+        field.fieldId = addForceField(physicsSpaceId);
+        field.space = this;
+        forceFields.add(field);
+        field.update();
+    }
+
+    public void removeForceField(PhysicsForceField field) {
+        if (field.space != this) {
+            return;
+        }
+        removeForceField(physicsSpaceId, field.fieldId);
+        field.space = null;
+        forceFields.remove(field);
+    }
+
+    public Collection<PhysicsForceField> getForceFieldList() {
+        return new LinkedList<PhysicsForceField>(forceFields);
+    }
+
+    void updateForceField(PhysicsForceField field, int shape, Vector3f extents, Vector3f location, Quaternion rotation, int profile, int falloff, Vector3f direction, float strength, float noiseFrequency, boolean massIndependent, int groups) {
+        setForceField(physicsSpaceId, field.fieldId, shape, extents, location, rotation, profile, falloff, direction, strength, noiseFrequency, massIndependent, groups);
+    }
+
+    private native int addForceField(long physicsSpaceId);
+
+    private native boolean removeForceField(long physicsSpaceId, int fieldId);
+
+    private native void setForceField(long physicsSpaceId, int fieldId, int shape, Vector3f extents, Vector3f location, Quaternion rotation, int profile, int falloff, Vector3f direction, float strength, float noiseFrequency, boolean massIndependent, int groups);
+
     public void distributeEvents() {
         //add collision callbacks
         int clistsize = collisionListeners.size();
@@ -865,6 +1281,67 @@ public class PhysicsSpace {
         return results;
     }
 
+    /**
+     * Performs a trajectory test : the first hit of a ballistic arc (or a
+     * sphere moving along it) starting at position with the given velocity.
+     * The arc is swept by segments short enough to follow the curve, and the
+     * test early-out if nothing is in the bounding box of the whole arc.<br/>
+     * The arc is cut in at most 1024 segments : on very long arcs (or strong
+     * gravity) the chords may stray further than half the radius (or 0.01 for
+     * rays) from the curve.
+     *
+     * @param position the launch position.
+     * @param velocity the launch velocity.
+     * @param gravity the gravity applied to the projectile.
+     * @param radius the radius of the projectile, 0 to use rays.
+     * @param maxTime the duration of the arc, in seconds, nothing is hit if it
+     * is not positive.
+     * @param result the first hit, only modified if there is a hit.
+     * @return true if the arc hit something.
+     */
+    public boolean trajectoryTest(Vector3f position, Vector3f velocity, Vector3f gravity, float radius, float maxTime, PhysicsTrajectoryResult result) {
+        if (trajectoryLaunch == null) {
+            trajectoryLaunch = BufferUtils.createFloatBuffer(6);
+            trajectoryResult = BufferUtils.createFloatBuffer(TRAJECTORY_RESULT_SIZE);
+        }
+        trajectoryLaunch.put(0, position.x).put(1, position.y).put(2, position.z);
+        trajectoryLaunch.put(3, velocity.x).put(4, velocity.y).put(5, velocity.z);
+        if (trajectoryTest(trajectoryLaunch, gravity, radius, maxTime, trajectoryResult, trajectoryObject) == 0) {
+            return false;
+        }
+        FloatBuffer r = trajectoryResult;
+        result.set(trajectoryObject[0], r.get(0), r.get(1), r.get(2), r.get(3), r.get(4), r.get(5), r.get(6), (int) r.get(7));
+        trajectoryObject[0] = null;
+        return true;
+    }
+
+    /**
+     * Performs many trajectory tests in a single native call, for example to
+     * search a valid launch velocity. See
+     * {@link #trajectoryTest(com.jme3.math.Vector3f, com.jme3.math.Vector3f, com.jme3.math.Vector3f, float, float, com.jme3.bullet.collision.PhysicsTrajectoryResult)}.
+     *
+     * @param launches 6 floats per candidate : the launch position and
+     * velocity.
+     * @param gravity the gravity applied to the projectiles.
+     * @param radius the radius of the projectiles, 0 to use rays.
+     * @param maxTime the duration of the arcs, in seconds.
+     * @param results {@link #TRAJECTORY_RESULT_SIZE} floats per candidate :
+     * the hit time (-1 if there is no hit), point, normal and the triangle
+     * material (-1 if none).
+     * @param objects the object hit by each candidate (null if there is no
+     * hit), can be null.
+     * @return the number of candidates which hit something.
+     */
+    public int trajectoryTest(FloatBuffer launches, Vector3f gravity, float radius, float maxTime, FloatBuffer results, PhysicsCollisionObject[] objects) {
+        int count = launches.capacity() / 6;
+        if (results.capacity() < count * TRAJECTORY_RESULT_SIZE || (objects != null && objects.length < count)) {
+            throw new IllegalArgumentException();
+        }
+        return trajectoryTest_native(physicsSpaceId, launches, count, gravity, radius, maxTime, results, objects);
+    }
+
+    private native int trajectoryTest_native(long physicsSpaceId, FloatBuffer launches, int count, Vector3f gravity, float radius, float maxTime, FloatBuffer results, PhysicsCollisionObject[] objects);
+
 /*    private class InternalSweepListener extends CollisionWorld.ConvexResultCallback {
 
         private List<PhysicsSweepTestResult> results;
@@ -883,6 +1360,19 @@ public class PhysicsSpace {
 
     */
     
+    /**
+     * Get the native projectiles of this space, created at the first call
+     * with room for 1024 hits.
+     *
+     * @return the projectiles of this space.
+     */
+    public PhysicsProjectiles getProjectiles() {
+        if (projectiles == null) {
+            projectiles = new PhysicsProjectiles(this, 1024);
+        }
+        return projectiles;
+    }
+
     /**
      * destroys the current PhysicsSpace so that a new one can be created
      */
@@ -1001,6 +1491,31 @@ public class PhysicsSpace {
     }
     
     private native void setSolverNumIterations(long physicsSpaceId, int numIterations);
+
+    /**
+     * Enable or disable the specialized sphere and capsule versus triangle
+     * mesh and heightfield contact algorithm. When disabled, bullet's generic
+     * convex versus concave algorithm is used, for example to compare them.
+     * Only the pairs created after the call are affected.
+     *
+     * The default is true.
+     *
+     * @param enabled true to use the specialized algorithm.
+     */
+    public void setSphereCapsuleConcaveAlgorithm(boolean enabled) {
+        this.sphereCapsuleConcaveAlgorithm = enabled;
+        setSphereCapsuleConcaveAlgorithm(physicsSpaceId, enabled);
+    }
+
+    /**
+     * @return true if the specialized sphere and capsule versus triangle mesh
+     * and heightfield contact algorithm is used.
+     */
+    public boolean isSphereCapsuleConcaveAlgorithm() {
+        return sphereCapsuleConcaveAlgorithm;
+    }
+
+    private native void setSphereCapsuleConcaveAlgorithm(long physicsSpaceId, boolean enabled);
     
     public static native void initNativePhysics();
 
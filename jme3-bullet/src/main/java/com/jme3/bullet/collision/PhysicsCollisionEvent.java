@@ -224,6 +224,22 @@ public class PhysicsCollisionEvent extends EventObject {
 
     private native int getPartId1(long manifoldPointObjectId);
 
+    /**
+     * @return the material of the triangle of object A, -1 if its shape has
+     * no triangle materials
+     */
+    public int getTriangleMaterial0() {
+        return nodeA.getCollisionShape().getTriangleMaterial(getPartId0(), getIndex0());
+    }
+
+    /**
+     * @return the material of the triangle of object B, -1 if its shape has
+     * no triangle materials
+     */
+    public int getTriangleMaterial1() {
+        return nodeB.getCollisionShape().getTriangleMaterial(getPartId1(), getIndex1());
+    }
+
     public Vector3f getPositionWorldOnA() {
         return getPositionWorldOnA(new Vector3f());
     }
@@ -65,6 +65,7 @@ public abstract class PhysicsCollisionObject implements Savable {
     protected int collisionGroup = 0x00000001;
     protected int collisionGroupsMask = 0x00000001;
     private Object userObject;
+    protected PhysicsContactMaterial contactMaterial;
 
     /**
      * Sets a CollisionShape to this physics object, note that the object should
@@ -153,9 +154,38 @@ public abstract class PhysicsCollisionObject implements Savable {
     protected void initUserPointer() {
         Logger.getLogger(this.getClass().getName()).log(Level.FINE, "initUserPointer() objectId = {0}", Long.toHexString(objectId));
         initUserPointer(objectId, collisionGroup, collisionGroupsMask);
+        if (contactMaterial != null) {
+            setContactMaterial(objectId, contactMaterial.getMaterialId());
+        }
     }
     native void initUserPointer(long objectId, int group, int groups);
 
+    /**
+     * Sets the contact material of this object, its contact rules are applied
+     * natively to all the contacts of this object.
+     * @param contactMaterial the material, or null for none
+     */
+    public void setContactMaterial(PhysicsContactMaterial contactMaterial) {
+        this.contactMaterial = contactMaterial;
+        if (objectId != 0) {
+            setContactMaterial(objectId, contactMaterial != null ? contactMaterial.getMaterialId() : 0);
+        }
+    }
+
+    public PhysicsContactMaterial getContactMaterial() {
+        return contactMaterial;
+    }
+
+    /**
+     * @return true if this object belongs to a frozen region of its space,
+     * see {@link com.jme3.bullet.PhysicsSpace#freezeRegion(com.jme3.math.Vector3f, com.jme3.math.Vector3f)}
+     */
+    public boolean isFrozen() {
+        return isFrozen(objectId);
+    }
+
+    private native boolean isFrozen(long objectId);
+
     /**
      * @return the userObject
      */
@@ -177,6 +207,7 @@ public abstract class PhysicsCollisionObject implements Savable {
     protected native void attachCollisionShape(long objectId, long collisionShapeId);
     native void setCollisionGroup(long objectId, int collisionGroup);
     native void setCollideWithGroups(long objectId, int collisionGroups);
+    native void setContactMaterial(long objectId, int materialId);
 
     @Override
     public void write(JmeExporter e) throws IOException {
@@ -184,6 +215,7 @@ public abstract class PhysicsCollisionObject implements Savable {
         capsule.write(collisionGroup, "collisionGroup", 0x00000001);
         capsule.write(collisionGroupsMask, "collisionGroupsMask", 0x00000001);
         capsule.write(collisionShape, "collisionShape", null);
+        capsule.write(contactMaterial, "contactMaterial", null);
     }
 
     @Override
@@ -193,6 +225,7 @@ public abstract class PhysicsCollisionObject implements Savable {
         collisionGroupsMask = capsule.readInt("collisionGroupsMask", 0x00000001);
         CollisionShape shape = (CollisionShape) capsule.readSavable("collisionShape", null);
         collisionShape = shape;
+        contactMaterial = (PhysicsContactMaterial) capsule.readSavable("contactMaterial", null);
     }
 
     @Override
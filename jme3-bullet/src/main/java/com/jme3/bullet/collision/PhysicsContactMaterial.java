@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet.collision;
+
+import com.jme3.export.InputCapsule;
+import com.jme3.export.JmeExporter;
+import com.jme3.export.JmeImporter;
+import com.jme3.export.OutputCapsule;
+import com.jme3.export.Savable;
+import com.jme3.math.FastMath;
+import com.jme3.math.Vector3f;
+import java.io.IOException;
+
+/**
+ * Contact rules shared by the collision objects using this material : friction
+ * and restitution combine modes, surface velocity (conveyors), one way
+ * contacts (platforms) and disabled contacts. The rules are stored natively
+ * and applied by bullet when the contacts are added, no java code runs per
+ * contact.<br>
+ * The vectors are in the local space of the collision object using the
+ * material. Setting a surface velocity enables the friction direction caching
+ * of the solver.
+ *
+ * @author dokthar
+ */
+public class PhysicsContactMaterial implements Savable {
+
+    /**
+     * bullet default, the product of the two values.
+     */
+    public static final int COMBINE_DEFAULT = 0;
+    public static final int COMBINE_AVERAGE = 1;
+    public static final int COMBINE_MIN = 2;
+    public static final int COMBINE_MAX = 3;
+    public static final int COMBINE_MULTIPLY = 4;
+    private final int materialId;
+    private int frictionCombine = COMBINE_DEFAULT;
+    private int restitutionCombine = COMBINE_DEFAULT;
+    private final Vector3f surfaceVelocity = new Vector3f();
+    private boolean oneWay = false;
+    private final Vector3f oneWayDirection = new Vector3f(Vector3f.UNIT_Y);
+    private float oneWayMaxAngle = FastMath.HALF_PI;
+    private boolean contactsDisabled = false;
+
+    public PhysicsContactMaterial() {
+        materialId = createMaterial();
+    }
+
+    public int getMaterialId() {
+        return materialId;
+    }
+
+    /**
+     * When two materials have different combine modes, the highest mode is
+     * used.
+     *
+     * @param frictionCombine one of the COMBINE_ modes
+     */
+    public void setFrictionCombine(int frictionCombine) {
+        this.frictionCombine = frictionCombine;
+        setCombine(materialId, frictionCombine, restitutionCombine);
+    }
+
+    public int getFrictionCombine() {
+        return frictionCombine;
+    }
+
+    /**
+     * @param restitutionCombine one of the COMBINE_ modes
+     */
+    public void setRestitutionCombine(int restitutionCombine) {
+        this.restitutionCombine = restitutionCombine;
+        setCombine(materialId, frictionCombine, restitutionCombine);
+    }
+
+    public int getRestitutionCombine() {
+        return restitutionCombine;
+    }
+
+    /**
+     * Set the velocity of the surface, in local space, the friction drives
+     * the touching objects along it like a conveyor belt.
+     *
+     * @param surfaceVelocity
+     */
+    public void setSurfaceVelocity(Vector3f surfaceVelocity) {
+        this.surfaceVelocity.set(surfaceVelocity);
+        setSurfaceVelocity(materialId, surfaceVelocity);
+    }
+
+    public Vector3f getSurfaceVelocity(Vector3f store) {
+        if (store == null) {
+            store = new Vector3f();
+        }
+        return store.set(surfaceVelocity);
+    }
+
+    /**
+     * Only keep the contacts pushing the other objects along the given local
+     * direction, like a platform that can be crossed from below.
+     *
+     * @param direction the local direction, (0, 1, 0) by default
+     * @param maxAngle the max angle between the direction and the contact
+     * normal, in radians
+     */
+    public void setOneWay(Vector3f direction, float maxAngle) {
+        this.oneWay = true;
+        this.oneWayDirection.set(direction);
+        this.oneWayMaxAngle = maxAngle;
+        setOneWay(materialId, true, direction, maxAngle);
+    }
+
+    public void clearOneWay() {
+        this.oneWay = false;
+        setOneWay(materialId, false, oneWayDirection, oneWayMaxAngle);
+    }
+
+    public boolean isOneWay() {
+        return oneWay;
+    }
+
+    public Vector3f getOneWayDirection(Vector3f store) {
+        if (store == null) {
+            store = new Vector3f();
+        }
+        return store.set(oneWayDirection);
+    }
+
+    public float getOneWayMaxAngle() {
+        return oneWayMaxAngle;
+    }
+
+    /**
+     * Disable all the contacts of the objects using this material, they are
+     * still detected but not solved nor reported to the collision listeners.
+     *
+     * @param contactsDisabled
+     */
+    public void setContactsDisabled(boolean contactsDisabled) {
+        this.contactsDisabled = contactsDisabled;
+        setContactsDisabled(materialId, contactsDisabled);
+    }
+
+    public boolean isContactsDisabled() {
+        return contactsDisabled;
+    }
+
+    /**
+     * Override the combined friction and restitution of the contacts between
+     * this material and the other one.
+     *
+     * @param other
+     * @param friction the friction, or a negative value to use the combine
+     * mode
+     * @param restitution the restitution, or a negative value to use the
+     * combine mode
+     */
+    public void setPairRule(PhysicsContactMaterial other, float friction, float restitution) {
+        setPairRule(materialId, other.materialId, false, friction, restitution);
+    }
+
+    /**
+     * Disable the contacts between this material and the other one.
+     *
+     * @param other
+     */
+    public void setPairDisabled(PhysicsContactMaterial other) {
+        setPairRule(materialId, other.materialId, true, -1, -1);
+    }
+
+    public void removePairRule(PhysicsContactMaterial other) {
+        removePairRule(materialId, other.materialId);
+    }
+
+    private native int createMaterial();
+
+    private native void setCombine(int materialId, int frictionCombine, int restitutionCombine);
+
+    private native void setSurfaceVelocity(int materialId, Vector3f velocity);
+
+    private native void setOneWay(int materialId, boolean oneWay, Vector3f direction, float maxAngle);
+
+    private native void setContactsDisabled(int materialId, boolean disabled);
+
+    private native void setPairRule(int materialId, int otherId, boolean disabled, float friction, float restitution);
+
+    private native void removePairRule(int materialId, int otherId);
+
+    @Override
+    public void write(JmeExporter e) throws IOException {
+        OutputCapsule capsule = e.getCapsule(this);
+        capsule.write(frictionCombine, "frictionCombine", COMBINE_DEFAULT);
+        capsule.write(restitutionCombine, "restitutionCombine", COMBINE_DEFAULT);
+        capsule.write(surfaceVelocity, "surfaceVelocity", Vector3f.ZERO);
+        capsule.write(oneWay, "oneWay", false);
+        capsule.write(oneWayDirection, "oneWayDirection", Vector3f.UNIT_Y);
+        capsule.write(oneWayMaxAngle, "oneWayMaxAngle", FastMath.HALF_PI);
+        capsule.write(contactsDisabled, "contactsDisabled", false);
+    }
+
+    @Override
+    public void read(JmeImporter e) throws IOException {
+        InputCapsule capsule = e.getCapsule(this);
+        frictionCombine = capsule.readInt("frictionCombine", COMBINE_DEFAULT);
+        restitutionCombine = capsule.readInt("restitutionCombine", COMBINE_DEFAULT);
+        setCombine(materialId, frictionCombine, restitutionCombine);
+        setSurfaceVelocity((Vector3f) capsule.readSavable("surfaceVelocity", Vector3f.ZERO.clone()));
+        oneWayDirection.set((Vector3f) capsule.readSavable("oneWayDirection", Vector3f.UNIT_Y.clone()));
+        oneWayMaxAngle = capsule.readFloat("oneWayMaxAngle", FastMath.HALF_PI);
+        if (capsule.readBoolean("oneWay", false)) {
+            setOneWay(oneWayDirection, oneWayMaxAngle);
+        }
+        setContactsDisabled(capsule.readBoolean("contactsDisabled", false));
+    }
+}
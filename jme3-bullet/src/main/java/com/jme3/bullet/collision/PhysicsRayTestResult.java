@@ -44,6 +44,9 @@ public class PhysicsRayTestResult {
     private PhysicsCollisionObject collisionObject;
     private Vector3f hitNormalLocal;
     private float hitFraction;
+    private int partIndex = -1;
+    private int triangleIndex = -1;
+    private int material = -1;
     private boolean normalInWorldSpace = true;
 
     /**
@@ -79,4 +82,28 @@ public class PhysicsRayTestResult {
     public boolean isNormalInWorldSpace() {
         return normalInWorldSpace;
     }
+
+    /**
+     * @return the part of the hit triangle for meshes, or the cell x for
+     * heightfields, -1 for other shapes
+     */
+    public int getPartIndex() {
+        return partIndex;
+    }
+
+    /**
+     * @return the index of the hit triangle in its part for meshes, or the
+     * cell z for heightfields, -1 for other shapes
+     */
+    public int getTriangleIndex() {
+        return triangleIndex;
+    }
+
+    /**
+     * @return the material of the hit triangle, -1 if the shape has no
+     * triangle materials
+     */
+    public int getMaterial() {
+        return material;
+    }
 }
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet.collision;
+
+import com.jme3.math.Vector3f;
+
+/**
+ * Contains the first hit of a PhysicsSpace trajectoryTest.
+ *
+ * @author dokthar
+ */
+public class PhysicsTrajectoryResult {
+
+    private PhysicsCollisionObject collisionObject;
+    private final Vector3f hitPoint = new Vector3f();
+    private final Vector3f hitNormal = new Vector3f();
+    private float hitTime;
+    private int material = -1;
+
+    public PhysicsTrajectoryResult() {
+    }
+
+    /**
+     * <!> Used internally !
+     */
+    public void set(PhysicsCollisionObject collisionObject, float hitTime, float pointX, float pointY, float pointZ, float normalX, float normalY, float normalZ, int material) {
+        this.collisionObject = collisionObject;
+        this.material = material;
+        this.hitTime = hitTime;
+        hitPoint.set(pointX, pointY, pointZ);
+        hitNormal.set(normalX, normalY, normalZ);
+    }
+
+    /**
+     * @return the collisionObject
+     */
+    public PhysicsCollisionObject getCollisionObject() {
+        return collisionObject;
+    }
+
+    /**
+     * @return the hitPoint, in world space
+     */
+    public Vector3f getHitPoint() {
+        return hitPoint;
+    }
+
+    /**
+     * @return the hitNormal, in world space
+     */
+    public Vector3f getHitNormal() {
+        return hitNormal;
+    }
+
+    /**
+     * @return the time after the launch of the hit, in seconds
+     */
+    public float getHitTime() {
+        return hitTime;
+    }
+
+    /**
+     * @return the material of the hit triangle, -1 if the shape has no
+     * triangle materials
+     */
+    public int getMaterial() {
+        return material;
+    }
+}
@@ -103,6 +103,19 @@ public abstract class CollisionShape implements Savable {
         this.margin = margin;
     }
     
+    /**
+     * Returns the material of a triangle given by the part and triangle
+     * indexes of a hit or a contact.
+     * @return the material, -1 if this shape has no triangle materials
+     */
+    public int getTriangleMaterial(int partIndex, int triangleIndex) {
+        return getTriangleMaterial(objectId, partIndex, triangleIndex);
+    }
+
+    protected native void setTriangleMaterials(long objectId, byte[] materials);
+
+    private native int getTriangleMaterial(long objectId, int partIndex, int triangleIndex);
+
     private native void setLocalScaling(long obectId, Vector3f scale);
     
     private native void setMargin(long objectId, float margin);
@@ -66,6 +66,7 @@ public class HeightfieldCollisionShape extends CollisionShape {
     protected int upAxis;
     protected boolean flipQuadEdges;
     protected ByteBuffer bbuf;
+    protected byte[] cellMaterials;
 //    protected FloatBuffer fbuf;
 
     public HeightfieldCollisionShape() {
@@ -134,10 +135,78 @@ public class HeightfieldCollisionShape extends CollisionShape {
         Logger.getLogger(this.getClass().getName()).log(Level.FINE, "Created Shape {0}", Long.toHexString(objectId));
         setScale(scale);
         setMargin(margin);
+        if (cellMaterials != null) {
+            setTriangleMaterials(objectId, cellMaterials);
+        }
+    }
+
+    /**
+     * Sets the material of each cell (both triangles of a cell share it),
+     * reported by the ray tests, the sweep tests, the projectiles and the
+     * collision events hitting this shape.
+     *
+     * @param cellMaterials (heightStickWidth - 1) * (heightStickLength - 1)
+     * materials, row after row, or null to remove them
+     */
+    public void setCellMaterials(byte[] cellMaterials) {
+        if (cellMaterials != null && cellMaterials.length != (heightStickWidth - 1) * (heightStickLength - 1)) {
+            throw new IllegalArgumentException("Expected " + (heightStickWidth - 1) * (heightStickLength - 1) + " cell materials");
+        }
+        this.cellMaterials = cellMaterials;
+        setTriangleMaterials(objectId, cellMaterials);
+    }
+
+    public byte[] getCellMaterials() {
+        return cellMaterials;
     }
 
     private native long createShape(int heightStickWidth, int heightStickLength, ByteBuffer heightfieldData, float heightScale, float minHeight, float maxHeight, int upAxis, boolean flipQuadEdges);
 
+    /**
+     * Updates the heights of a rectangle of vertexes in place, without
+     * recreating the shape (terrain deformation). The bounds of the shape grow
+     * if the new heights are out of them, they never shrink so the vertexes
+     * keep the same local origin. Then call
+     * {@link com.jme3.bullet.PhysicsSpace#heightfieldChanged(com.jme3.bullet.collision.PhysicsCollisionObject, int, int, int, int)}
+     * for the objects using this shape, to wake the bodies on the edited
+     * vertexes.<br>
+     * Call it from the physics thread when using parallel threading.
+     *
+     * @param heightmap the whole heightmap holding the new heights, of the
+     * same size than the one of this shape
+     * @param minX the first column of the edited vertexes
+     * @param minZ the first row of the edited vertexes
+     * @param maxX the last column of the edited vertexes (inclusive)
+     * @param maxZ the last row of the edited vertexes (inclusive)
+     */
+    public void setHeights(float[] heightmap, int minX, int minZ, int maxX, int maxZ) {
+        if (heightmap.length != heightfieldData.length) {
+            throw new IllegalArgumentException("Expected " + heightfieldData.length + " heights");
+        }
+        minX = Math.max(0, minX);
+        minZ = Math.max(0, minZ);
+        maxX = Math.min(heightStickWidth - 1, maxX);
+        maxZ = Math.min(heightStickLength - 1, maxZ);
+        for (int z = minZ; z <= maxZ; z++) {
+            for (int x = minX; x <= maxX; x++) {
+                int i = z * heightStickWidth + x;
+                heightfieldData[i] = heightmap[i];
+                // the native shape reads the heights from this buffer
+                bbuf.putFloat(i * 4, heightmap[i]);
+            }
+        }
+        if (heightsChanged(objectId, minX, minZ, maxX, maxZ)) {
+            minHeight = getMinHeight(objectId);
+            maxHeight = getMaxHeight(objectId);
+        }
+    }
+
+    private native boolean heightsChanged(long shapeId, int minX, int minZ, int maxX, int maxZ);
+
+    private native float getMinHeight(long shapeId);
+
+    private native float getMaxHeight(long shapeId);
+
     public Mesh createJmeMesh() {
         //TODO return Converter.convert(bulletMesh);
         return null;
@@ -154,6 +223,7 @@ public class HeightfieldCollisionShape extends CollisionShape {
         capsule.write(upAxis, "upAxis", 1);
         capsule.write(heightfieldData, "heightfieldData", new float[0]);
         capsule.write(flipQuadEdges, "flipQuadEdges", false);
+        capsule.write(cellMaterials, "cellMaterials", null);
     }
 
     public void read(JmeImporter im) throws IOException {
@@ -167,6 +237,7 @@ public class HeightfieldCollisionShape extends CollisionShape {
         upAxis = capsule.readInt("upAxis", 1);
         heightfieldData = capsule.readFloatArray("heightfieldData", new float[0]);
         flipQuadEdges = capsule.readBoolean("flipQuadEdges", false);
+        cellMaterials = capsule.readByteArray("cellMaterials", null);
         createShape();
     }
 }
@@ -62,11 +62,15 @@ public class MeshCollisionShape extends CollisionShape {
     private static final String NUM_TRIANGLES = "numTriangles";
     private static final String NUM_VERTICES = "numVertices";
     private static final String NATIVE_BVH = "nativeBvh";
+    private static final String TRIANGLE_MATERIALS = "triangleMaterials";
+    private static final String PARALLEL_BVH = "parallelBvh";
     protected int numVertices, numTriangles, vertexStride, triangleIndexStride;
     protected ByteBuffer triangleIndexBase, vertexBase;
     protected long meshId = 0;
     protected long nativeBVHBuffer = 0;
     private boolean memoryOptimized;
+    private boolean parallelBvh;
+    private byte[] triangleMaterials;
 
     public MeshCollisionShape() {
     }
@@ -98,7 +102,26 @@ public class MeshCollisionShape extends CollisionShape {
      * false to generate quantized BVH.
      */
     public MeshCollisionShape(final Mesh mesh, final boolean memoryOptimized) {
-        this.memoryOptimized = memoryOptimized;
+        this(mesh, memoryOptimized, false);
+    }
+
+    /**
+     * Creates a collision shape from the given Mesh.
+     * <code>parallelBvh</code> builds the BVH on several threads, with a
+     * binned SAH instead of the Bullet builder, for very large meshes. The
+     * parallel BVH is always quantized (memory optimized), the same for any
+     * thread count, and saved and loaded like the default one.
+     * A mesh of more than 2097152 triangles can't be used with the parallel
+     * builder, split it in several shapes.
+     *
+     * @param mesh the Mesh to use
+     * @param memoryOptimized True to generate a memory optimized BVH,
+     * false to generate quantized BVH.
+     * @param parallelBvh true to build the BVH on several threads
+     */
+    public MeshCollisionShape(final Mesh mesh, final boolean memoryOptimized, final boolean parallelBvh) {
+        this.memoryOptimized = memoryOptimized || parallelBvh;
+        this.parallelBvh = parallelBvh;
         this.createCollisionMesh(mesh);
     }
 
@@ -115,13 +138,28 @@ public class MeshCollisionShape extends CollisionShape {
      * @param memoryOptimized use quantisize BVH, uses less memory, but slower
      */
     public MeshCollisionShape(ByteBuffer indices, ByteBuffer vertices, boolean memoryOptimized) {
+        this(indices, vertices, memoryOptimized, false);
+    }
+
+    /**
+     * Advanced constructor, see
+     * {@link #MeshCollisionShape(java.nio.ByteBuffer, java.nio.ByteBuffer, boolean)}
+     * and {@link #MeshCollisionShape(com.jme3.scene.Mesh, boolean, boolean)}.
+     *
+     * @param indices the raw index buffer
+     * @param vertices the raw vertex buffer
+     * @param memoryOptimized use quantisize BVH, uses less memory, but slower
+     * @param parallelBvh true to build the BVH on several threads
+     */
+    public MeshCollisionShape(ByteBuffer indices, ByteBuffer vertices, boolean memoryOptimized, boolean parallelBvh) {
         this.triangleIndexBase = indices;
         this.vertexBase = vertices;
         this.numVertices = vertices.limit() / 4 / 3;
         this.numTriangles = this.triangleIndexBase.limit() / 4 / 3;
         this.vertexStride = 12;
         this.triangleIndexStride = 12;
-        this.memoryOptimized = memoryOptimized;
+        this.memoryOptimized = memoryOptimized || parallelBvh;
+        this.parallelBvh = parallelBvh;
         this.createShape(true);
     }
     
@@ -153,6 +191,29 @@ public class MeshCollisionShape extends CollisionShape {
         this.createShape(true);
     }
 
+    /**
+     * Sets the material of each triangle, reported by the ray tests, the sweep
+     * tests, the projectiles and the collision events hitting this shape.
+     *
+     * @param triangleMaterials one material per triangle, or null to remove
+     * them
+     */
+    public void setTriangleMaterials(byte[] triangleMaterials) {
+        if (triangleMaterials != null && triangleMaterials.length != numTriangles) {
+            throw new IllegalArgumentException("Expected " + numTriangles + " triangle materials");
+        }
+        this.triangleMaterials = triangleMaterials;
+        setTriangleMaterials(objectId, triangleMaterials);
+    }
+
+    public byte[] getTriangleMaterials() {
+        return triangleMaterials;
+    }
+
+    public boolean isParallelBvh() {
+        return parallelBvh;
+    }
+
     @Override
     public void write(final JmeExporter ex) throws IOException {
         super.write(ex);
@@ -176,6 +237,8 @@ public class MeshCollisionShape extends CollisionShape {
             byte[] data = saveBVH(objectId);
             capsule.write(data, MeshCollisionShape.NATIVE_BVH, null);
         }
+        capsule.write(triangleMaterials, MeshCollisionShape.TRIANGLE_MATERIALS, null);
+        capsule.write(parallelBvh, MeshCollisionShape.PARALLEL_BVH, false);
     }
 
     @Override
@@ -189,11 +252,13 @@ public class MeshCollisionShape extends CollisionShape {
 
         this.triangleIndexBase = BufferUtils.createByteBuffer(capsule.readByteArray(MeshCollisionShape.TRIANGLE_INDEX_BASE, null));
         this.vertexBase = BufferUtils.createByteBuffer(capsule.readByteArray(MeshCollisionShape.VERTEX_BASE, null));
+        this.triangleMaterials = capsule.readByteArray(MeshCollisionShape.TRIANGLE_MATERIALS, null);
+        this.parallelBvh = capsule.readBoolean(MeshCollisionShape.PARALLEL_BVH, false);
 
         byte[] nativeBvh = capsule.readByteArray(MeshCollisionShape.NATIVE_BVH, null);
         if (nativeBvh == null) {
             // Either using non memory optimized BVH or old J3O file
-            memoryOptimized = false;
+            memoryOptimized = parallelBvh;
             createShape(true);
         } else {
             // Using memory optimized BVH, load from J3O, then assign it.
@@ -206,10 +271,13 @@ public class MeshCollisionShape extends CollisionShape {
     private void createShape(boolean buildBvt) {
         this.meshId = NativeMeshUtil.createTriangleIndexVertexArray(this.triangleIndexBase, this.vertexBase, this.numTriangles, this.numVertices, this.vertexStride, this.triangleIndexStride);
         Logger.getLogger(this.getClass().getName()).log(Level.FINE, "Created Mesh {0}", Long.toHexString(this.meshId));
-        this.objectId = createShape(memoryOptimized, buildBvt, this.meshId);
+        this.objectId = createShape(memoryOptimized, buildBvt, parallelBvh, this.meshId);
         Logger.getLogger(this.getClass().getName()).log(Level.FINE, "Created Shape {0}", Long.toHexString(this.objectId));
         this.setScale(this.scale);
         this.setMargin(this.margin);
+        if (triangleMaterials != null) {
+            setTriangleMaterials(objectId, triangleMaterials);
+        }
     }
 
     /**
@@ -220,7 +288,7 @@ public class MeshCollisionShape extends CollisionShape {
     
     private native byte[] saveBVH(long objectId);
     
-    private native long createShape(boolean memoryOptimized, boolean buildBvt, long meshId);
+    private native long createShape(boolean memoryOptimized, boolean buildBvt, boolean parallelBvh, long meshId);
 
     @Override
     public void finalize() throws Throwable {
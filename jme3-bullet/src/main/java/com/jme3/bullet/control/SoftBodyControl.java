@@ -35,6 +35,7 @@ import com.jme3.bullet.PhysicsSoftSpace;
 import com.jme3.bullet.PhysicsSpace;
 import com.jme3.bullet.objects.PhysicsSoftBody;
 import com.jme3.bullet.util.NativeSoftBodyUtil;
+import com.jme3.bullet.util.SoftBodyTearing;
 import com.jme3.export.InputCapsule;
 import com.jme3.export.JmeExporter;
 import com.jme3.export.JmeImporter;
@@ -72,6 +73,7 @@ public class SoftBodyControl extends PhysicsSoftBody implements PhysicsControl {
 
     private boolean meshHaveNormal = false;
     private IntBuffer jmeToBulletMap = null;
+    private SoftBodyTearing tearing = null;
 
     private boolean meshInLocalOrigin;
     private boolean updateNormals;
@@ -147,6 +149,7 @@ public class SoftBodyControl extends PhysicsSoftBody implements PhysicsControl {
 
     private void rebuildFromMesh(Mesh mesh) {
         if (mesh != null) {
+            tearing = null;
 
             boolean wasInWorld = objectId != 0 && added;
             if (objectId != 0) {
@@ -165,6 +168,29 @@ public class SoftBodyControl extends PhysicsSoftBody implements PhysicsControl {
         }
     }
 
+    /**
+     * Enable the native tearing of the softbody, the mesh is patched at each
+     * update. The control must be added to a spatial with a triangle mesh, or
+     * a line mesh for a rope.
+     *
+     * @param strainThreshold the link strain over which a link is torn.
+     * @param maxNewVertexes the maximum number of vertexes added to the mesh.
+     * @return the tearing, to tune it.
+     * @see SoftBodyTearing
+     */
+    public SoftBodyTearing setTearing(float strainThreshold, int maxNewVertexes) {
+        if (mesh == null) {
+            throw new IllegalStateException("The control must be added to a spatial first");
+        }
+        tearing = new SoftBodyTearing(this, mesh, jmeToBulletMap, strainThreshold, maxNewVertexes);
+        jmeToBulletMap = tearing.getJmeToBulletMap();
+        return tearing;
+    }
+
+    public SoftBodyTearing getTearing() {
+        return tearing;
+    }
+
     @Override
     public Control cloneForSpatial(Spatial spatial) {
         SoftBodyControl control = new SoftBodyControl(meshInLocalOrigin, updateNormals);
@@ -173,8 +199,11 @@ public class SoftBodyControl extends PhysicsSoftBody implements PhysicsControl {
         control.setMasses(getMasses());
         control.setRestLengthScale(getRestLengthScale());
         int nbCluster = getClusterCount();
-        if (nbCluster > 0) {
-            control.generateClusters(getClusterCount());
+        if (nbCluster > 0 && getNbNodes() == control.getNbNodes()) {
+            // same nodes, reuse the clusters instead of running the K-mean again
+            control.setClusterAssignment(getClusterAssignment(null));
+        } else if (nbCluster > 0) {
+            control.generateClusters(nbCluster);
         }
 
         control.setPhysicsLocation(getPhysicsLocation());
@@ -303,6 +332,9 @@ public class SoftBodyControl extends PhysicsSoftBody implements PhysicsControl {
                     }
                 }
                 if (mesh != null) {
+                    if (tearing != null) {
+                        tearing.update(mesh, null);
+                    }
                     NativeSoftBodyUtil.updateMesh(this, jmeToBulletMap, mesh, meshInLocalOrigin, updateNormals && meshHaveNormal);
                     spatial.updateModelBound();
                 }
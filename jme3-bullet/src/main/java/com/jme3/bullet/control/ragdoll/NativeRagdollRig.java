@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet.control.ragdoll;
+
+import com.jme3.animation.Bone;
+import com.jme3.bullet.objects.PhysicsRigidBody;
+import com.jme3.math.Quaternion;
+import com.jme3.math.Transform;
+import com.jme3.math.Vector3f;
+import com.jme3.util.BufferUtils;
+import java.nio.FloatBuffer;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * Native ragdoll rig : stores the rigid body and bind rotation of each bone
+ * and computes the model space pose of all the bones in a single native
+ * call, instead of reading each body transform and doing the quaternion math
+ * in java.<br>
+ * The pose is written in a direct buffer, {@link #BONE_SIZE} floats per
+ * bone : the model space position then the rotation quaternion (x, y, z, w).
+ * It can be blended natively with an animated pose of the same layout.<br>
+ * The rig keeps a reference to its bodies and gives their current native
+ * objects on each update, so they may be rebuilt while set in the rig.
+ *
+ * @author dokthar
+ */
+public class NativeRagdollRig {
+
+    public static final int BONE_SIZE = 7;
+    private final long rigId;
+    private final int boneCount;
+    private final FloatBuffer pose;
+    private final PhysicsRigidBody[] bodies;
+    private final long[] bodyIds;
+
+    /**
+     * @param boneCount the number of bones, usually the bone count of the
+     * skeleton so the bone indices can be used
+     */
+    public NativeRagdollRig(int boneCount) {
+        this.boneCount = boneCount;
+        rigId = createRig(boneCount);
+        pose = BufferUtils.createFloatBuffer(boneCount * BONE_SIZE);
+        bodies = new PhysicsRigidBody[boneCount];
+        bodyIds = new long[boneCount];
+        Logger.getLogger(this.getClass().getName()).log(Level.FINE, "Created NativeRagdollRig {0}", Long.toHexString(rigId));
+    }
+
+    private native long createRig(int boneCount);
+
+    public int getBoneCount() {
+        return boneCount;
+    }
+
+    /**
+     * Sets the body of a bone, the bone rotation is the body rotation times
+     * the bind rotation (the model space rotation of the bone when the bodies
+     * were created, as KinematicRagdollControl does).
+     *
+     * @param index the bone index
+     * @param body the body, or null to keep the animated pose of this bone
+     * @param bindRotation the bind rotation
+     */
+    public void setBone(int index, PhysicsRigidBody body, Quaternion bindRotation) {
+        setBone(rigId, index, body != null ? body.getObjectId() : 0, bindRotation);
+        bodies[index] = body;
+    }
+
+    private native void setBone(long rigId, int index, long bodyId, Quaternion bindRotation);
+
+    /**
+     * Computes the physics pose of the bones.
+     *
+     * @param modelWorldTransform the world transform of the animated model
+     * @return the pose buffer
+     */
+    public FloatBuffer updatePose(Transform modelWorldTransform) {
+        return updatePose(modelWorldTransform, null, 1f);
+    }
+
+    /**
+     * Computes the physics pose of the bones blended with an animated pose,
+     * the bones without body keep the animated pose.
+     *
+     * @param modelWorldTransform the world transform of the animated model
+     * @param animatedPose the animated pose, see {@link #storeAnimatedPose(Bone[], FloatBuffer)}, or null
+     * @param blend 0 for the animated pose, 1 for the physics pose
+     * @return the pose buffer
+     */
+    public FloatBuffer updatePose(Transform modelWorldTransform, FloatBuffer animatedPose, float blend) {
+        //the native object of a body changes when it is rebuilt
+        for (int i = 0; i < boneCount; i++) {
+            bodyIds[i] = bodies[i] != null ? bodies[i].getObjectId() : 0;
+        }
+        getPose(rigId, bodyIds, modelWorldTransform.getTranslation(), modelWorldTransform.getRotation(), modelWorldTransform.getScale(), animatedPose, blend, pose);
+        return pose;
+    }
+
+    private native void getPose(long rigId, long[] bodyIds, Vector3f modelLocation, Quaternion modelRotation, Vector3f modelScale, FloatBuffer animatedPose, float blend, FloatBuffer pose);
+
+    /**
+     * @return the pose computed by the last update
+     */
+    public FloatBuffer getPose() {
+        return pose;
+    }
+
+    /**
+     * Stores the current model space pose of the bones in the rig layout.
+     *
+     * @param bones the bones by index, null entries are skipped
+     * @param store the buffer to store in, or null for a new one
+     * @return the animated pose
+     */
+    public FloatBuffer storeAnimatedPose(Bone[] bones, FloatBuffer store) {
+        if (store == null) {
+            store = BufferUtils.createFloatBuffer(boneCount * BONE_SIZE);
+        }
+        for (int i = 0; i < bones.length && i < boneCount; i++) {
+            if (bones[i] == null) {
+                continue;
+            }
+            Vector3f position = bones[i].getModelSpacePosition();
+            Quaternion rotation = bones[i].getModelSpaceRotation();
+            int index = i * BONE_SIZE;
+            store.put(index, position.x).put(index + 1, position.y).put(index + 2, position.z);
+            store.put(index + 3, rotation.getX()).put(index + 4, rotation.getY()).put(index + 5, rotation.getZ()).put(index + 6, rotation.getW());
+        }
+        return store;
+    }
+
+    /**
+     * Applies the last computed pose to the bones, which must be under user
+     * control.
+     *
+     * @param bones the bones by index, null entries are skipped
+     */
+    public void applyPose(Bone[] bones) {
+        Vector3f position = new Vector3f();
+        Quaternion rotation = new Quaternion();
+        for (int i = 0; i < bones.length && i < boneCount; i++) {
+            if (bones[i] == null) {
+                continue;
+            }
+            int index = i * BONE_SIZE;
+            position.set(pose.get(index), pose.get(index + 1), pose.get(index + 2));
+            rotation.set(pose.get(index + 3), pose.get(index + 4), pose.get(index + 5), pose.get(index + 6));
+            bones[i].setUserTransformsInModelSpace(position, rotation);
+        }
+    }
+
+    @Override
+    protected void finalize() throws Throwable {
+        super.finalize();
+        Logger.getLogger(this.getClass().getName()).log(Level.FINE, "Finalizing NativeRagdollRig {0}", Long.toHexString(rigId));
+        finalizeNative(rigId);
+    }
+
+    private native void finalizeNative(long rigId);
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet.debug;
+
+import com.jme3.app.Application;
+import com.jme3.app.state.AppStateManager;
+import com.jme3.bullet.PhysicsSpace;
+import com.jme3.bullet.collision.PhysicsCollisionObject;
+import com.jme3.material.Material;
+import com.jme3.math.ColorRGBA;
+import com.jme3.scene.Spatial;
+import com.jme3.util.BufferUtils;
+import java.nio.FloatBuffer;
+import java.nio.LongBuffer;
+import java.util.HashMap;
+import java.util.Map;
+
+/**
+ * Debug display colored by the physics cost of each object, from blue for the
+ * cheap objects to red for the most expensive one. The costs are read from
+ * {@link PhysicsSpace#getObjectCosts(LongBuffer, FloatBuffer, int, boolean)} at
+ * each interval, the top objects stay available in {@link #getCostIds()} and
+ * {@link #getCosts()}.
+ *
+ * @author dokthar
+ */
+public class BulletCostDebugAppState extends BulletDebugAppState {
+
+    private static final int HEAT_LEVELS = 8;
+    private final LongBuffer costIds;
+    private final FloatBuffer costs;
+    private final Map<Long, Material> heat = new HashMap<Long, Material>();
+    private Material[] heatMaterials;
+    private int costCount = 0;
+    private int costIndex = PhysicsSpace.COST_NARROWPHASE_TIME;
+    private float interval = 1f;
+    private float time = 0;
+
+    public BulletCostDebugAppState(PhysicsSpace space) {
+        this(space, 32);
+    }
+
+    /**
+     * @param space the physics space to profile
+     * @param maxObjects the number of most expensive objects to color
+     */
+    public BulletCostDebugAppState(PhysicsSpace space, int maxObjects) {
+        super(space);
+        costIds = BufferUtils.createByteBuffer(maxObjects * 8).asLongBuffer();
+        costs = BufferUtils.createFloatBuffer(maxObjects * PhysicsSpace.COST_SIZE);
+    }
+
+    /**
+     * @param costIndex the cost used for the colors and to pick the most
+     * expensive objects, one of the PhysicsSpace.COST_ offsets
+     */
+    public void setCostIndex(int costIndex) {
+        this.costIndex = costIndex;
+    }
+
+    public int getCostIndex() {
+        return costIndex;
+    }
+
+    /**
+     * @param interval the time between two readings of the costs, in seconds
+     */
+    public void setInterval(float interval) {
+        this.interval = interval;
+    }
+
+    public float getInterval() {
+        return interval;
+    }
+
+    /**
+     * @return the ids of the most expensive objects of the last interval
+     */
+    public LongBuffer getCostIds() {
+        return costIds;
+    }
+
+    /**
+     * @return the costs of the objects of {@link #getCostIds()},
+     * PhysicsSpace.COST_SIZE floats per object
+     */
+    public FloatBuffer getCosts() {
+        return costs;
+    }
+
+    public int getCostCount() {
+        return costCount;
+    }
+
+    @Override
+    public void initialize(AppStateManager stateManager, Application app) {
+        super.initialize(stateManager, app);
+        heatMaterials = new Material[HEAT_LEVELS];
+        for (int i = 0; i < HEAT_LEVELS; i++) {
+            ColorRGBA color = new ColorRGBA();
+            color.interpolate(ColorRGBA.Blue, ColorRGBA.Red, i / (float) (HEAT_LEVELS - 1));
+            heatMaterials[i] = new Material(assetManager, "Common/MatDefs/Misc/Unshaded.j3md");
+            heatMaterials[i].getAdditionalRenderState().setWireframe(true);
+            heatMaterials[i].setColor("Color", color);
+        }
+        space.setCostProfilingEnabled(true);
+    }
+
+    @Override
+    public void cleanup() {
+        space.setCostProfilingEnabled(false);
+        super.cleanup();
+    }
+
+    @Override
+    public void update(float tpf) {
+        super.update(tpf);
+        time += tpf;
+        if (time >= interval) {
+            time = 0;
+            updateCosts();
+        }
+        //the debug controls set their own material on update
+        applyHeat(bodies);
+        applyHeat(ghosts);
+        applyHeat(characters);
+        applyHeat(vehicles);
+    }
+
+    private void updateCosts() {
+        costIds.clear();
+        costs.clear();
+        costCount = space.getObjectCosts(costIds, costs, costIndex, true);
+        float max = 0;
+        for (int i = 0; i < costCount; i++) {
+            max = Math.max(max, costs.get(i * PhysicsSpace.COST_SIZE + costIndex));
+        }
+        heat.clear();
+        for (int i = 0; i < costCount; i++) {
+            float value = costs.get(i * PhysicsSpace.COST_SIZE + costIndex);
+            int level = max > 0 ? Math.round(value / max * (HEAT_LEVELS - 1)) : 0;
+            heat.put(costIds.get(i), heatMaterials[level]);
+        }
+    }
+
+    private void applyHeat(Map<? extends PhysicsCollisionObject, Spatial> objects) {
+        for (Map.Entry<? extends PhysicsCollisionObject, Spatial> entry : objects.entrySet()) {
+            Material material = heat.get(entry.getKey().getObjectId());
+            entry.getValue().setMaterial(material != null ? material : heatMaterials[0]);
+        }
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet.debug;
+
+import com.jme3.app.Application;
+import com.jme3.app.state.AbstractAppState;
+import com.jme3.app.state.AppStateManager;
+import com.jme3.bullet.PhysicsSpace;
+import com.jme3.material.Material;
+import com.jme3.renderer.RenderManager;
+import com.jme3.renderer.ViewPort;
+import com.jme3.scene.Geometry;
+import com.jme3.scene.Mesh;
+import com.jme3.scene.Node;
+import com.jme3.scene.Spatial;
+import com.jme3.scene.VertexBuffer;
+import com.jme3.scene.VertexBuffer.Type;
+import com.jme3.util.BufferUtils;
+import java.nio.FloatBuffer;
+
+/**
+ * Renders the lines drawn by the native bullet debug drawer, all the lines
+ * are uploaded in a single mesh so the cost does not grow with the number of
+ * debug spatials as in {@link BulletDebugAppState}.<br>
+ * In parallel threading mode the lines are drawn by the physics thread, they
+ * are copied in the mesh under the debug lock of the space.
+ *
+ * @author dokthar
+ */
+public class BulletLinesDebugAppState extends AbstractAppState {
+
+    protected final PhysicsSpace space;
+    protected final Node physicsDebugRootNode = new Node("Physics Lines Debug Root Node");
+    protected final Mesh mesh = new Mesh();
+    protected final Geometry geometry = new Geometry("Physics Debug Lines", mesh);
+    protected ViewPort viewPort;
+    protected RenderManager rm;
+    private int debugDrawMode;
+    private FloatBuffer positions;
+    private FloatBuffer colors;
+
+    public BulletLinesDebugAppState(PhysicsSpace space) {
+        this(space, PhysicsSpace.DEBUG_DRAW_AABB | PhysicsSpace.DEBUG_DRAW_CONTACT_POINTS | PhysicsSpace.DEBUG_DRAW_CONSTRAINTS);
+    }
+
+    /**
+     * @param space the physics space to draw
+     * @param debugDrawMode a combination of the PhysicsSpace.DEBUG_DRAW_ flags
+     */
+    public BulletLinesDebugAppState(PhysicsSpace space, int debugDrawMode) {
+        this.space = space;
+        this.debugDrawMode = debugDrawMode;
+    }
+
+    public void setDebugDrawMode(int debugDrawMode) {
+        this.debugDrawMode = debugDrawMode;
+        if (isInitialized()) {
+            space.setDebugDrawMode(debugDrawMode);
+        }
+    }
+
+    public int getDebugDrawMode() {
+        return debugDrawMode;
+    }
+
+    @Override
+    public void initialize(AppStateManager stateManager, Application app) {
+        super.initialize(stateManager, app);
+        this.rm = app.getRenderManager();
+        Material material = new Material(app.getAssetManager(), "Common/MatDefs/Misc/Unshaded.j3md");
+        material.setBoolean("VertexColor", true);
+        mesh.setMode(Mesh.Mode.Lines);
+        mesh.setDynamic();
+        geometry.setMaterial(material);
+        physicsDebugRootNode.attachChild(geometry);
+        physicsDebugRootNode.setCullHint(Spatial.CullHint.Never);
+        viewPort = rm.createMainView("Physics Lines Debug Overlay", app.getCamera());
+        viewPort.setClearFlags(false, true, false);
+        viewPort.attachScene(physicsDebugRootNode);
+        space.setDebugDrawMode(debugDrawMode);
+    }
+
+    @Override
+    public void cleanup() {
+        space.setDebugDrawMode(PhysicsSpace.DEBUG_DRAW_NONE);
+        rm.removeMainView(viewPort);
+        super.cleanup();
+    }
+
+    @Override
+    public void update(float tpf) {
+        super.update(tpf);
+        //copy the lines, the physics thread may draw the next ones meanwhile
+        int count;
+        synchronized (space.getDebugLock()) {
+            count = space.getDebugVertexCount();
+            if (count > 0) {
+                positions = updateBuffer(Type.Position, 3, positions, space.getDebugPositions(), count);
+                colors = updateBuffer(Type.Color, 4, colors, space.getDebugColors(), count);
+            }
+        }
+        if (count == 0) {
+            geometry.setCullHint(Spatial.CullHint.Always);
+        } else {
+            geometry.setCullHint(Spatial.CullHint.Never);
+            mesh.updateCounts();
+        }
+        physicsDebugRootNode.updateLogicalState(tpf);
+        physicsDebugRootNode.updateGeometricState();
+    }
+
+    private FloatBuffer updateBuffer(Type type, int components, FloatBuffer current, FloatBuffer data, int count) {
+        FloatBuffer source = data.duplicate();
+        source.clear().limit(count * components);
+        if (current == null || current.capacity() < count * components) {
+            //grow the buffer of the mesh and rebind it
+            int capacity = Math.max(count, current == null ? 1024 : current.capacity() / components * 2);
+            current = BufferUtils.createFloatBuffer(capacity * components);
+            current.put(source).flip();
+            mesh.clearBuffer(type);
+            mesh.setBuffer(type, components, current);
+        } else {
+            current.clear();
+            current.put(source).flip();
+            VertexBuffer buffer = mesh.getBuffer(type);
+            buffer.updateData(current);
+        }
+        return current;
+    }
+
+    @Override
+    public void render(RenderManager rm) {
+        super.render(rm);
+        if (viewPort != null) {
+            rm.renderScene(physicsDebugRootNode, viewPort);
+        }
+    }
+}
@@ -42,6 +42,7 @@ import com.jme3.math.Quaternion;
 import com.jme3.math.Vector3f;
 import com.jme3.scene.Spatial;
 import java.io.IOException;
+import java.nio.LongBuffer;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.logging.Level;
@@ -53,6 +54,9 @@ import java.util.logging.Logger;
  * By default, this overlap is based on the AABB.
  * This is useful for creating a character controller,
  * collision sensors/triggers, explosions etc.<br>
+ * With exact overlaps enabled, the overlapping objects are filtered against the
+ * collision shapes after each physics step (in parallel for all the ghosts of
+ * the space), the results are updated on the next step.
  * @author normenhansen
  */
 public class PhysicsGhostObject extends PhysicsCollisionObject {
@@ -60,6 +64,7 @@ public class PhysicsGhostObject extends PhysicsCollisionObject {
     protected boolean locationDirty = false;
     protected final Quaternion tmp_inverseWorldRotation = new Quaternion();
     private List<PhysicsCollisionObject> overlappingObjects = new LinkedList<PhysicsCollisionObject>();
+    private boolean exactOverlaps = false;
 
     public PhysicsGhostObject() {
     }
@@ -81,6 +86,9 @@ public class PhysicsGhostObject extends PhysicsCollisionObject {
             Logger.getLogger(this.getClass().getName()).log(Level.FINE, "Created Ghost Object {0}", Long.toHexString(objectId));
             setGhostFlags(objectId);
             initUserPointer();
+            if (exactOverlaps) {
+                setExactOverlaps(objectId, true);
+            }
         }
 //        if (gObject == null) {
 //            gObject = new PairCachingGhostObject();
@@ -248,6 +256,38 @@ public class PhysicsGhostObject extends PhysicsCollisionObject {
         return overlappingObjects.get(index);
     }
 
+    /**
+     * Store the native ids of the overlapping objects in the given direct buffer,
+     * without creating any java object. Same as the other overlap queries,
+     * only the AABB is tested unless the exact overlaps are enabled.
+     * @param store a direct buffer, at most its capacity ids are stored
+     * @return the overlapping count, may be larger than the buffer capacity
+     */
+    public int getOverlappingIds(LongBuffer store) {
+        return getOverlappingIds(objectId, store);
+    }
+
+    private native int getOverlappingIds(long objectId, LongBuffer store);
+
+    /**
+     * Filter the overlapping objects by the collision shapes instead of the AABBs.
+     * The exact test is done after each physics step, for all the ghosts with
+     * exact overlaps in parallel.
+     * @param exactOverlaps true to filter the overlapping objects
+     */
+    public void setExactOverlaps(boolean exactOverlaps) {
+        this.exactOverlaps = exactOverlaps;
+        if (objectId != 0) {
+            setExactOverlaps(objectId, exactOverlaps);
+        }
+    }
+
+    private native void setExactOverlaps(long objectId, boolean exactOverlaps);
+
+    public boolean isExactOverlaps() {
+        return exactOverlaps;
+    }
+
     public void setCcdSweptSphereRadius(float radius) {
         setCcdSweptSphereRadius(objectId, radius);
     }
@@ -286,6 +326,7 @@ public class PhysicsGhostObject extends PhysicsCollisionObject {
         capsule.write(getPhysicsRotationMatrix(new Matrix3f()), "physicsRotation", new Matrix3f());
         capsule.write(getCcdMotionThreshold(), "ccdMotionThreshold", 0);
         capsule.write(getCcdSweptSphereRadius(), "ccdSweptSphereRadius", 0);
+        capsule.write(exactOverlaps, "exactOverlaps", false);
     }
 
     @Override
@@ -297,5 +338,6 @@ public class PhysicsGhostObject extends PhysicsCollisionObject {
         setPhysicsRotation(((Matrix3f) capsule.readSavable("physicsRotation", new Matrix3f())));
         setCcdMotionThreshold(capsule.readFloat("ccdMotionThreshold", 0));
         setCcdSweptSphereRadius(capsule.readFloat("ccdSweptSphereRadius", 0));
+        setExactOverlaps(capsule.readBoolean("exactOverlaps", false));
     }
 }
@@ -85,6 +85,7 @@ public class PhysicsRigidBody extends PhysicsCollisionObject {
      */
     protected void rebuildRigidBody() {
         boolean removed = false;
+        int simulationTier = 0;
         if (collisionShape instanceof MeshCollisionShape && mass != 0) {
             throw new IllegalStateException("Dynamic rigidbody can not have mesh collision shape!");
         }
@@ -93,6 +94,7 @@ public class PhysicsRigidBody extends PhysicsCollisionObject {
                 PhysicsSpace.getPhysicsSpace().remove(this);
                 removed = true;
             }
+            simulationTier = getSimulationTier(objectId);
             Logger.getLogger(this.getClass().getName()).log(Level.FINE, "Clearing RigidBody {0}", Long.toHexString(objectId));
             finalizeNative(objectId);
         }
@@ -100,6 +102,9 @@ public class PhysicsRigidBody extends PhysicsCollisionObject {
         objectId = createRigidBody(mass, motionState.getObjectId(), collisionShape.getObjectId());
         Logger.getLogger(this.getClass().getName()).log(Level.FINE, "Created RigidBody {0}", Long.toHexString(objectId));
         postRebuild();
+        if (simulationTier != 0) {
+            setSimulationTier(objectId, simulationTier);
+        }
         if (removed) {
             PhysicsSpace.getPhysicsSpace().add(this);
         }
@@ -248,6 +253,27 @@ public class PhysicsRigidBody extends PhysicsCollisionObject {
 //        rBody.getInterpolationWorldTransform(tempTrans);
 //        return Converter.convert(tempTrans.basis, rotation);
 //    }
+    /**
+     * Sets the simulation tier of this body, a body of tier t is stepped every
+     * 2^t physics ticks when the simulation LOD of its space is enabled.
+     * To change many bodies at once use {@link PhysicsSpace#setSimulationTiers(PhysicsRigidBody[], int[])}.
+     * @param tier the tier, from 0 (every tick) to PhysicsSpace.MAX_SIMULATION_TIER
+     */
+    public void setSimulationTier(int tier) {
+        if (tier < 0 || tier > PhysicsSpace.MAX_SIMULATION_TIER) {
+            throw new IllegalArgumentException("The simulation tier must be between 0 and " + PhysicsSpace.MAX_SIMULATION_TIER);
+        }
+        setSimulationTier(objectId, tier);
+    }
+
+    private native void setSimulationTier(long objectId, int tier);
+
+    public int getSimulationTier() {
+        return getSimulationTier(objectId);
+    }
+
+    private native int getSimulationTier(long objectId);
+
     /**
      * Sets the node to kinematic mode. in this mode the node is not affected by physics
      * but affects other physics objects. Iits kinetic force is calculated by the amount
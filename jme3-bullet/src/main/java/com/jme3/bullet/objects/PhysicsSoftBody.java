@@ -39,6 +39,7 @@ import com.jme3.export.JmeExporter;
 import com.jme3.export.JmeImporter;
 import com.jme3.export.OutputCapsule;
 import com.jme3.export.Savable;
+import com.jme3.math.Matrix4f;
 import com.jme3.math.Quaternion;
 import com.jme3.math.Transform;
 import com.jme3.math.Vector3f;
@@ -64,6 +65,9 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
     private final Config config = new Config(this);
     private Material material = null;
     protected List<SoftPhysicsJoint> joints = new ArrayList<SoftPhysicsJoint>();
+    private FloatBuffer pinBoneMatrices = null;
+    // the cluster assignment read from a saved body, set once the nodes exist
+    private int[] savedClusterAssignment = null;
 
     /**
      * Create a new empty soft body. See {@link #createSoftBody} for a
@@ -77,6 +81,7 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
     /**
      * Helper method for creating a soft body. This will not create a new native
      * softbody but it is intended to help the creation of the current one.
+     * The clusters of a loaded body are set back once its nodes are created.
      *
      * @param positions positions of vertexes, they will be added as Node. If
      * null the softbody will be empty, see
@@ -101,6 +106,7 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
                 appendTetras(tetras);
             }
         }
+        applySavedClusterAssignment();
     }
 
     protected void destroySoftBody() {
@@ -434,6 +440,168 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
 
     private native void removeAnchor(long bodyId, int node, long rigidId);
 
+    /**
+     * Create many anchors between this softbody and a rigidbody in a single
+     * native call. The anchors pivots are the current nodes positions.
+     *
+     * @param nodes the nodes attached to the rigid body.
+     * @param rigidBody the body attached to the nodes.
+     * @param influences the influence of each anchor (0 for no influence, 1
+     * for a "strong" influence), if null 1 is used for every anchors.
+     * @param collisionBetweenLinkedBodies enable collision between this
+     * softbody and the rigidbody.
+     */
+    public void appendAnchors(IntBuffer nodes, PhysicsRigidBody rigidBody, FloatBuffer influences, boolean collisionBetweenLinkedBodies) {
+        appendAnchors(nodes, new PhysicsRigidBody[]{rigidBody}, null, influences, null, collisionBetweenLinkedBodies);
+    }
+
+    /**
+     * Create many anchors between this softbody and several rigidbodies in a
+     * single native call.
+     *
+     * @param nodes the nodes attached to the rigid bodies.
+     * @param rigidBodies the bodies used by the anchors.
+     * @param bodyIndexes for each node, the index of its body in rigidBodies,
+     * if null the first body is used for every anchors.
+     * @param influences the influence of each anchor (0 for no influence, 1
+     * for a "strong" influence), if null 1 is used for every anchors.
+     * @param localPivots 3 floats per anchor for the pivot in the rigidbody
+     * space, if null the nodes positions are used.
+     * @param collisionBetweenLinkedBodies enable collision between this
+     * softbody and the rigidbodies.
+     */
+    public void appendAnchors(IntBuffer nodes, PhysicsRigidBody[] rigidBodies, IntBuffer bodyIndexes, FloatBuffer influences, FloatBuffer localPivots, boolean collisionBetweenLinkedBodies) {
+        int count = nodes.capacity();
+        int nodeCount = getNbNodes();
+        for (int i = 0; i < count; i++) {
+            if (nodes.get(i) < 0 || nodes.get(i) >= nodeCount) {
+                throw new IllegalArgumentException();
+            }
+        }
+        if (bodyIndexes != null) {
+            if (bodyIndexes.capacity() < count) {
+                throw new IllegalArgumentException();
+            }
+            for (int i = 0; i < count; i++) {
+                if (bodyIndexes.get(i) < 0 || bodyIndexes.get(i) >= rigidBodies.length) {
+                    throw new IllegalArgumentException();
+                }
+            }
+        } else if (rigidBodies.length == 0) {
+            throw new IllegalArgumentException();
+        }
+        if ((influences != null && influences.capacity() < count)
+                || (localPivots != null && localPivots.capacity() < count * 3)) {
+            throw new IllegalArgumentException();
+        }
+        long[] rigidIds = new long[rigidBodies.length];
+        for (int i = 0; i < rigidBodies.length; i++) {
+            rigidIds[i] = rigidBodies[i].getObjectId();
+        }
+        appendAnchors(objectId, nodes, rigidIds, bodyIndexes, influences, localPivots, collisionBetweenLinkedBodies);
+    }
+
+    private native void appendAnchors(long bodyId, IntBuffer nodes, long[] rigidIds, IntBuffer bodyIndexes, FloatBuffer influences, FloatBuffer localPivots, boolean collisionBetweenLinkedBodies);
+
+    /**
+     * Remove all the anchors between this softbody and the rigidbody.
+     *
+     * @param rigidBody the body used to create the anchors to.
+     */
+    public void removeAnchors(PhysicsRigidBody rigidBody) {
+        removeAnchors(objectId, rigidBody.getObjectId());
+    }
+
+    private native void removeAnchors(long bodyId, long rigidId);
+
+    /**
+     * Move the pivots of the anchors between the given nodes and the
+     * rigidbody, in a single native call.
+     *
+     * @param rigidBody the body used to create the anchors to.
+     * @param nodes the nodes of the anchors to move.
+     * @param localPivots 3 floats per node for the new pivot in the rigidbody
+     * space.
+     */
+    public void setAnchorsPivot(PhysicsRigidBody rigidBody, IntBuffer nodes, FloatBuffer localPivots) {
+        int count = nodes.capacity();
+        int nodeCount = getNbNodes();
+        for (int i = 0; i < count; i++) {
+            if (nodes.get(i) < 0 || nodes.get(i) >= nodeCount) {
+                throw new IllegalArgumentException();
+            }
+        }
+        if (localPivots.capacity() < count * 3) {
+            throw new IllegalArgumentException();
+        }
+        setAnchorsPivot(objectId, rigidBody.getObjectId(), nodes, localPivots);
+    }
+
+    private native void setAnchorsPivot(long bodyId, long rigidId, IntBuffer nodes, FloatBuffer localPivots);
+
+    /**
+     * Move all the anchors attached to a rigidbody to an other rigidbody, the
+     * pivots keep their current world position.
+     *
+     * @param from the body currently used by the anchors.
+     * @param to the new body of the anchors.
+     */
+    public void moveAnchors(PhysicsRigidBody from, PhysicsRigidBody to) {
+        moveAnchors(objectId, from.getObjectId(), to.getObjectId());
+    }
+
+    private native void moveAnchors(long bodyId, long fromId, long toId);
+
+    /**
+     * Get the size (in bytes) of the dynamic state of this softbody, see
+     * {@link #saveState(java.nio.ByteBuffer)}.
+     *
+     * @return the size of the state buffer.
+     */
+    public int getStateSize() {
+        return getStateSize(objectId);
+    }
+
+    private native int getStateSize(long bodyId);
+
+    /**
+     * Save the dynamic state of this softbody : nodes positions and
+     * velocities, clusters frames and velocities and anchors pivots. The state
+     * can be restored later with {@link #restoreState(java.nio.ByteBuffer)},
+     * for example when the body is paged out and back in.
+     *
+     * @param store the direct buffer to write the state into, if null or too
+     * small a new buffer is created.
+     * @return the buffer holding the state.
+     */
+    public ByteBuffer saveState(ByteBuffer store) {
+        int size = getStateSize();
+        if (store == null || !store.isDirect() || store.capacity() < size) {
+            store = BufferUtils.createByteBuffer(size);
+        }
+        saveState(objectId, store);
+        return store;
+    }
+
+    private native void saveState(long bodyId, ByteBuffer state);
+
+    /**
+     * Restore a dynamic state saved with
+     * {@link #saveState(java.nio.ByteBuffer)}. The body must have the same
+     * nodes and clusters than when the state was saved. Anchors are not
+     * created, the saved pivots are only applied to the anchors of the same
+     * nodes that are already appended to this body.
+     *
+     * @param state the direct buffer holding the state.
+     */
+    public void restoreState(ByteBuffer state) {
+        if (!state.isDirect() || !restoreState(objectId, state)) {
+            throw new IllegalArgumentException("The state doesn't match this softbody");
+        }
+    }
+
+    private native boolean restoreState(long bodyId, ByteBuffer state);
+
     public void addJoint(SoftPhysicsJoint joint) {
         if (!joints.contains(joint)) {
             joints.add(joint);
@@ -857,7 +1025,9 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
     /**
      * Generate clusters (K-mean) : generateClusters with k=0 will create a
      * convex cluster for each tetrahedron or triangle, otherwise an
-     * approximation will be used (better performance).
+     * approximation will be used (better performance). For big bodies the
+     * K-mean runs on worker threads (except on Android, built without them),
+     * the clusters are the same than with a single thread.
      *
      * @param k the number of cluster to create, can't be bigger than the number
      * of nodes.
@@ -870,6 +1040,65 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
 
     private native void generateClusters(long objectId, int k, int maxiterations);
 
+    /**
+     * Get the cluster assignment of this body : the node count, the cluster
+     * count, then for each cluster the collide flag, the node count and the
+     * node indexes. The assignment can be saved with an asset and set back
+     * with {@link #setClusterAssignment(java.nio.IntBuffer)} on bodies built
+     * from the same asset, without generating the clusters again.
+     *
+     * @param store the direct buffer to write the assignment into, if null or
+     * too small a new buffer is created.
+     * @return the buffer holding the assignment, its limit is the assignment
+     * size.
+     */
+    public IntBuffer getClusterAssignment(IntBuffer store) {
+        int size = getClusterAssignmentSize(objectId);
+        if (store == null || !store.isDirect() || store.capacity() < size) {
+            store = BufferUtils.createIntBuffer(size);
+        }
+        getClusterAssignment(objectId, store);
+        store.clear();
+        store.limit(size);
+        return store;
+    }
+
+    private native int getClusterAssignmentSize(long objectId);
+
+    private native void getClusterAssignment(long objectId, IntBuffer store);
+
+    /**
+     * Replace the clusters of this body with a cluster assignment made by
+     * {@link #getClusterAssignment(java.nio.IntBuffer)}. The body must have
+     * the same nodes than the body the assignment was made from, and each
+     * cluster must hold at least one node.
+     *
+     * @param assignment the direct buffer holding the assignment, read up to
+     * its limit.
+     */
+    public void setClusterAssignment(IntBuffer assignment) {
+        if (!assignment.isDirect() || !setClusterAssignment(objectId, assignment, assignment.limit())) {
+            throw new IllegalArgumentException("The cluster assignment doesn't match this softbody");
+        }
+    }
+
+    private native boolean setClusterAssignment(long objectId, IntBuffer assignment, int size);
+
+    /**
+     * Set the cluster assignment read by {@link #read(com.jme3.export.JmeImporter)}
+     * once the body has the nodes the clusters were made from.
+     */
+    private void applySavedClusterAssignment() {
+        int[] clusters = savedClusterAssignment;
+        if (clusters == null || clusters.length == 0 || clusters[0] != getNbNodes() || clusters[0] == 0) {
+            return;
+        }
+        savedClusterAssignment = null;
+        IntBuffer assignment = BufferUtils.createIntBuffer(clusters.length);
+        assignment.put(clusters).flip();
+        setClusterAssignment(assignment);
+    }
+
     /**
      * Tell if the current softBody is in added into a physicsSpace.
      *
@@ -911,6 +1140,129 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
 
     private native void getBoundingCenter(long bodyId, Vector3f store);
 
+    /**
+     * Bind nodes of this softbody to the bones of a skeleton. Each pinned node
+     * follow the skinned position (linear blend skinning with 4 bones per
+     * node) computed natively at each physics tick from the bone matrices set
+     * with {@link #setPinBoneMatrices}. Pinned nodes are kinematic : their
+     * mass is set to 0 and restored by {@link #clearSkinnedPins()}. Calling
+     * this method again replace the previous pins.
+     *
+     * @param nodes the indexes of the nodes to pin, a node listed twice only
+     * keeps its first pin.
+     * @param boneIndexes 4 bone indexes for each pinned node.
+     * @param boneWeights 4 bone weights for each pinned node.
+     * @param bindPositions the position of each pinned node (3 floats) in the
+     * model space of the bind pose.
+     */
+    public void setSkinnedPins(IntBuffer nodes, IntBuffer boneIndexes, FloatBuffer boneWeights, FloatBuffer bindPositions) {
+        int count = nodes.capacity();
+        if (boneIndexes.capacity() < count * 4 || boneWeights.capacity() < count * 4 || bindPositions.capacity() < count * 3) {
+            throw new IllegalArgumentException();
+        }
+        setSkinnedPins(objectId, nodes, boneIndexes, boneWeights, bindPositions);
+    }
+
+    private native void setSkinnedPins(long bodyId, IntBuffer nodes, IntBuffer boneIndexes, FloatBuffer boneWeights, FloatBuffer bindPositions);
+
+    /**
+     * Remove all the skinned pins, the nodes get back their mass.
+     */
+    public void clearSkinnedPins() {
+        clearSkinnedPins(objectId);
+        pinBoneMatrices = null;
+    }
+
+    private native void clearSkinnedPins(long bodyId);
+
+    /**
+     * Get the number of nodes pinned to the skeleton.
+     *
+     * @return the number of skinned pins.
+     */
+    public int getNbSkinnedPins() {
+        return getNbSkinnedPins(objectId);
+    }
+
+    private native int getNbSkinnedPins(long bodyId);
+
+    /**
+     * Upload the bone matrices used by the skinned pins, should be called once
+     * per frame. The matrices are stored natively and used for each physics
+     * tick until the next call.
+     *
+     * @param boneMatrices 12 floats (3x4 row major matrix) for each bone, the
+     * skinning (offset) matrices in model space.
+     * @param boneCount the number of bones.
+     * @param modelToWorld the world transform of the skinned model.
+     */
+    public void setPinBoneMatrices(FloatBuffer boneMatrices, int boneCount, Transform modelToWorld) {
+        if (boneMatrices.capacity() < boneCount * 12) {
+            throw new IllegalArgumentException();
+        }
+        setPinBoneMatrices(objectId, boneMatrices, boneCount, modelToWorld, modelToWorld.getScale());
+    }
+
+    /**
+     * Upload the bone matrices used by the skinned pins, should be called once
+     * per frame. Typically used with the skinning matrices of the
+     * SkeletonControl ({@code skeleton.computeSkinningMatrices()}).
+     *
+     * @param skinningMatrices the skinning (offset) matrices in model space.
+     * @param modelToWorld the world transform of the skinned model.
+     */
+    public void setPinBoneMatrices(Matrix4f[] skinningMatrices, Transform modelToWorld) {
+        int boneCount = skinningMatrices.length;
+        if (pinBoneMatrices == null || pinBoneMatrices.capacity() < boneCount * 12) {
+            pinBoneMatrices = BufferUtils.createFloatBuffer(boneCount * 12);
+        }
+        pinBoneMatrices.clear();
+        for (Matrix4f m : skinningMatrices) {
+            pinBoneMatrices.put(m.m00).put(m.m01).put(m.m02).put(m.m03);
+            pinBoneMatrices.put(m.m10).put(m.m11).put(m.m12).put(m.m13);
+            pinBoneMatrices.put(m.m20).put(m.m21).put(m.m22).put(m.m23);
+        }
+        setPinBoneMatrices(pinBoneMatrices, boneCount, modelToWorld);
+    }
+
+    private native void setPinBoneMatrices(long bodyId, FloatBuffer boneMatrices, int boneCount, Transform modelToWorld, Vector3f scale);
+
+    /**
+     * Get the time spent in the VF_SELF self collision during the last
+     * physics step, see {@link Config#VF_SELF}.
+     *
+     * @return the time in milliseconds.
+     */
+    public float getSelfCollisionTime() {
+        return getSelfCollisionTime(objectId);
+    }
+
+    private native float getSelfCollisionTime(long bodyId);
+
+    /**
+     * Get the number of node versus face tests done by the VF_SELF self
+     * collision during the last physics step.
+     *
+     * @return the number of tests, equals to the budget if it was exceeded.
+     */
+    public int getSelfCollisionTests() {
+        return getSelfCollisionTests(objectId);
+    }
+
+    private native int getSelfCollisionTests(long bodyId);
+
+    /**
+     * Get the number of contacts solved by the VF_SELF self collision during
+     * the last physics step.
+     *
+     * @return the number of contacts.
+     */
+    public int getSelfCollisionContacts() {
+        return getSelfCollisionContacts(objectId);
+    }
+
+    private native int getSelfCollisionContacts(long bodyId);
+
     /**
      * Get the config object which hold methods to access to the native config
      * fields.
@@ -928,6 +1280,12 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
 
         capsule.write(getRestLengthScale(), "RestLengthScale", 0);
         capsule.write(getPhysicsLocation(), "PhysicsLocation", Vector3f.ZERO);
+        if (getClusterCount() > 0) {
+            IntBuffer assignment = getClusterAssignment(null);
+            int[] clusters = new int[assignment.limit()];
+            assignment.get(clusters);
+            capsule.write(clusters, "ClusterAssignment", null);
+        }
 
         config().write(capsule);
         material().write(capsule);
@@ -940,6 +1298,11 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
 
         setRestLengthScale(capsule.readFloat("RestLengthScale", 0));
         setPhysicsLocation((Vector3f) capsule.readSavable("PhysicsLocation", Vector3f.ZERO));
+        // a loaded body is empty until its nodes are created (by
+        // createSoftBody, or the mesh of a SoftBodyControl), the clusters are
+        // set back then
+        savedClusterAssignment = capsule.readIntArray("ClusterAssignment", null);
+        applySavedClusterAssignment();
 
         config().read(capsule);
         material().read(capsule);
@@ -1542,6 +1905,14 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
          */
         public final static int CL_SELF = 0x0040;
 
+        /**
+         * Config collision flag : Vertex vs face soft body self collision,
+         * using a spatial hash. Much faster than CL_SELF for cloth, see
+         * {@link #setSelfCollisionThickness(float)} and
+         * {@link #setSelfCollisionBudget(int)}.
+         */
+        public final static int VF_SELF = 0x0080;
+
         /**
          * Config collision flag : Default value = SDF_RS. (SDF based rigid vs
          * soft)
@@ -1577,6 +1948,54 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
 
         private native int getCollisionsFlags(long bodyId);
 
+        /**
+         * Set the thickness used by the VF_SELF self collision, nodes are kept
+         * at this distance of the faces.
+         *
+         * @param thickness the value to set, default is 0.02.
+         */
+        public void setSelfCollisionThickness(float thickness) {
+            setSelfCollisionThickness(objectId, thickness);
+        }
+
+        private native void setSelfCollisionThickness(long bodyId, float thickness);
+
+        /**
+         * Get the thickness used by the VF_SELF self collision.
+         *
+         * @return the thickness value.
+         */
+        public float getSelfCollisionThickness() {
+            return getSelfCollisionThickness(objectId);
+        }
+
+        private native float getSelfCollisionThickness(long bodyId);
+
+        /**
+         * Set the maximum number of node versus face tests done by the VF_SELF
+         * self collision at each step. The nodes left untested when the budget
+         * is reached are tested first at the next step.
+         *
+         * @param budget the value to set, 0 for no limit (default).
+         */
+        public void setSelfCollisionBudget(int budget) {
+            setSelfCollisionBudget(objectId, budget);
+        }
+
+        private native void setSelfCollisionBudget(long bodyId, int budget);
+
+        /**
+         * Get the maximum number of node versus face tests done by the VF_SELF
+         * self collision at each step.
+         *
+         * @return the budget value, 0 for no limit.
+         */
+        public int getSelfCollisionBudget() {
+            return getSelfCollisionBudget(objectId);
+        }
+
+        private native int getSelfCollisionBudget(long bodyId);
+
         protected void write(OutputCapsule capsule) throws IOException {
 
             capsule.write(getVelocitiesCorrectionFactor(), "VelocitiesCorrectionFactor", 1f);
@@ -1609,6 +2028,8 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
             capsule.write(getClusterIterations(), "ClusterIterations", 4);
 
             capsule.write(getCollisionsFlags(), "CollisionsFlags", Default);
+            capsule.write(getSelfCollisionThickness(), "SelfCollisionThickness", 0.02f);
+            capsule.write(getSelfCollisionBudget(), "SelfCollisionBudget", 0);
         }
 
         protected void read(InputCapsule capsule) throws IOException {
@@ -1643,6 +2064,8 @@ public class PhysicsSoftBody extends PhysicsCollisionObject implements Savable {
             setClusterIterations(capsule.readInt("ClusterIterations", 4));
 
             setCollisionsFlags(capsule.readInt("CollisionsFlags", Default));
+            setSelfCollisionThickness(capsule.readFloat("SelfCollisionThickness", 0.02f));
+            setSelfCollisionBudget(capsule.readInt("SelfCollisionBudget", 0));
         }
 
     };
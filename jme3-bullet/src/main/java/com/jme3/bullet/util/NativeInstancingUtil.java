@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet.util;
+
+import com.jme3.bullet.objects.PhysicsRigidBody;
+import com.jme3.math.Vector3f;
+import com.jme3.scene.VertexBuffer;
+import java.nio.FloatBuffer;
+
+/**
+ * Writes the transforms of rigid bodies directly in the instance data layout
+ * of {@link com.jme3.scene.instancing.InstancedGeometry} : 16 floats per
+ * instance, the column major 4x3 world matrix with the inverse rotation
+ * quaternion in the w of the columns.<br>
+ * The transforms are read natively from the motion states, so the physics
+ * and the instanced rendering share a single copy per frame.
+ *
+ * @author dokthar
+ */
+public class NativeInstancingUtil {
+
+    public static final int INSTANCE_SIZE = 16;
+    // the object ids of the last call, read again at each call as a body gets
+    // a new native object when it is rebuilt (mass or shape change)
+    private static final ThreadLocal<long[]> bodyIdsTL = new ThreadLocal<long[]>();
+
+    /**
+     * Writes the instance data of the bodies, the buffer is flipped like the
+     * one of InstancedGeometry : position 0 and limit at the last instance.
+     *
+     * @param bodies the bodies, null entries give hidden instances
+     * @param count the number of bodies to write
+     * @param scale the scale of the instances, or null for none
+     * @param store a direct buffer of at least count * INSTANCE_SIZE floats
+     * @return the store buffer
+     */
+    public static FloatBuffer writeInstanceData(PhysicsRigidBody[] bodies, int count, Vector3f scale, FloatBuffer store) {
+        if (bodies.length < count) {
+            throw new IllegalArgumentException("The bodies are fewer than the count.");
+        }
+        long[] bodyIds = bodyIdsTL.get();
+        if (bodyIds == null || bodyIds.length < count) {
+            bodyIds = new long[count];
+            bodyIdsTL.set(bodyIds);
+        }
+        for (int i = 0; i < count; i++) {
+            bodyIds[i] = bodies[i] != null ? bodies[i].getObjectId() : 0;
+        }
+        writeInstances(bodyIds, count, scale, store);
+        store.limit(count * INSTANCE_SIZE).position(0);
+        return store;
+    }
+
+    /**
+     * Writes the instance data of the bodies in an instance data vertex
+     * buffer, such as the one of an InstancedGeometry in manual mode.
+     */
+    public static void updateInstanceData(PhysicsRigidBody[] bodies, int count, Vector3f scale, VertexBuffer instanceData) {
+        FloatBuffer store = (FloatBuffer) instanceData.getData();
+        store.limit(store.capacity());
+        writeInstanceData(bodies, count, scale, store);
+        instanceData.updateData(store);
+    }
+
+    private static native void writeInstances(long[] bodyIds, int count, Vector3f scale, FloatBuffer store);
+}
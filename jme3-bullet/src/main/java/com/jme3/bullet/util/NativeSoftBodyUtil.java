@@ -285,6 +285,39 @@ public class NativeSoftBodyUtil {
 
     private static native void updateMesh(long bodyId, FloatBuffer outPositionBuffer, FloatBuffer outNormalBuffer, boolean meshInLocalSpace, boolean updateNormals);
 
+    /**
+     * Update the mesh vertexes positions and optionally normals and tangents,
+     * from a given softbody. Directly update the mesh buffers in a single
+     * native pass. Unlike the other updateMesh methods, normals are computed
+     * from the render mesh triangles (smoothed over the shared vertexes), so
+     * they are also valid for link only softbodies.
+     *
+     * @param body the softbody where the positions are read.
+     * @param topology the topology of the mesh, created once for the mesh.
+     * @param store the Mesh to write the positions, normals and tangents into.
+     * @param meshInLocalSpace boolean for transforming the vertexes position
+     * into the "localSapce" of the body. (ie the bullet's bounding box center)
+     * @param updateNormals boolean for updating the normal buffer as the same
+     * time.
+     * @param updateTangents boolean for updating the tangent buffer (4
+     * components) as the same time, need texture coordinates.
+     */
+    public static void updateMesh(PhysicsSoftBody body, SoftBodyMeshTopology topology, Mesh store, boolean meshInLocalSpace, boolean updateNormals, boolean updateTangents) {
+        FloatBuffer positionBuffer = store.getFloatBuffer(VertexBuffer.Type.Position);
+        FloatBuffer normalBuffer = updateNormals ? store.getFloatBuffer(VertexBuffer.Type.Normal) : null;
+        FloatBuffer tangentBuffer = updateTangents ? store.getFloatBuffer(VertexBuffer.Type.Tangent) : null;
+        updateMeshWithTopology(body.getObjectId(), topology.getTopologyId(), positionBuffer, normalBuffer, tangentBuffer, meshInLocalSpace);
+        store.getBuffer(VertexBuffer.Type.Position).setUpdateNeeded();
+        if (normalBuffer != null) {
+            store.getBuffer(VertexBuffer.Type.Normal).setUpdateNeeded();
+        }
+        if (tangentBuffer != null) {
+            store.getBuffer(VertexBuffer.Type.Tangent).setUpdateNeeded();
+        }
+    }
+
+    private static native void updateMeshWithTopology(long bodyId, long topologyId, FloatBuffer outPositionBuffer, FloatBuffer outNormalBuffer, FloatBuffer outTangentBuffer, boolean meshInLocalSpace);
+
     /**
      * Utility class for createFromTriMesh
      */
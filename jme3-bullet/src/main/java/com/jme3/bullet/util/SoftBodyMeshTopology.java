@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet.util;
+
+import com.jme3.scene.Mesh;
+import com.jme3.scene.VertexBuffer;
+import com.jme3.scene.mesh.IndexBuffer;
+import com.jme3.util.BufferUtils;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * Native topology of a render mesh used by a softbody. It store the jme to
+ * bullet index map, the vertex to triangles adjacency and the texture
+ * coordinates terms needed to compute the tangents. Created once, it allow
+ * {@link NativeSoftBodyUtil#updateMesh(com.jme3.bullet.objects.PhysicsSoftBody, com.jme3.bullet.util.SoftBodyMeshTopology, com.jme3.scene.Mesh, boolean, boolean, boolean)}
+ * to update positions, normals and tangents in a single native pass.
+ *
+ * @author dokthar
+ */
+public class SoftBodyMeshTopology {
+
+    private final long topologyId;
+
+    /**
+     * Create the topology of a mesh, with a 1:1 mapping between the mesh
+     * vertexes and the softbody nodes.
+     *
+     * @param mesh the render mesh, with a {@link Mesh.Mode#Triangles} index
+     * buffer.
+     */
+    public SoftBodyMeshTopology(Mesh mesh) {
+        this(mesh, null);
+    }
+
+    /**
+     * Create the topology of a mesh. Tangents can only be computed if the mesh
+     * have a texture coordinates buffer.
+     *
+     * @param mesh the render mesh, with a {@link Mesh.Mode#Triangles} index
+     * buffer.
+     * @param jmeToBulletMap the index mapping (null for a 1:1 mapping), see
+     * {@link NativeSoftBodyUtil#generateIndexMap(java.nio.FloatBuffer)}.
+     */
+    public SoftBodyMeshTopology(Mesh mesh, IntBuffer jmeToBulletMap) {
+        int vertexCount = mesh.getVertexCount();
+        IndexBuffer triangles = mesh.getIndexBuffer();
+        IntBuffer indexes = BufferUtils.createIntBuffer(triangles.size());
+        for (int i = 0, size = triangles.size(); i < size; i++) {
+            int index = triangles.get(i);
+            if (index < 0 || index >= vertexCount) {
+                throw new IllegalArgumentException("Index out of the vertex range : " + index);
+            }
+            indexes.put(i, index);
+        }
+        if (jmeToBulletMap != null && jmeToBulletMap.capacity() < vertexCount) {
+            throw new IllegalArgumentException();
+        }
+        for (int i = 0; jmeToBulletMap != null && i < vertexCount; i++) {
+            if (jmeToBulletMap.get(i) < 0) {
+                throw new IllegalArgumentException("Negative node index : " + jmeToBulletMap.get(i));
+            }
+        }
+        FloatBuffer texCoords = mesh.getFloatBuffer(VertexBuffer.Type.TexCoord);
+        if (texCoords != null && texCoords.capacity() < vertexCount * 2) {
+            throw new IllegalArgumentException("Expected 2 texture coordinates per vertex");
+        }
+        topologyId = createTopology(indexes, jmeToBulletMap, texCoords, vertexCount);
+    }
+
+    /**
+     * Apply the render mesh changes of a {@link SoftBodyTearing}, the topology
+     * must have been created after the tearing, on the grown mesh.
+     */
+    void applyTearing(IntBuffer vertexDeltas, int vertexDeltaCount, IntBuffer triangleDeltas, int triangleDeltaCount) {
+        applyTearing(topologyId, vertexDeltas, vertexDeltaCount, triangleDeltas, triangleDeltaCount);
+    }
+
+    private native void applyTearing(long topologyId, IntBuffer vertexDeltas, int vertexDeltaCount, IntBuffer triangleDeltas, int triangleDeltaCount);
+
+    private native long createTopology(IntBuffer indexes, IntBuffer jmeToBulletMap, FloatBuffer texCoords, int vertexCount);
+
+    /**
+     * <!> Used internally !
+     *
+     * @return the id of the native object.
+     */
+    public long getTopologyId() {
+        return topologyId;
+    }
+
+    @Override
+    protected void finalize() throws Throwable {
+        super.finalize();
+        Logger.getLogger(this.getClass().getName()).log(Level.FINE, "Finalizing SoftBodyMeshTopology {0}", Long.toHexString(topologyId));
+        finalizeNative(topologyId);
+    }
+
+    private native void finalizeNative(long topologyId);
+}
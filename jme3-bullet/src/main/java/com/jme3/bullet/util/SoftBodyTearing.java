@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet.util;
+
+import com.jme3.bullet.objects.PhysicsSoftBody;
+import com.jme3.scene.Mesh;
+import com.jme3.scene.VertexBuffer;
+import com.jme3.scene.mesh.IndexBuffer;
+import com.jme3.util.BufferUtils;
+import java.nio.IntBuffer;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Native tearing of a softbody (cloth or rope) and incremental update of its
+ * render mesh.
+ * After each step, the links stretched over the strain threshold (length /
+ * rest length) are torn : one of their nodes is split along the plane
+ * orthogonal to the link, a new node takes the faces and links on the far
+ * side. The render mesh changes are reported as small deltas, new vertexes
+ * and updated triangles (or lines for a rope), so the mesh is patched by
+ * {@link #update} instead of being rebuilt.
+ * <p>
+ * The mesh vertex buffers are grown once, at creation, to hold the new
+ * vertexes. The unused vertexes are not referenced by any triangle. A
+ * {@link SoftBodyMeshTopology} used with the mesh must be created after the
+ * tearing. The deltas are queued natively behind a lock, so {@link #update}
+ * can run while the physics space is stepped on its own thread.
+ *
+ * @author dokthar
+ */
+public class SoftBodyTearing {
+
+    private static final int DELTA_SIZE = 64;
+    private final PhysicsSoftBody body;
+    private final IntBuffer jmeToBulletMap;
+    private final int maxVertexCount;
+    private final int primitiveSize;
+    private final IntBuffer vertexDeltas = BufferUtils.createIntBuffer(DELTA_SIZE * 3);
+    private final IntBuffer triangleDeltas = BufferUtils.createIntBuffer(DELTA_SIZE * 4);
+    private float strainThreshold;
+    private int maxTearsPerStep = 16;
+
+    /**
+     * Enable the tearing of a softbody created from the given mesh.
+     *
+     * @param body the softbody, created from the mesh.
+     * @param mesh the render mesh, with a {@link Mesh.Mode#Triangles} index
+     * buffer, or a {@link Mesh.Mode#Lines} one for a rope, its buffers are
+     * replaced by bigger ones.
+     * @param jmeToBulletMap the index mapping (null for a 1:1 mapping), see
+     * {@link NativeSoftBodyUtil#generateIndexMap(java.nio.FloatBuffer)}. A
+     * bigger copy is used, see {@link #getJmeToBulletMap()}.
+     * @param strainThreshold the link strain over which a link is torn, (ie
+     * 1.5 for a link stretched to 150% of its rest length).
+     * @param maxNewVertexes the maximum number of vertexes added to the mesh,
+     * the tearing stops when they are all used.
+     */
+    public SoftBodyTearing(PhysicsSoftBody body, Mesh mesh, IntBuffer jmeToBulletMap, float strainThreshold, int maxNewVertexes) {
+        if (mesh.getMode() == Mesh.Mode.Triangles) {
+            primitiveSize = 3;
+        } else if (mesh.getMode() == Mesh.Mode.Lines) {
+            primitiveSize = 2;
+        } else {
+            throw new IllegalArgumentException("The mesh must be a triangle or a line mesh");
+        }
+        this.body = body;
+        this.strainThreshold = strainThreshold;
+        int vertexCount = mesh.getVertexCount();
+        maxVertexCount = vertexCount + maxNewVertexes;
+
+        List<VertexBuffer> buffers = new ArrayList<VertexBuffer>();
+        for (VertexBuffer vb : mesh.getBufferList()) {
+            if (vb.getBufferType() != VertexBuffer.Type.Index && vb.getData() != null && vb.getNumElements() == vertexCount) {
+                buffers.add(vb);
+            }
+        }
+        for (VertexBuffer vb : buffers) {
+            VertexBuffer grown = new VertexBuffer(vb.getBufferType());
+            grown.setupData(VertexBuffer.Usage.Dynamic, vb.getNumComponents(), vb.getFormat(),
+                    VertexBuffer.createBuffer(vb.getFormat(), vb.getNumComponents(), maxVertexCount));
+            grown.setNormalized(vb.isNormalized());
+            vb.copyElements(0, grown, 0, vertexCount);
+            mesh.clearBuffer(vb.getBufferType());
+            mesh.setBuffer(grown);
+        }
+        // int indexes, the vertex count can grow over a short index range
+        IndexBuffer triangles = mesh.getIndexBuffer();
+        IntBuffer indexes = BufferUtils.createIntBuffer(triangles.size());
+        for (int i = 0, size = triangles.size(); i < size; i++) {
+            indexes.put(i, triangles.get(i));
+        }
+        mesh.clearBuffer(VertexBuffer.Type.Index);
+        mesh.setBuffer(VertexBuffer.Type.Index, primitiveSize, indexes);
+        mesh.updateCounts();
+
+        this.jmeToBulletMap = BufferUtils.createIntBuffer(maxVertexCount);
+        for (int i = 0; i < vertexCount; i++) {
+            this.jmeToBulletMap.put(i, jmeToBulletMap != null ? jmeToBulletMap.get(i) : i);
+        }
+        createTearing(body.getObjectId(), indexes, primitiveSize, this.jmeToBulletMap, vertexCount, maxVertexCount);
+        setStrainThreshold(body.getObjectId(), strainThreshold);
+        setMaxTearsPerStep(body.getObjectId(), maxTearsPerStep);
+    }
+
+    /**
+     * Patch the render mesh with the changes since the last update : copy the
+     * vertex attributes of the new vertexes, update the index map and the
+     * triangles.
+     *
+     * @param mesh the render mesh given at creation.
+     * @param topology the topology of the mesh to patch too, or null, only for
+     * a triangle mesh.
+     * @return true if the mesh was changed.
+     */
+    public boolean update(Mesh mesh, SoftBodyMeshTopology topology) {
+        if (topology != null && primitiveSize != 3) {
+            throw new IllegalArgumentException("A topology needs a triangle mesh");
+        }
+        boolean changed = false;
+        int count;
+        while ((count = getVertexDeltas(body.getObjectId(), vertexDeltas)) > 0) {
+            for (int i = 0; i < count; i++) {
+                int vertex = vertexDeltas.get(i * 3);
+                int source = vertexDeltas.get(i * 3 + 1);
+                if (vertex != source) {
+                    for (VertexBuffer vb : mesh.getBufferList()) {
+                        if (vb.getBufferType() != VertexBuffer.Type.Index && vb.getNumElements() == maxVertexCount) {
+                            vb.copyElement(source, vb, vertex);
+                        }
+                    }
+                }
+                jmeToBulletMap.put(vertex, vertexDeltas.get(i * 3 + 2));
+            }
+            if (topology != null) {
+                topology.applyTearing(vertexDeltas, count, triangleDeltas, 0);
+            }
+            changed = true;
+        }
+        IndexBuffer indexes = mesh.getIndexBuffer();
+        while ((count = getTriangleDeltas(body.getObjectId(), triangleDeltas)) > 0) {
+            for (int i = 0; i < count; i++) {
+                int triangle = triangleDeltas.get(i * 4);
+                for (int k = 0; k < primitiveSize; k++) {
+                    indexes.put(triangle * primitiveSize + k, triangleDeltas.get(i * 4 + 1 + k));
+                }
+            }
+            if (topology != null) {
+                topology.applyTearing(vertexDeltas, 0, triangleDeltas, count);
+            }
+            changed = true;
+        }
+        if (changed) {
+            for (VertexBuffer vb : mesh.getBufferList()) {
+                vb.setUpdateNeeded();
+            }
+        }
+        return changed;
+    }
+
+    /**
+     * @return the index mapping to use with the mesh, updated by
+     * {@link #update}, see
+     * {@link NativeSoftBodyUtil#updateMesh(com.jme3.bullet.objects.PhysicsSoftBody, java.nio.IntBuffer, com.jme3.scene.Mesh, boolean, boolean)}.
+     */
+    public IntBuffer getJmeToBulletMap() {
+        return jmeToBulletMap;
+    }
+
+    public int getMaxVertexCount() {
+        return maxVertexCount;
+    }
+
+    public float getStrainThreshold() {
+        return strainThreshold;
+    }
+
+    public void setStrainThreshold(float strainThreshold) {
+        this.strainThreshold = strainThreshold;
+        setStrainThreshold(body.getObjectId(), strainThreshold);
+    }
+
+    public int getMaxTearsPerStep() {
+        return maxTearsPerStep;
+    }
+
+    /**
+     * @param maxTearsPerStep the maximum number of links torn in a step.
+     */
+    public void setMaxTearsPerStep(int maxTearsPerStep) {
+        this.maxTearsPerStep = maxTearsPerStep;
+        setMaxTearsPerStep(body.getObjectId(), maxTearsPerStep);
+    }
+
+    /**
+     * Stop the tearing of the softbody, the mesh keeps its changes.
+     */
+    public void remove() {
+        removeTearing(body.getObjectId());
+    }
+
+    private native void createTearing(long bodyId, IntBuffer indexes, int primitiveSize, IntBuffer jmeToBulletMap, int vertexCount, int maxVertexCount);
+
+    private native void setStrainThreshold(long bodyId, float strainThreshold);
+
+    private native void setMaxTearsPerStep(long bodyId, int maxTearsPerStep);
+
+    private native void removeTearing(long bodyId);
+
+    private native int getVertexDeltas(long bodyId, IntBuffer store);
+
+    private native int getTriangleDeltas(long bodyId, IntBuffer store);
+}
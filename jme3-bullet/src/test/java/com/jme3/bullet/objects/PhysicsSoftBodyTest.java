@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2009-2016 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.jme3.bullet.objects;
+
+import com.jme3.export.binary.BinaryExporter;
+import com.jme3.scene.mesh.IndexBuffer;
+import com.jme3.scene.mesh.IndexIntBuffer;
+import com.jme3.util.BufferUtils;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import org.junit.Assume;
+import org.junit.BeforeClass;
+import org.junit.Test;
+import static org.junit.Assert.*;
+
+/**
+ *
+ * @author dokthar
+ */
+public class PhysicsSoftBodyTest {
+
+    private static final int SIZE = 8;
+
+    public PhysicsSoftBodyTest() {
+    }
+
+    @BeforeClass
+    public static void loadNatives() {
+        try {
+            System.loadLibrary("bulletjme");
+        } catch (UnsatisfiedLinkError e) {
+            Assume.assumeNoException("The bullet natives are not available", e);
+        }
+    }
+
+    /**
+     * Test of write and read methods, of class PhysicsSoftBody : the clusters
+     * of a loaded body are set back once its nodes are created.
+     */
+    @Test
+    public void testSaveAndLoadClusters() {
+        PhysicsSoftBody body = new PhysicsSoftBody();
+        body.createSoftBody(createPositions(), null, createTriangles(), null);
+        body.generateClusters(4);
+        int clusterCount = body.getClusterCount();
+        assertTrue(clusterCount > 0);
+
+        PhysicsSoftBody loaded = BinaryExporter.saveAndLoad(null, body);
+        assertEquals(0, loaded.getClusterCount());
+        loaded.createSoftBody(createPositions(), null, createTriangles(), null);
+        assertEquals(clusterCount, loaded.getClusterCount());
+    }
+
+    // a SIZE x SIZE grid of nodes on the XZ plane
+    private static FloatBuffer createPositions() {
+        FloatBuffer positions = BufferUtils.createFloatBuffer(SIZE * SIZE * 3);
+        for (int z = 0; z < SIZE; z++) {
+            for (int x = 0; x < SIZE; x++) {
+                positions.put(x).put(0).put(z);
+            }
+        }
+        positions.flip();
+        return positions;
+    }
+
+    private static IndexBuffer createTriangles() {
+        IntBuffer triangles = BufferUtils.createIntBuffer((SIZE - 1) * (SIZE - 1) * 6);
+        for (int z = 0; z < SIZE - 1; z++) {
+            for (int x = 0; x < SIZE - 1; x++) {
+                int i = z * SIZE + x;
+                triangles.put(i).put(i + SIZE).put(i + 1);
+                triangles.put(i + 1).put(i + SIZE).put(i + SIZE + 1);
+            }
+        }
+        triangles.flip();
+        return new IndexIntBuffer(triangles);
+    }
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package jme3test.bullet;
+
+import com.jme3.app.SimpleApplication;
+import com.jme3.bullet.PhysicsSpace;
+import com.jme3.bullet.collision.PhysicsRayTestResult;
+import com.jme3.bullet.collision.shapes.MeshCollisionShape;
+import com.jme3.bullet.collision.shapes.SphereCollisionShape;
+import com.jme3.bullet.objects.PhysicsRigidBody;
+import com.jme3.math.FastMath;
+import com.jme3.math.Vector3f;
+import com.jme3.system.JmeContext;
+import com.jme3.util.BufferUtils;
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+
+/**
+ * Build time of the default and of the parallel BVH of large triangle meshes,
+ * and the ray test and step time on the resulting shapes.
+ * The 5M triangles terrain is made of three meshes, a mesh part can't hold
+ * more than 2097152 triangles in a BVH.
+ * Needs a large heap and direct memory, e.g. -Xmx2g -XX:MaxDirectMemorySize=2g
+ *
+ * @author dokthar
+ */
+public class TestMeshBvhBenchmark extends SimpleApplication {
+
+    private static final int RAYS = 20000;
+    private static final int BODIES = 400;
+    private static final int STEPS = 300;
+
+    public static void main(String[] args) {
+        TestMeshBvhBenchmark app = new TestMeshBvhBenchmark();
+        app.start(JmeContext.Type.Headless);
+    }
+
+    @Override
+    public void simpleInitApp() {
+        // 708 * 708 * 2 ~ 1M triangles, 3 * 913 * 913 * 2 ~ 5M triangles
+        run("1M / default", 1, 708, false);
+        run("1M / parallel", 1, 708, true);
+        run("5M / default", 3, 913, false);
+        run("5M / parallel", 3, 913, true);
+        stop();
+    }
+
+    private void run(String name, int tiles, int quads, boolean parallelBvh) {
+        ByteBuffer indices = createIndices(quads);
+        long buildTime = 0;
+        PhysicsSpace space = new PhysicsSpace();
+        for (int i = 0; i < tiles; i++) {
+            ByteBuffer vertices = createVertices(quads, i * quads);
+            long start = System.nanoTime();
+            MeshCollisionShape shape = new MeshCollisionShape(indices, vertices, true, parallelBvh);
+            buildTime += System.nanoTime() - start;
+            space.add(new PhysicsRigidBody(shape, 0));
+        }
+
+        Random random = new Random(0);
+        List<PhysicsRayTestResult> results = new ArrayList<PhysicsRayTestResult>();
+        Vector3f from = new Vector3f();
+        Vector3f to = new Vector3f();
+        int hits = 0;
+        long start = System.nanoTime();
+        for (int i = 0; i < RAYS; i++) {
+            float x = random.nextFloat() * tiles * quads;
+            float z = random.nextFloat() * quads;
+            from.set(x, 10, z);
+            to.set(x + random.nextFloat() * 20f - 10f, -10, z + random.nextFloat() * 20f - 10f);
+            hits += space.rayTest(from, to, results).size();
+        }
+        long rayTime = System.nanoTime() - start;
+
+        SphereCollisionShape sphere = new SphereCollisionShape(0.5f);
+        int side = (int) FastMath.sqrt(BODIES);
+        for (int i = 0; i < BODIES; i++) {
+            PhysicsRigidBody body = new PhysicsRigidBody(sphere, 1);
+            body.setPhysicsLocation(new Vector3f(quads / 2f + (i % side - side / 2) * 4f, 6, quads / 2f + (i / side - side / 2) * 4f));
+            space.add(body);
+        }
+        // let the bodies fall before the timing
+        for (int i = 0; i < 60; i++) {
+            space.update(1f / 60f, 0);
+        }
+        start = System.nanoTime();
+        for (int i = 0; i < STEPS; i++) {
+            space.update(1f / 60f, 0);
+        }
+        long stepTime = System.nanoTime() - start;
+
+        System.out.println(name + " : build " + (buildTime / 1000000f) + " ms, "
+                + (rayTime / 1000f / RAYS) + " us/ray (" + hits + " hits), "
+                + (stepTime / 1000000f / STEPS) + " ms/step");
+        space.destroy();
+    }
+
+    private static ByteBuffer createVertices(int quads, int offset) {
+        int size = quads + 1;
+        ByteBuffer vertices = BufferUtils.createByteBuffer(size * size * 3 * 4);
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                float height = FastMath.sin((x + offset) * 0.2f) * FastMath.cos(y * 0.15f) * 3f;
+                vertices.putFloat(x + offset).putFloat(height).putFloat(y);
+            }
+        }
+        vertices.flip();
+        return vertices;
+    }
+
+    private static ByteBuffer createIndices(int quads) {
+        int size = quads + 1;
+        ByteBuffer indices = BufferUtils.createByteBuffer(quads * quads * 6 * 4);
+        for (int y = 0; y < quads; y++) {
+            for (int x = 0; x < quads; x++) {
+                int i = y * size + x;
+                indices.putInt(i).putInt(i + size).putInt(i + 1);
+                indices.putInt(i + 1).putInt(i + size).putInt(i + size + 1);
+            }
+        }
+        indices.flip();
+        return indices;
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2009-2015 jMonkeyEngine
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ *
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * * Neither the name of 'jMonkeyEngine' nor the names of its contributors
+ *   may be used to endorse or promote products derived from this software
+ *   without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ * TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package jme3test.bullet;
+
+import com.jme3.app.SimpleApplication;
+import com.jme3.bullet.PhysicsSpace;
+import com.jme3.bullet.collision.shapes.CapsuleCollisionShape;
+import com.jme3.bullet.collision.shapes.CollisionShape;
+import com.jme3.bullet.collision.shapes.HeightfieldCollisionShape;
+import com.jme3.bullet.collision.shapes.MeshCollisionShape;
+import com.jme3.bullet.collision.shapes.SphereCollisionShape;
+import com.jme3.bullet.objects.PhysicsRigidBody;
+import com.jme3.math.FastMath;
+import com.jme3.math.Vector3f;
+import com.jme3.scene.Mesh;
+import com.jme3.scene.VertexBuffer;
+import com.jme3.system.JmeContext;
+import com.jme3.util.BufferUtils;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+
+/**
+ * Step time of spheres and capsules resting and rolling on a heightfield and
+ * on a triangle mesh of the same terrain, with the specialized sphere and
+ * capsule versus concave algorithm and with bullet's generic one.
+ *
+ * @author dokthar
+ */
+public class TestNarrowphaseBenchmark extends SimpleApplication {
+
+    private static final int SIZE = 129;
+    private static final int BODIES = 400;
+    private static final int STEPS = 600;
+
+    public static void main(String[] args) {
+        TestNarrowphaseBenchmark app = new TestNarrowphaseBenchmark();
+        app.start(JmeContext.Type.Headless);
+    }
+
+    @Override
+    public void simpleInitApp() {
+        float[] heights = new float[SIZE * SIZE];
+        for (int y = 0; y < SIZE; y++) {
+            for (int x = 0; x < SIZE; x++) {
+                heights[y * SIZE + x] = FastMath.sin(x * 0.2f) * FastMath.cos(y * 0.15f) * 3f;
+            }
+        }
+        for (boolean specialized : new boolean[]{true, false}) {
+            run("heightfield / spheres", new HeightfieldCollisionShape(heights), new SphereCollisionShape(0.5f), specialized);
+            run("heightfield / capsules", new HeightfieldCollisionShape(heights), new CapsuleCollisionShape(0.4f, 1f), specialized);
+            run("mesh / spheres", new MeshCollisionShape(createMesh(heights)), new SphereCollisionShape(0.5f), specialized);
+            run("mesh / capsules", new MeshCollisionShape(createMesh(heights)), new CapsuleCollisionShape(0.4f, 1f), specialized);
+        }
+        stop();
+    }
+
+    private void run(String name, CollisionShape terrainShape, CollisionShape bodyShape, boolean specialized) {
+        PhysicsSpace space = new PhysicsSpace();
+        space.setSphereCapsuleConcaveAlgorithm(specialized);
+        space.add(new PhysicsRigidBody(terrainShape, 0));
+        int side = (int) FastMath.sqrt(BODIES);
+        for (int i = 0; i < BODIES; i++) {
+            PhysicsRigidBody body = new PhysicsRigidBody(bodyShape, 1);
+            float x = (i % side - side / 2) * 4f;
+            float z = (i / side - side / 2) * 4f;
+            body.setPhysicsLocation(new Vector3f(x, 6, z));
+            space.add(body);
+        }
+        // let the bodies fall before the timing
+        for (int i = 0; i < 60; i++) {
+            space.update(1f / 60f, 0);
+        }
+        long start = System.nanoTime();
+        for (int i = 0; i < STEPS; i++) {
+            space.update(1f / 60f, 0);
+        }
+        long time = System.nanoTime() - start;
+        System.out.println(name + (specialized ? " (specialized)" : " (generic)") + " : " + (time / 1000000f / STEPS) + " ms/step");
+        space.destroy();
+    }
+
+    private static Mesh createMesh(float[] heights) {
+        FloatBuffer positions = BufferUtils.createFloatBuffer(SIZE * SIZE * 3);
+        for (int y = 0; y < SIZE; y++) {
+            for (int x = 0; x < SIZE; x++) {
+                positions.put(x - (SIZE - 1) / 2f).put(heights[y * SIZE + x]).put(y - (SIZE - 1) / 2f);
+            }
+        }
+        IntBuffer indexes = BufferUtils.createIntBuffer((SIZE - 1) * (SIZE - 1) * 6);
+        for (int y = 0; y < SIZE - 1; y++) {
+            for (int x = 0; x < SIZE - 1; x++) {
+                int i = y * SIZE + x;
+                indexes.put(i).put(i + SIZE).put(i + 1);
+                indexes.put(i + 1).put(i + SIZE).put(i + SIZE + 1);
+            }
+        }
+        Mesh mesh = new Mesh();
+        mesh.setBuffer(VertexBuffer.Type.Position, 3, positions);
+        mesh.setBuffer(VertexBuffer.Type.Index, 3, indexes);
+        mesh.updateBound();
+        return mesh;
+    }
+}